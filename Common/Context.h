@@ -41,7 +41,7 @@ struct contextMeshOptions {
   double hoMaxRho, hoMaxAngle, hoMaxInnerAngle;
   int NewtonConvergenceTestXYZ, maxIterDelaunay3D;
   int ignorePeriodicityMsh2, ignoreParametrizationMsh4, boundaryLayerFanPoints;
-  int maxNumThreads1D, maxNumThreads2D, maxNumThreads3D;
+  int maxNumThreads1D, maxNumThreads2D, maxNumThreads3D, parallelVolumes;
   double angleToleranceFacetOverlap;
   int renumber, compoundClassify, reparamMaxTriangles;
   double compoundLcFactor;
@@ -301,7 +301,7 @@ public:
     int smooth, animCycle, animStep;
     int combineTime, combineRemoveOrig, combineCopyOptions;
     int fileFormat, plugins, forceNodeData, forceElementData;
-    int saveMesh, saveInterpolationMatrices;
+    int saveMesh, saveInterpolationMatrices, maxStepsInMemory;
     double animDelay;
     std::string doubleClickedGraphPointCommand;
     double doubleClickedGraphPointX, doubleClickedGraphPointY;
@@ -1264,6 +1264,9 @@ StringXNumber MeshOptions_Number[] = {
     "Import groups of nodes (0: no; 1: create geometrical point for each node)?" },
   { F|O, "MedSingleModel" , opt_mesh_med_single_model , 0. ,
     "Import MED meshes in the current model, even if several MED mesh names exist" },
+  { F|O, "ParallelVolumes" , opt_mesh_parallel_volumes , 0. ,
+    "Mesh disconnected groups of volumes concurrently with the Delaunay and "
+    "HXT 3D algorithms (each group then uses a single thread)" },
   { F|O, "PartitionHexWeight" , opt_mesh_partition_hex_weight , -1 ,
     "Weight of hexahedral element for METIS load balancing (-1: automatic)" },
   { F|O, "PartitionLineWeight" , opt_mesh_partition_line_weight , -1 ,
@@ -1572,6 +1575,11 @@ StringXNumber PostProcessingOptions_Number[] = {
     "Post-processing view links (0: apply next option changes to selected views, "
     "1: force same options for all selected views)" },
 
+  { F|O, "MaxStepsInMemory" , opt_post_max_steps_in_memory , 0. ,
+    "Maximum number of time steps of each model-based view kept in memory when "
+    "reading MSH files (0: no limit); other steps are reloaded from the file "
+    "on demand" },
+
   { F,   "NbViews" , opt_post_nb_views , 0. ,
     "Current number of views merged (read-only)" },
 
@@ -72,6 +72,12 @@ std::string Msg::_firstWarning;
 std::string Msg::_firstError;
 std::string Msg::_lastError;
 GmshMessage *Msg::_callback = 0;
+
+// number of errors raised by each thread
+static int threadErrorCount = 0;
+#if defined(_OPENMP)
+#pragma omp threadprivate(threadErrorCount)
+#endif
 std::vector<std::string> Msg::_commandLineArgs;
 std::string Msg::_launchDate;
 std::map<std::string, std::vector<double> > Msg::_commandLineNumbers;
@@ -325,6 +331,11 @@ int Msg::GetErrorCount()
   return _errorCount;
 }
 
+int Msg::GetThreadErrorCount()
+{
+  return threadErrorCount;
+}
+
 std::string Msg::GetFirstWarning()
 {
   return _firstWarning;
@@ -522,6 +533,7 @@ std::string Msg::PrintResources(bool printDate, bool printWallTime,
 void Msg::Error(const char *fmt, ...)
 {
   _errorCount++;
+  threadErrorCount++;
   _atLeastOneErrorInRun = 1;
 
   char str[5000];
@@ -1682,8 +1694,14 @@ MsgProgressStatus::~MsgProgressStatus()
 void MsgProgressStatus::next()
 {
   if(Msg::GetCommRank() || Msg::GetNumThreads() > 1) return;
+  update(_currentI + 1);
+}
+
+void MsgProgressStatus::update(int current)
+{
+  if(Msg::GetCommRank()) return;
 
-  ++_currentI;
+  _currentI = current;
   if (_currentI < _nextIToCheck) return;
 
   int currentPercentage = _currentI * 100 / _totalElementToTreat;
@@ -117,6 +117,9 @@ public:
   static void PrintErrorCounter(const char *title);
   static int GetWarningCount();
   static int GetErrorCount();
+  // number of errors raised by the calling thread since it was started (never
+  // reset)
+  static int GetThreadErrorCount();
   static std::string GetFirstWarning();
   static std::string GetFirstError();
   static std::string GetLastError();
@@ -187,6 +190,9 @@ public:
   ~MsgProgressStatus();
   void setInitialTime(double time) { _initialTime = time; }
   void next();
+  // set the number of elements treated so far; in parallel loops, should only
+  // be called by the master thread
+  void update(int current);
 };
 
 #endif
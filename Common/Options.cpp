@@ -6545,6 +6545,12 @@ double opt_mesh_max_num_threads_3d(OPT_ARGS_NUM)
   return CTX::instance()->mesh.maxNumThreads3D;
 }
 
+double opt_mesh_parallel_volumes(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->mesh.parallelVolumes = (int)val;
+  return CTX::instance()->mesh.parallelVolumes;
+}
+
 double opt_mesh_angle_tolerance_facet_overlap(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) {
@@ -6782,6 +6788,12 @@ double opt_post_force_element_data(OPT_ARGS_NUM)
   return CTX::instance()->post.forceElementData;
 }
 
+double opt_post_max_steps_in_memory(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->post.maxStepsInMemory = (int)val;
+  return CTX::instance()->post.maxStepsInMemory;
+}
+
 double opt_post_save_mesh(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET) CTX::instance()->post.saveMesh = (int)val;
@@ -0,0 +1,174 @@
+// Gmsh - Copyright (C) 1997-2020 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
+
+#ifndef TAG_INDEX_H
+#define TAG_INDEX_H
+
+#include <cstddef>
+#include <atomic>
+#include <set>
+#include <vector>
+
+// Flat hash index from (non-zero, 64 bit) tags to pointers, using open
+// addressing with linear probing. It is used to look up mesh nodes and
+// elements by tag when their numbering is sparse.
+//
+// Lookups are thread-safe. Insertions are thread-safe as well (and can thus be
+// done in parallel), provided that enough room has been reserved beforehand
+// with reserve(): the table is only grown automatically in serial use. With
+// concurrent insertions the value kept for a duplicated tag depends on the
+// scheduling of the threads: use the bulk insert() to keep the first one.
+template <class T> class TagIndex {
+private:
+  std::size_t _capacity; // 0 or a power of 2
+  int _shift;
+  std::atomic<std::size_t> *_keys; // 0 for empty slots
+  T **_values;
+  std::atomic<std::size_t> _size;
+  std::size_t _slot(std::size_t tag) const
+  {
+    // Fibonacci hashing
+    return (std::size_t)(((unsigned long long)tag * 11400714819323198485ULL) >>
+                         _shift);
+  }
+  void _allocate(std::size_t capacity)
+  {
+    _capacity = 1;
+    _shift = 64;
+    while(_capacity < capacity) {
+      _capacity *= 2;
+      _shift--;
+    }
+    _keys = new std::atomic<std::size_t>[_capacity];
+    _values = new T *[_capacity];
+    for(std::size_t i = 0; i < _capacity; i++) {
+      _keys[i].store(0, std::memory_order_relaxed);
+      _values[i] = 0;
+    }
+  }
+  // replace the value of a tag already present
+  void _assign(std::size_t tag, T *value)
+  {
+    const std::size_t mask = _capacity - 1;
+    for(std::size_t i = _slot(tag);; i = (i + 1) & mask) {
+      std::size_t key = _keys[i].load(std::memory_order_relaxed);
+      if(key == tag) {
+        _values[i] = value;
+        return;
+      }
+      if(!key) return;
+    }
+  }
+  TagIndex(const TagIndex &);
+  TagIndex &operator=(const TagIndex &);
+
+public:
+  TagIndex() : _capacity(0), _shift(64), _keys(0), _values(0), _size(0) {}
+  ~TagIndex() { clear(); }
+  bool empty() const { return _size == 0; }
+  std::size_t size() const { return _size; }
+  void clear()
+  {
+    delete[] _keys;
+    delete[] _values;
+    _keys = 0;
+    _values = 0;
+    _capacity = 0;
+    _shift = 64;
+    _size = 0;
+  }
+  // make room for n entries, keeping the load factor below 1/2
+  void reserve(std::size_t n)
+  {
+    if(2 * n <= _capacity) return;
+    std::size_t oldCapacity = _capacity;
+    std::atomic<std::size_t> *oldKeys = _keys;
+    T **oldValues = _values;
+    _allocate(2 * n);
+    _size = 0;
+    for(std::size_t i = 0; i < oldCapacity; i++) {
+      std::size_t tag = oldKeys[i].load(std::memory_order_relaxed);
+      if(tag) insert(tag, oldValues[i]);
+    }
+    delete[] oldKeys;
+    delete[] oldValues;
+  }
+  // insert the value for the given tag; return false (and leave the index
+  // unchanged) if the tag is 0 or is already present
+  bool insert(std::size_t tag, T *value)
+  {
+    if(!tag) return false;
+    if(2 * (_size + 1) > _capacity) reserve(2 * (_size + 1));
+    const std::size_t mask = _capacity - 1;
+    for(std::size_t i = _slot(tag);; i = (i + 1) & mask) {
+      std::size_t key = _keys[i].load(std::memory_order_relaxed);
+      if(key == tag) return false;
+      if(!key) {
+        if(_keys[i].compare_exchange_strong(key, tag)) {
+          _values[i] = value;
+          _size++;
+          return true;
+        }
+        if(key == tag) return false;
+      }
+    }
+  }
+  // insert the values of n items, in parallel: tag(i) and value(i) are the tag
+  // and the value of item i. As when inserting the items serially in
+  // increasing order of i, the value of a duplicated tag is the first one (or
+  // the one already present): the indices of the items that are not inserted
+  // are returned in skipped, in increasing order
+  template <class Tag, class Value>
+  void insert(std::size_t n, const Tag &tag, const Value &value,
+              std::vector<std::size_t> &skipped)
+  {
+    skipped.clear();
+    if(_size) {
+      for(std::size_t i = 0; i < n; i++)
+        if(!insert(tag(i), value(i))) skipped.push_back(i);
+      return;
+    }
+    reserve(n);
+    std::vector<char> failed(n, 0);
+    std::atomic<bool> anyFailed(false);
+    const long int num = n;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(num > 10000)
+#endif
+    for(long int i = 0; i < num; i++) {
+      if(!insert(tag(i), value(i))) {
+        failed[i] = 1;
+        anyFailed = true;
+      }
+    }
+    if(!anyFailed) return;
+    // the value of a duplicated tag is that of the thread which inserted it
+    // first: replace it with the value of the first item with the tag
+    std::set<std::size_t> duplicated, seen;
+    for(std::size_t i = 0; i < n; i++)
+      if(failed[i]) duplicated.insert(tag(i));
+    for(std::size_t i = 0; i < n; i++) {
+      std::size_t t = tag(i);
+      if(!duplicated.count(t)) continue;
+      if(t && seen.insert(t).second)
+        _assign(t, value(i));
+      else
+        skipped.push_back(i);
+    }
+  }
+  // return the value associated with the tag, or 0 if the tag is not present
+  T *find(std::size_t tag) const
+  {
+    if(!tag || !_capacity) return 0;
+    const std::size_t mask = _capacity - 1;
+    for(std::size_t i = _slot(tag);; i = (i + 1) & mask) {
+      std::size_t key = _keys[i].load(std::memory_order_relaxed);
+      if(key == tag) return _values[i];
+      if(!key) return 0;
+    }
+  }
+};
+
+#endif
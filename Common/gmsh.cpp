@@ -1349,47 +1349,174 @@ static void _getAdditionalNodesOnBoundary(GEntity *entity,
   }
 }
 
-GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
-                                          std::vector<double> &coord,
-                                          std::vector<double> &parametricCoord,
-                                          const int dim, const int tag,
-                                          const bool includeBoundary,
-                                          const bool returnParametricCoord)
+// nodes returned by getNodes() for an entity, with their position in the
+// output arrays
+struct _nodesOfEntity {
+  GEntity *entity;
+  std::size_t offset, parametricOffset, numParametric;
+  // additional nodes on the boundary, if requested
+  std::vector<std::size_t> boundaryTags;
+  std::vector<double> boundaryCoord, boundaryParametricCoord;
+};
+
+// compute the exact size of the output of getNodes(), so that the arrays can
+// be allocated once and filled in parallel by _getNodes()
+static bool _getNodesSize(const int dim, const int tag,
+                          const bool includeBoundary, const bool parametric,
+                          std::vector<_nodesOfEntity> &nodes,
+                          std::size_t &numNodes, std::size_t &numParametric)
 {
-  if(!_checkInit()) return;
-  nodeTags.clear();
-  coord.clear();
-  parametricCoord.clear();
+  numNodes = numParametric = 0;
   std::vector<GEntity *> entities;
   if(dim >= 0 && tag >= 0) {
     GEntity *ge = GModel::current()->getEntityByTag(dim, tag);
     if(!ge) {
       Msg::Error("%s does not exist", _getEntityName(dim, tag).c_str());
-      return;
+      return false;
     }
     entities.push_back(ge);
   }
   else {
     GModel::current()->getEntities(entities, dim);
   }
+  nodes.resize(entities.size());
   for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
-      MVertex *v = ge->mesh_vertices[j];
-      nodeTags.push_back(v->getNum());
-      coord.push_back(v->x());
-      coord.push_back(v->y());
-      coord.push_back(v->z());
-      if(dim > 0 && returnParametricCoord) {
+    _nodesOfEntity &n = nodes[i];
+    n.entity = entities[i];
+    n.offset = numNodes;
+    n.parametricOffset = numParametric;
+    n.numParametric = 0;
+    const std::vector<MVertex *> &v = entities[i]->mesh_vertices;
+    if(parametric) {
+      std::size_t num = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : num)
+#endif
+      for(long int j = 0; j < (long int)v.size(); j++) {
         double par;
-        for(int k = 0; k < dim; k++) {
-          if(v->getParameter(k, par)) parametricCoord.push_back(par);
-        }
+        for(int k = 0; k < dim; k++)
+          if(v[j]->getParameter(k, par)) num++;
       }
+      n.numParametric = num;
     }
     if(includeBoundary)
-      _getAdditionalNodesOnBoundary(ge, nodeTags, coord, parametricCoord,
-                                    dim > 0 && returnParametricCoord);
+      _getAdditionalNodesOnBoundary(entities[i], n.boundaryTags,
+                                    n.boundaryCoord,
+                                    n.boundaryParametricCoord, parametric);
+    numNodes += v.size() + n.boundaryTags.size();
+    numParametric += n.numParametric + n.boundaryParametricCoord.size();
+  }
+  return true;
+}
+
+static void _getNodes(const std::vector<_nodesOfEntity> &nodes, const int dim,
+                      const bool parametric, std::size_t *nodeTags,
+                      double *coord, double *parametricCoord)
+{
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    for(std::size_t i = 0; i < nodes.size(); i++) {
+      const _nodesOfEntity &n = nodes[i];
+      const std::vector<MVertex *> &v = n.entity->mesh_vertices;
+      // parametric coordinates are filled here if all the nodes have them
+      bool allParametric = parametric && n.numParametric == dim * v.size();
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+      for(long int j = 0; j < (long int)v.size(); j++) {
+        std::size_t o = n.offset + j;
+        nodeTags[o] = v[j]->getNum();
+        coord[3 * o] = v[j]->x();
+        coord[3 * o + 1] = v[j]->y();
+        coord[3 * o + 2] = v[j]->z();
+        if(allParametric) {
+          for(int k = 0; k < dim; k++)
+            v[j]->getParameter(k, parametricCoord[n.parametricOffset +
+                                                  dim * j + k]);
+        }
+      }
+    }
+  }
+  for(std::size_t i = 0; i < nodes.size(); i++) {
+    const _nodesOfEntity &n = nodes[i];
+    const std::vector<MVertex *> &v = n.entity->mesh_vertices;
+    std::size_t o = n.parametricOffset;
+    if(parametric && n.numParametric != dim * v.size()) {
+      for(std::size_t j = 0; j < v.size(); j++) {
+        double par;
+        for(int k = 0; k < dim; k++)
+          if(v[j]->getParameter(k, par)) parametricCoord[o++] = par;
+      }
+    }
+    std::copy(n.boundaryTags.begin(), n.boundaryTags.end(),
+              nodeTags + n.offset + v.size());
+    std::copy(n.boundaryCoord.begin(), n.boundaryCoord.end(),
+              coord + 3 * (n.offset + v.size()));
+    std::copy(n.boundaryParametricCoord.begin(),
+              n.boundaryParametricCoord.end(),
+              parametricCoord + n.parametricOffset + n.numParametric);
+  }
+}
+
+GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
+                                          std::vector<double> &coord,
+                                          std::vector<double> &parametricCoord,
+                                          const int dim, const int tag,
+                                          const bool includeBoundary,
+                                          const bool returnParametricCoord)
+{
+  if(!_checkInit()) return;
+  nodeTags.clear();
+  coord.clear();
+  parametricCoord.clear();
+  bool parametric = dim > 0 && returnParametricCoord;
+  std::vector<_nodesOfEntity> nodes;
+  std::size_t numNodes, numParametric;
+  if(!_getNodesSize(dim, tag, includeBoundary, parametric, nodes, numNodes,
+                    numParametric))
+    return;
+  nodeTags.resize(numNodes);
+  coord.resize(3 * numNodes);
+  parametricCoord.resize(numParametric);
+  _getNodes(nodes, dim, parametric, nodeTags.data(), coord.data(),
+            parametricCoord.data());
+}
+
+// for better performance, manual C implementation of
+// gmsh::model::mesh::getNodes, which fills the arrays returned to the caller
+// directly
+GMSH_API void gmshModelMeshGetNodes(size_t **nodeTags, size_t *nodeTags_n,
+                                    double **coord, size_t *coord_n,
+                                    double **parametricCoord,
+                                    size_t *parametricCoord_n, const int dim,
+                                    const int tag, const int includeBoundary,
+                                    const int returnParametricCoord,
+                                    int *ierr)
+{
+  if(ierr) *ierr = 0;
+  try {
+    *nodeTags = 0;
+    *coord = 0;
+    *parametricCoord = 0;
+    *nodeTags_n = *coord_n = *parametricCoord_n = 0;
+    if(!_checkInit()) return;
+    bool parametric = dim > 0 && returnParametricCoord;
+    std::vector<_nodesOfEntity> nodes;
+    std::size_t numNodes, numParametric;
+    if(!_getNodesSize(dim, tag, includeBoundary, parametric, nodes, numNodes,
+                      numParametric))
+      return;
+    *nodeTags = (size_t *)Malloc(numNodes * sizeof(size_t));
+    *coord = (double *)Malloc(3 * numNodes * sizeof(double));
+    *parametricCoord = (double *)Malloc(numParametric * sizeof(double));
+    *nodeTags_n = numNodes;
+    *coord_n = 3 * numNodes;
+    *parametricCoord_n = numParametric;
+    _getNodes(nodes, dim, parametric, *nodeTags, *coord, *parametricCoord);
+  } catch(...) {
+    if(ierr) *ierr = 1;
   }
 }
 
@@ -1651,38 +1778,164 @@ _getEntitiesForElementTypes(int dim, int tag,
   }
 }
 
-GMSH_API void gmsh::model::mesh::getElements(
-  std::vector<int> &elementTypes,
-  std::vector<std::vector<std::size_t> > &elementTags,
-  std::vector<std::vector<std::size_t> > &nodeTags, const int dim,
-  const int tag)
+// elements of a given type returned by getElements() for an entity, with their
+// position in the output arrays
+struct _elementsOfEntity {
+  GEntity *entity;
+  int familyType;
+  std::size_t offset, num;
+  // true if all the elements of the family have the requested type
+  bool homogeneous;
+};
+
+// compute the exact size of the output of getElements(), so that the arrays
+// can be allocated once and filled in parallel by _getElements()
+static void
+_getElementsSize(const int dim, const int tag, std::vector<int> &elementTypes,
+                 std::vector<std::vector<_elementsOfEntity> > &elements,
+                 std::vector<std::size_t> &numElements)
 {
-  if(!_checkInit()) return;
-  elementTypes.clear();
-  elementTags.clear();
-  nodeTags.clear();
   std::map<int, std::vector<GEntity *> > typeEnt;
   _getEntitiesForElementTypes(dim, tag, typeEnt);
   for(std::map<int, std::vector<GEntity *> >::const_iterator it =
         typeEnt.begin();
       it != typeEnt.end(); it++) {
-    elementTypes.push_back(it->first);
-    elementTags.push_back(std::vector<std::size_t>());
-    nodeTags.push_back(std::vector<std::size_t>());
     int elementType = it->first;
+    int familyType = ElementType::getParentType(elementType);
+    elementTypes.push_back(elementType);
+    elements.push_back(std::vector<_elementsOfEntity>(it->second.size()));
+    std::size_t num = 0;
     for(std::size_t i = 0; i < it->second.size(); i++) {
       GEntity *ge = it->second[i];
-      for(std::size_t j = 0; j < ge->getNumMeshElements(); j++) {
-        MElement *e = ge->getMeshElement(j);
-        if(e->getTypeForMSH() == elementType) {
-          elementTags.back().push_back(e->getNum());
-          for(std::size_t k = 0; k < e->getNumVertices(); k++) {
-            nodeTags.back().push_back(e->getVertex(k)->getNum());
-          }
-        }
+      std::size_t n = ge->getNumMeshElementsByType(familyType), m = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : m)
+#endif
+      for(long int j = 0; j < (long int)n; j++) {
+        if(ge->getMeshElementByType(familyType, j)->getTypeForMSH() ==
+           elementType)
+          m++;
+      }
+      _elementsOfEntity &e = elements.back()[i];
+      e.entity = ge;
+      e.familyType = familyType;
+      e.offset = num;
+      e.num = m;
+      e.homogeneous = (m == n);
+      num += m;
+    }
+    numElements.push_back(num);
+  }
+}
+
+static void _getElements(const std::vector<_elementsOfEntity> &elements,
+                         const int elementType, std::size_t *elementTags,
+                         std::size_t *nodeTags)
+{
+  const int numNodes = ElementType::getNumVertices(elementType);
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    for(std::size_t i = 0; i < elements.size(); i++) {
+      const _elementsOfEntity &e = elements[i];
+      if(!e.homogeneous) continue;
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+      for(long int j = 0; j < (long int)e.num; j++) {
+        MElement *el = e.entity->getMeshElementByType(e.familyType, j);
+        std::size_t o = e.offset + j;
+        elementTags[o] = el->getNum();
+        for(int k = 0; k < numNodes; k++)
+          nodeTags[numNodes * o + k] = el->getVertex(k)->getNum();
       }
     }
   }
+  // entities with elements of different types in the same family
+  for(std::size_t i = 0; i < elements.size(); i++) {
+    const _elementsOfEntity &e = elements[i];
+    if(e.homogeneous) continue;
+    std::size_t o = e.offset;
+    for(std::size_t j = 0;
+        j < e.entity->getNumMeshElementsByType(e.familyType); j++) {
+      MElement *el = e.entity->getMeshElementByType(e.familyType, j);
+      if(el->getTypeForMSH() != elementType) continue;
+      elementTags[o] = el->getNum();
+      for(int k = 0; k < numNodes; k++)
+        nodeTags[numNodes * o + k] = el->getVertex(k)->getNum();
+      o++;
+    }
+  }
+}
+
+GMSH_API void gmsh::model::mesh::getElements(
+  std::vector<int> &elementTypes,
+  std::vector<std::vector<std::size_t> > &elementTags,
+  std::vector<std::vector<std::size_t> > &nodeTags, const int dim,
+  const int tag)
+{
+  if(!_checkInit()) return;
+  elementTypes.clear();
+  elementTags.clear();
+  nodeTags.clear();
+  std::vector<std::vector<_elementsOfEntity> > elements;
+  std::vector<std::size_t> numElements;
+  _getElementsSize(dim, tag, elementTypes, elements, numElements);
+  elementTags.resize(elementTypes.size());
+  nodeTags.resize(elementTypes.size());
+  for(std::size_t t = 0; t < elementTypes.size(); t++) {
+    int numNodes = ElementType::getNumVertices(elementTypes[t]);
+    elementTags[t].resize(numElements[t]);
+    nodeTags[t].resize(numNodes * numElements[t]);
+    _getElements(elements[t], elementTypes[t], elementTags[t].data(),
+                 nodeTags[t].data());
+  }
+}
+
+// for better performance, manual C implementation of
+// gmsh::model::mesh::getElements, which fills the arrays returned to the
+// caller directly
+GMSH_API void gmshModelMeshGetElements(int **elementTypes,
+                                       size_t *elementTypes_n,
+                                       size_t ***elementTags,
+                                       size_t **elementTags_n,
+                                       size_t *elementTags_nn,
+                                       size_t ***nodeTags, size_t **nodeTags_n,
+                                       size_t *nodeTags_nn, const int dim,
+                                       const int tag, int *ierr)
+{
+  if(ierr) *ierr = 0;
+  try {
+    *elementTypes = 0;
+    *elementTags = *nodeTags = 0;
+    *elementTags_n = *nodeTags_n = 0;
+    *elementTypes_n = *elementTags_nn = *nodeTags_nn = 0;
+    if(!_checkInit()) return;
+    std::vector<int> types;
+    std::vector<std::vector<_elementsOfEntity> > elements;
+    std::vector<std::size_t> numElements;
+    _getElementsSize(dim, tag, types, elements, numElements);
+    std::size_t n = types.size();
+    *elementTypes = (int *)Malloc(n * sizeof(int));
+    *elementTags = (size_t **)Malloc(n * sizeof(size_t *));
+    *elementTags_n = (size_t *)Malloc(n * sizeof(size_t));
+    *nodeTags = (size_t **)Malloc(n * sizeof(size_t *));
+    *nodeTags_n = (size_t *)Malloc(n * sizeof(size_t));
+    *elementTypes_n = *elementTags_nn = *nodeTags_nn = n;
+    for(std::size_t t = 0; t < n; t++) {
+      int numNodes = ElementType::getNumVertices(types[t]);
+      (*elementTypes)[t] = types[t];
+      (*elementTags_n)[t] = numElements[t];
+      (*elementTags)[t] = (size_t *)Malloc(numElements[t] * sizeof(size_t));
+      (*nodeTags_n)[t] = numNodes * numElements[t];
+      (*nodeTags)[t] =
+        (size_t *)Malloc(numNodes * numElements[t] * sizeof(size_t));
+      _getElements(elements[t], types[t], (*elementTags)[t], (*nodeTags)[t]);
+    }
+  } catch(...) {
+    if(ierr) *ierr = 1;
+  }
 }
 
 GMSH_API void gmsh::model::mesh::getElement(const std::size_t elementTag,
@@ -1753,6 +2006,32 @@ GMSH_API void gmsh::model::mesh::getElementsByCoordinates(
   }
 }
 
+GMSH_API void gmsh::model::mesh::getElementByCoordinatesBatch(
+  const std::vector<double> &coord, std::vector<std::size_t> &elementTags,
+  std::vector<double> &localCoord, const int dim, const bool strict)
+{
+  if(!_checkInit()) return;
+  elementTags.clear();
+  localCoord.clear();
+  if(coord.size() % 3) {
+    Msg::Error("Number of coordinates should be a multiple of 3");
+    return;
+  }
+  std::vector<MElement *> e;
+  GModel::current()->getMeshElementByCoord(coord, e, localCoord, dim, strict);
+  elementTags.resize(e.size(), 0);
+  std::size_t notFound = 0;
+  for(std::size_t i = 0; i < e.size(); i++) {
+    if(e[i])
+      elementTags[i] = e[i]->getNum();
+    else
+      notFound++;
+  }
+  if(notFound)
+    Msg::Debug("No element found for %lu point(s) out of %lu", notFound,
+               e.size());
+}
+
 GMSH_API void gmsh::model::mesh::getLocalCoordinatesInElement(
   const std::size_t elementTag, const double x, const double y, const double z,
   double &u, double &v, double &w)
@@ -2098,6 +2377,111 @@ static bool _getFunctionSpaceInfo(const std::string &fsType,
   return false;
 }
 
+// Compute the Jacobians (9 values per point, row-major, with jac[3 * i + j] =
+// dx_j / du_i), their determinants and the coordinates of the points
+// localCoord in the given elements, for the outputs that are non-null. The node
+// coordinates of blocks of elements are gathered in a matrix, so that the
+// Jacobians (resp. the coordinates) at all the points of all the elements of a
+// block are obtained with a single product with the matrix of the gradients
+// (resp. the values) of the shape functions; blocks are processed in parallel.
+// Elements whose type differs from elementType are treated one by one.
+static void _getJacobians(const std::vector<MElement *> &elements,
+                          int elementType,
+                          const std::vector<double> &localCoord,
+                          double *jacobians, double *determinants,
+                          double *coord)
+{
+  const int numPoints = localCoord.size() / 3;
+  const std::size_t numElements = elements.size();
+  MElement *ref = 0;
+  for(std::size_t i = 0; i < numElements && !ref; i++)
+    if(elements[i]->getTypeForMSH() == elementType) ref = elements[i];
+
+  // gradients (n x 3 numPoints) and values (n x numPoints) of the shape
+  // functions at the points
+  const int n = ref ? ref->getNumShapeFunctions() : 0;
+  const int dim = ref ? ref->getDim() : 0;
+  fullMatrix<double> gsf(n, 3 * numPoints), sf(n, numPoints);
+  if(ref) {
+    std::vector<double> g(3 * n), f(n);
+    for(int k = 0; k < numPoints; k++) {
+      const double *uvw = &localCoord[3 * k];
+      ref->getGradShapeFunctions(uvw[0], uvw[1], uvw[2],
+                                 reinterpret_cast<double(*)[3]>(&g[0]));
+      ref->getShapeFunctions(uvw[0], uvw[1], uvw[2], &f[0]);
+      for(int l = 0; l < n; l++) {
+        for(int c = 0; c < 3; c++) gsf(l, 3 * k + c) = g[3 * l + c];
+        sf(l, k) = f[l];
+      }
+    }
+  }
+
+  const bool needJac = jacobians || determinants;
+  const std::size_t blockSize = 64;
+  const std::size_t numBlocks = (numElements + blockSize - 1) / blockSize;
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    // node coordinates of the elements of the block: row 3 * e + j contains
+    // coordinate j of the nodes of element e
+    fullMatrix<double> x(3 * blockSize, n);
+    fullMatrix<double> jac(3 * blockSize, needJac ? 3 * numPoints : 0);
+    fullMatrix<double> pts(3 * blockSize, coord ? numPoints : 0);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for(long int b = 0; b < (long int)numBlocks; b++) {
+      const std::size_t first = b * blockSize;
+      const std::size_t last = std::min(first + blockSize, numElements);
+      for(std::size_t e = first; e < last; e++) {
+        MElement *ele = elements[e];
+        if(ele->getTypeForMSH() != elementType) continue;
+        const std::size_t r = 3 * (e - first);
+        for(int l = 0; l < n; l++) {
+          const MVertex *v = ele->getShapeFunctionNode(l);
+          x(r, l) = v->x();
+          x(r + 1, l) = v->y();
+          x(r + 2, l) = v->z();
+        }
+      }
+      if(n && needJac) jac.gemm(x, gsf, 1., 0.);
+      if(n && coord) pts.gemm(x, sf, 1., 0.);
+      for(std::size_t e = first; e < last; e++) {
+        MElement *ele = elements[e];
+        const bool fast = (ele->getTypeForMSH() == elementType);
+        const std::size_t r = 3 * (e - first);
+        for(int k = 0; k < numPoints; k++) {
+          const std::size_t idx = e * numPoints + k;
+          const double *uvw = &localCoord[3 * k];
+          double J[9], det = 0.;
+          if(fast) {
+            if(needJac) {
+              for(int i = 0; i < 3; i++)
+                for(int j = 0; j < 3; j++) J[3 * i + j] = jac(r + j, 3 * k + i);
+              det = MElement::computeDeterminantAndRegularize(dim, J);
+            }
+            if(coord)
+              for(int j = 0; j < 3; j++) coord[3 * idx + j] = pts(r + j, k);
+          }
+          else {
+            if(needJac) {
+              double J2[3][3];
+              det = ele->getJacobian(uvw[0], uvw[1], uvw[2], J2);
+              for(int i = 0; i < 3; i++)
+                for(int j = 0; j < 3; j++) J[3 * i + j] = J2[i][j];
+            }
+            if(coord) ele->pnt(uvw[0], uvw[1], uvw[2], &coord[3 * idx]);
+          }
+          if(jacobians)
+            for(int i = 0; i < 9; i++) jacobians[9 * idx + i] = J[i];
+          if(determinants) determinants[idx] = det;
+        }
+      }
+    }
+  }
+}
+
 GMSH_API void gmsh::model::mesh::getJacobians(
   const int elementType, const std::vector<double> &localCoord,
   std::vector<double> &jacobians, std::vector<double> &determinants,
@@ -2157,191 +2541,23 @@ GMSH_API void gmsh::model::mesh::getJacobians(
                  3 * end * numPoints);
       return;
     }
-    if(haveDeterminants && haveJacobians && havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->pnt(localCoord[3 * k], localCoord[3 * k + 1],
-                     localCoord[3 * k + 2], &coord[idx * 3]);
-              determinants[idx] = e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && haveJacobians && !havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              determinants[idx] = e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && !haveJacobians && havePoints) {
-      std::vector<double> jac(9, 0.);
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->pnt(localCoord[3 * k], localCoord[3 * k + 1],
-                     localCoord[3 * k + 2], &coord[idx * 3]);
-              determinants[idx] = e->getJacobian(gsf[k], &jac[0]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(haveDeterminants && !haveJacobians && !havePoints) {
-      std::vector<double> jac(9, 0.);
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              determinants[idx] = e->getJacobian(gsf[k], &jac[0]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else if(!haveDeterminants && haveJacobians && !havePoints) {
-      std::vector<std::vector<SVector3> > gsf;
-      size_t o = 0;
-      size_t idx = begin * numPoints;
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        GEntity *ge = entities[i];
-        for(std::size_t j = 0; j < ge->getNumMeshElementsByType(familyType);
-            j++) {
-          if(o >= begin && o < end) {
-            MElement *e = ge->getMeshElementByType(familyType, j);
-            if(gsf.size() == 0) {
-              gsf.resize(numPoints);
-              for(int k = 0; k < numPoints; k++) {
-                double value[1256][3];
-                e->getGradShapeFunctions(localCoord[3 * k],
-                                         localCoord[3 * k + 1],
-                                         localCoord[3 * k + 2], value);
-                gsf[k].resize(e->getNumShapeFunctions());
-                for(std::size_t l = 0; l < e->getNumShapeFunctions(); l++) {
-                  gsf[k][l][0] = value[l][0];
-                  gsf[k][l][1] = value[l][1];
-                  gsf[k][l][2] = value[l][2];
-                }
-              }
-            }
-            for(int k = 0; k < numPoints; k++) {
-              e->getJacobian(gsf[k], &jacobians[idx * 9]);
-              idx++;
-            }
-          }
-          o++;
-        }
-      }
-    }
-    else {
-      Msg::Error("The case with 'haveDeterminants = %s', `haveJacobians = %s` "
-                 "and 'havePoints = %s' is not yet implemented",
-                 (haveDeterminants ? "true" : "false"),
-                 (haveJacobians ? "true" : "false"),
-                 (havePoints ? "true" : "false"));
-      return;
-    }
-    // Add other combinaisons if necessary
+    std::vector<MElement *> elements;
+    elements.reserve(end - begin);
+    std::size_t o = 0;
+    for(std::size_t i = 0; i < entities.size() && o < end; i++) {
+      GEntity *ge = entities[i];
+      std::size_t n = ge->getNumMeshElementsByType(familyType);
+      for(std::size_t j = (o < begin) ? std::min(n, begin - o) : 0;
+          j < n && o + j < end; j++)
+        elements.push_back(ge->getMeshElementByType(familyType, j));
+      o += n;
+    }
+    if(elements.empty()) return;
+    const std::size_t idx = begin * numPoints;
+    _getJacobians(elements, elementType, localCoord,
+                  haveJacobians ? &jacobians[9 * idx] : 0,
+                  haveDeterminants ? &determinants[idx] : 0,
+                  havePoints ? &coord[3 * idx] : 0);
   }
 }
 
@@ -38,6 +38,8 @@ GFace::GFace(GModel *model, int tag)
 {
   meshStatistics.status = GFace::PENDING;
   meshStatistics.refineAllEdges = false;
+  meshStatistics.nbInsertion = meshStatistics.nbPointSearch = 0;
+  meshStatistics.nbWalkFailure = meshStatistics.nbLinearScan = 0;
   GFace::resetMeshAttributes();
 }
 
@@ -352,6 +352,10 @@ public:
     double smallest_edge_length, longest_edge_length, efficiency_index;
     int nbEdge, nbTriangle;
     int nbGoodQuality, nbGoodLength;
+    // point insertions and point location in the 2D Delaunay algorithms: number
+    // of inserted points, of searches for the triangle containing a point, of
+    // searches for which the walk failed and of linear scans in the fallback
+    std::size_t nbInsertion, nbPointSearch, nbWalkFailure, nbLinearScan;
   } meshStatistics;
 
   // a crude graphical representation using a "cross" represented by points
@@ -213,10 +213,12 @@ void GModel::destroyMeshCaches()
 {
   _vertexVectorCache.clear();
   std::vector<MVertex *>().swap(_vertexVectorCache);
+  _vertexHashCache.clear();
   _vertexMapCache.clear();
   std::map<int, MVertex *>().swap(_vertexMapCache);
   _elementVectorCache.clear();
   std::vector<MElement *>().swap(_elementVectorCache);
+  _elementHashCache.clear();
   _elementMapCache.clear();
   std::map<int, MElement *>().swap(_elementMapCache);
   _elementIndexCache.clear();
@@ -1656,18 +1658,79 @@ std::vector<MElement *> GModel::getMeshElementsByCoord(SPoint3 &p, int dim,
   return _elementOctree->findAll(p.x(), p.y(), p.z(), dim, strict);
 }
 
+void GModel::getMeshElementByCoord(const std::vector<double> &xyz,
+                                   std::vector<MElement *> &elements,
+                                   std::vector<double> &uvw, int dim,
+                                   bool strict)
+{
+  std::size_t num = xyz.size() / 3;
+  elements.assign(num, 0);
+  uvw.assign(3 * num, 0.);
+  if(!num) return;
+  if(!_elementOctree) {
+    Msg::Debug("Rebuilding mesh element octree");
+    _elementOctree = new MElementOctree(this);
+  }
+
+  // initialize the shared caches (basis functions, Jacobian bases) of each
+  // type of element before searching in parallel
+  std::vector<GEntity *> entities;
+  getEntities(entities);
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    std::vector<int> types;
+    entities[i]->getElementTypes(types);
+    for(std::size_t j = 0; j < types.size(); j++) {
+      if(!entities[i]->getNumMeshElementsByType(types[j])) continue;
+      MElement *e = entities[i]->getMeshElementByType(types[j], 0);
+      SPoint3 b = e->barycenter();
+      double p[3] = {b.x(), b.y(), b.z()}, u[3];
+      e->xyz2uvw(p, u);
+      e->isInside(u[0], u[1], u[2]);
+    }
+  }
+
+  const MElementOctree *octree = _elementOctree;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(long int i = 0; i < (long int)num; i++) {
+    double p[3] = {xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]};
+    MElement *e = octree->find(p[0], p[1], p[2], dim, true);
+    if(!e) continue;
+    e->xyz2uvw(p, &uvw[3 * i]);
+    elements[i] = e;
+  }
+  if(strict) return;
+
+  // the search with a tolerance tests all the elements: only do it for the
+  // points that have not been found
+  std::vector<long int> misses;
+  for(std::size_t i = 0; i < num; i++)
+    if(!elements[i]) misses.push_back(i);
+  for(std::size_t k = 0; k < misses.size(); k++) {
+    long int i = misses[k];
+    double p[3] = {xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2]};
+    MElement *e = octree->find(p[0], p[1], p[2], dim, false);
+    if(!e) continue;
+    e->xyz2uvw(p, &uvw[3 * i]);
+    elements[i] = e;
+  }
+}
+
 void GModel::rebuildMeshVertexCache(bool onlyIfNecessary)
 {
-  if(!onlyIfNecessary ||
-     (_vertexVectorCache.empty() && _vertexMapCache.empty())) {
+  if(!onlyIfNecessary || (_vertexVectorCache.empty() &&
+                          _vertexHashCache.empty() && _vertexMapCache.empty())) {
     _vertexVectorCache.clear();
+    _vertexHashCache.clear();
     _vertexMapCache.clear();
     bool dense = false;
-    if(_maxVertexNum == getNumMeshVertices()) {
+    std::size_t numVertices = getNumMeshVertices();
+    if(_maxVertexNum == numVertices) {
       Msg::Debug("We have a dense node numbering in the cache");
       dense = true;
     }
-    else if(_maxVertexNum < 10 * getNumMeshVertices()) {
+    else if(_maxVertexNum < 10 * numVertices) {
       Msg::Debug(
         "We have a fairly dense node numbering - still using cache vector");
       dense = true;
@@ -1683,26 +1746,38 @@ void GModel::rebuildMeshVertexCache(bool onlyIfNecessary)
             entities[i]->mesh_vertices[j];
     }
     else {
+      // insert in parallel; as with the vector, the last node with a given
+      // tag is kept, i.e. the first one in reverse order
+      std::vector<MVertex *> v;
+      v.reserve(numVertices);
       for(std::size_t i = 0; i < entities.size(); i++)
-        for(std::size_t j = 0; j < entities[i]->mesh_vertices.size(); j++)
-          _vertexMapCache[entities[i]->mesh_vertices[j]->getNum()] =
-            entities[i]->mesh_vertices[j];
+        v.insert(v.end(), entities[i]->mesh_vertices.begin(),
+                 entities[i]->mesh_vertices.end());
+      const std::size_t n = v.size();
+      std::vector<std::size_t> skipped;
+      _vertexHashCache.insert(
+        n, [&v, n](std::size_t i) { return v[n - 1 - i]->getNum(); },
+        [&v, n](std::size_t i) { return v[n - 1 - i]; }, skipped);
     }
   }
 }
 
 void GModel::rebuildMeshElementCache(bool onlyIfNecessary)
 {
-  if(!onlyIfNecessary || (_elementVectorCache.empty() && _elementMapCache.empty())) {
+  if(!onlyIfNecessary ||
+     (_elementVectorCache.empty() && _elementHashCache.empty() &&
+      _elementMapCache.empty())) {
     Msg::Debug("Rebuilding mesh element cache");
     _elementVectorCache.clear();
+    _elementHashCache.clear();
     _elementMapCache.clear();
     bool dense = false;
-    if(_maxElementNum == getNumMeshElements()) {
+    std::size_t numElements = getNumMeshElements();
+    if(_maxElementNum == numElements) {
       Msg::Debug("We have a dense element numbering in the cache");
       dense = true;
     }
-    else if(_maxElementNum < 10 * getNumMeshElements()) {
+    else if(_maxElementNum < 10 * numElements) {
       Msg::Debug(
         "We have a fairly dense element numbering - still using cache vector");
       dense = true;
@@ -1719,26 +1794,37 @@ void GModel::rebuildMeshElementCache(bool onlyIfNecessary)
         }
     }
     else {
+      // insert in parallel; as with the vector, the last element with a given
+      // tag is kept, i.e. the first one in reverse order
+      std::vector<MElement *> e;
+      e.reserve(numElements);
       for(std::size_t i = 0; i < entities.size(); i++)
-        for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          MElement *e = entities[i]->getMeshElement(j);
-          _elementMapCache[e->getNum()] = e;
-        }
+        for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++)
+          e.push_back(entities[i]->getMeshElement(j));
+      const std::size_t n = e.size();
+      std::vector<std::size_t> skipped;
+      _elementHashCache.insert(
+        n, [&e, n](std::size_t i) { return e[n - 1 - i]->getNum(); },
+        [&e, n](std::size_t i) { return e[n - 1 - i]; }, skipped);
     }
   }
 }
 
-MVertex *GModel::getMeshVertexByTag(int n)
+MVertex *GModel::getMeshVertexByTag(std::size_t n)
 {
-  if(_vertexVectorCache.empty() && _vertexMapCache.empty()) {
+  if(_vertexVectorCache.empty() && _vertexHashCache.empty() &&
+     _vertexMapCache.empty()) {
     Msg::Debug("Rebuilding mesh node cache");
     rebuildMeshVertexCache();
   }
 
-  if(n < (int)_vertexVectorCache.size())
-    return _vertexVectorCache[n];
-  else
-    return _vertexMapCache[n];
+  if(n < _vertexVectorCache.size()) return _vertexVectorCache[n];
+  if(!_vertexHashCache.empty()) return _vertexHashCache.find(n);
+  if(!_vertexMapCache.empty()) {
+    std::map<int, MVertex *>::const_iterator it = _vertexMapCache.find(n);
+    if(it != _vertexMapCache.end()) return it->second;
+  }
+  return 0;
 }
 
 void GModel::getMeshVerticesForPhysicalGroup(int dim, int num,
@@ -1761,17 +1847,21 @@ void GModel::getMeshVerticesForPhysicalGroup(int dim, int num,
   v.insert(v.begin(), sv.begin(), sv.end());
 }
 
-MElement *GModel::getMeshElementByTag(int n)
+MElement *GModel::getMeshElementByTag(std::size_t n)
 {
-  if(_elementVectorCache.empty() && _elementMapCache.empty()) {
+  if(_elementVectorCache.empty() && _elementHashCache.empty() &&
+     _elementMapCache.empty()) {
     Msg::Debug("Rebuilding mesh element cache");
     rebuildMeshElementCache();
   }
 
-  if(n < (int)_elementVectorCache.size())
-    return _elementVectorCache[n];
-  else
-    return _elementMapCache[n];
+  if(n < _elementVectorCache.size()) return _elementVectorCache[n];
+  if(!_elementHashCache.empty()) return _elementHashCache.find(n);
+  if(!_elementMapCache.empty()) {
+    std::map<int, MElement *>::const_iterator it = _elementMapCache.find(n);
+    if(it != _elementMapCache.end()) return it->second;
+  }
+  return 0;
 }
 
 int GModel::getMeshElementIndex(MElement *e)
@@ -2170,11 +2260,17 @@ void GModel::createGeometryOfDiscreteEntities
   if(f.size()) {
     Msg::StatusBar(true, "Creating geometry of discrete surfaces...");
     double t1 = Cpu(), w1 = TimeOfDay();
+    // the parametrizations of the surfaces are independent (PETSc is not
+    // thread-safe, though)
+#if defined(_OPENMP) && !defined(HAVE_PETSC)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(long int i = 0; i < (long int)f.size(); i++)
+      f[i]->computeParametrization();
     Msg::StartProgressMeter(f.size());
     for(std::size_t i = 0; i < f.size(); i++) {
       Msg::ProgressMeter(i, true, "Creating geometry");
-      if(f[i]->createGeometry())
-        Msg::Error("Could not create geometry of discrete surface %d", f[i]->tag());
+      f[i]->createGeometryFromParametrization();
     }
     Msg::StopProgressMeter();
     double t2 = Cpu();
@@ -2340,9 +2436,16 @@ void GModel::checkMeshCoherence(double tolerance)
     for(std::size_t i = 0; i < entities.size(); i++)
       vertices.insert(vertices.end(), entities[i]->mesh_vertices.begin(),
                       entities[i]->mesh_vertices.end());
-    MVertexRTree pos(eps);
+    std::vector<MVertex *> duplicateOf;
+    int num = (int)MVertexRTree::findDuplicates(vertices, eps, duplicateOf);
     std::set<MVertex *, MVertexPtrLessThan> duplicates;
-    int num = pos.insert(vertices, true, &duplicates);
+    for(std::size_t i = 0; i < vertices.size(); i++) {
+      MVertex *v = vertices[i], *out = duplicateOf[i];
+      if(!out) continue;
+      duplicates.insert(out);
+      duplicates.insert(v);
+      MVertexRTree::warnDuplicate(v, out, eps);
+    }
     if(num) {
       Msg::Error("%d duplicate node%s: see `duplicate_node.pos'", num,
                  num > 1 ? "s" : "");
@@ -2377,8 +2480,13 @@ void GModel::checkMeshCoherence(double tolerance)
         vertices.push_back(new MVertex(p.x(), p.y(), p.z()));
       }
     }
-    MVertexRTree pos(eps);
-    int num = pos.insert(vertices, true);
+    std::vector<MVertex *> duplicateOf;
+    int num = (int)MVertexRTree::findDuplicates(vertices, eps, duplicateOf);
+    for(std::size_t i = 0; i < vertices.size(); i++) {
+      MVertex *v = vertices[i], *out = duplicateOf[i];
+      if(!out) continue;
+      MVertexRTree::warnDuplicate(v, out, eps);
+    }
     for(std::size_t i = 0; i < vertices.size(); i++) delete vertices[i];
     if(num) Msg::Error("%d duplicate element%s", num, num > 1 ? "s" : "");
   }
@@ -2423,31 +2531,19 @@ int GModel::removeDuplicateMeshVertices(double tolerance)
   // re-index all vertices (don't use MVertex::getNum(), as we want to be able
   // to remove duplicate vertices from "incorrect" meshes, where vertices with
   // the same number are duplicated)
-  int n = 0;
-  for(std::size_t i = 0; i < entities.size(); i++) {
-    GEntity *ge = entities[i];
-    for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
-      MVertex *v = ge->mesh_vertices[j];
-      v->setIndex(++n);
-    }
-  }
-
-  MVertexRTree pos(eps);
-  std::map<int, MVertex *> vertices;
-  std::map<MVertex *, MVertex *> duplicates;
+  std::vector<MVertex *> all;
   for(std::size_t i = 0; i < entities.size(); i++) {
     GEntity *ge = entities[i];
     for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
       MVertex *v = ge->mesh_vertices[j];
-      MVertex *v2 = pos.insert(v);
-      if(v2)
-        duplicates[v] = v2; // v should be removed
-      else
-        vertices[v->getIndex()] = v;
+      all.push_back(v);
+      v->setIndex(all.size());
     }
   }
 
-  int num = (int)duplicates.size();
+  // same result as inserting the vertices one at a time in an MVertexRTree
+  std::vector<MVertex *> duplicateOf;
+  int num = (int)MVertexRTree::findDuplicates(all, eps, duplicateOf);
   Msg::Info("Found %d duplicate nodes ", num);
 
   if(!num) {
@@ -2455,26 +2551,40 @@ int GModel::removeDuplicateMeshVertices(double tolerance)
     return 0;
   }
 
+  std::vector<MVertex *> vertices, duplicates;
+  vertices.reserve(all.size() - num);
+  duplicates.reserve(num);
+  for(std::size_t i = 0; i < all.size(); i++) {
+    if(duplicateOf[i])
+      duplicates.push_back(all[i]); // should be removed
+    else
+      vertices.push_back(all[i]);
+  }
+
   for(std::size_t i = 0; i < entities.size(); i++) {
     GEntity *ge = entities[i];
     // clear list of vertices owned by entity
     ge->mesh_vertices.clear();
     // replace vertices in element
-    for(std::size_t j = 0; j < ge->getNumMeshElements(); j++) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for(long int j = 0; j < (long int)ge->getNumMeshElements(); j++) {
       MElement *e = ge->getMeshElement(j);
       for(std::size_t k = 0; k < e->getNumVertices(); k++) {
-        std::map<MVertex *, MVertex *>::iterator it =
-          duplicates.find(e->getVertex(k));
-        if(it != duplicates.end()) e->setVertex(k, it->second);
+        MVertex *v = e->getVertex(k);
+        long int index = v->getIndex();
+        if(index > 0 && index <= (long int)all.size() && all[index - 1] == v &&
+           duplicateOf[index - 1])
+          e->setVertex(k, duplicateOf[index - 1]);
       }
     }
     // replace vertices in periodic copies
     std::map<MVertex *, MVertex *> &corrVtcs = ge->correspondingVertices;
     if(corrVtcs.size()) {
-      std::map<MVertex *, MVertex *>::iterator cIter;
-      for(cIter = duplicates.begin(); cIter != duplicates.end(); ++cIter) {
-        MVertex *oldTgt = cIter->first;
-        MVertex *newTgt = cIter->second;
+      for(std::size_t l = 0; l < duplicates.size(); l++) {
+        MVertex *oldTgt = duplicates[l];
+        MVertex *newTgt = duplicateOf[oldTgt->getIndex() - 1];
         std::map<MVertex *, MVertex *>::iterator cvIter = corrVtcs.find(oldTgt);
         if(cvIter != corrVtcs.end()) {
           MVertex *src = cvIter->second;
@@ -2482,15 +2592,13 @@ int GModel::removeDuplicateMeshVertices(double tolerance)
           corrVtcs[newTgt] = src;
         }
       }
+      std::map<MVertex *, MVertex *>::iterator cIter;
       for(cIter = corrVtcs.begin(); cIter != corrVtcs.end(); ++cIter) {
         MVertex *oldSrc = cIter->second;
-        std::map<MVertex *, MVertex *>::iterator nIter =
-          duplicates.find(oldSrc);
-        if(nIter != duplicates.end()) {
-          MVertex *tgt = cIter->first;
-          MVertex *newSrc = nIter->second;
-          corrVtcs[tgt] = newSrc;
-        }
+        long int index = oldSrc->getIndex();
+        if(index > 0 && index <= (long int)all.size() &&
+           all[index - 1] == oldSrc && duplicateOf[index - 1])
+          cIter->second = duplicateOf[index - 1];
       }
     }
   }
@@ -2500,11 +2608,7 @@ int GModel::removeDuplicateMeshVertices(double tolerance)
   _storeVerticesInEntities(vertices);
 
   // delete duplicates
-  std::vector<MVertex *> to_delete;
-  for(std::map<MVertex *, MVertex *>::iterator it = duplicates.begin();
-      it != duplicates.end(); it++)
-    to_delete.push_back(it->first);
-  for(std::size_t i = 0; i < to_delete.size(); i++) delete to_delete[i];
+  for(std::size_t i = 0; i < duplicates.size(); i++) delete duplicates[i];
 
   if(num)
     Msg::Info("Removed %d duplicate mesh node%s", num, num > 1 ? "s" : "");
@@ -20,6 +20,7 @@
 #include "SBoundingBox3d.h"
 #include "MFaceHash.h"
 #include "MEdgeHash.h"
+#include "TagIndex.h"
 
 #define hashmapMFace std::unordered_map<MFace, int, MFaceHash, MFaceEqual>
 #define hashmapMEdge std::unordered_map<MEdge, int, MEdgeHash, MEdgeEqual>
@@ -93,8 +94,10 @@ protected:
   // vertex and element caches to speed-up direct access by tag (mostly
   // used for post-processing I/O)
   std::vector<MVertex *> _vertexVectorCache;
+  TagIndex<MVertex> _vertexHashCache;
   std::map<int, MVertex *> _vertexMapCache;
   std::vector<MElement *> _elementVectorCache;
+  TagIndex<MElement> _elementHashCache;
   std::map<int, MElement *> _elementMapCache;
   std::map<int, int> _elementIndexCache;
 
@@ -522,9 +525,17 @@ public:
                                   bool strict = true);
   std::vector<MElement *> getMeshElementsByCoord(SPoint3 &p, int dim = -1,
                                                  bool strict = true);
+  // access the mesh elements containing each of the points in xyz (3
+  // coordinates per point), and the corresponding local coordinates in uvw,
+  // using the same search structure as getMeshElementByCoord; the points are
+  // processed in parallel, and elements[i] is 0 if no element was found
+  void getMeshElementByCoord(const std::vector<double> &xyz,
+                             std::vector<MElement *> &elements,
+                             std::vector<double> &uvw, int dim = -1,
+                             bool strict = true);
 
   // access a mesh element by tag, using the element cache
-  MElement *getMeshElementByTag(int n);
+  MElement *getMeshElementByTag(std::size_t n);
 
   // access temporary mesh element index
   int getMeshElementIndex(MElement *e);
@@ -534,15 +545,17 @@ public:
   std::size_t getNumMeshVertices(int dim = -1) const;
 
   // recompute _vertexVectorCache if there is a dense vertex numbering or
-  // _vertexMapCache if not.
+  // _vertexHashCache if not. (_vertexMapCache is only filled by some legacy
+  // readers.)
   void rebuildMeshVertexCache(bool onlyIfNecessary = false);
 
   // recompute _elementVectorCache if there is a dense element numbering or
-  // _elementMapCache if not.
+  // _elementHashCache if not.
   void rebuildMeshElementCache(bool onlyIfNecessary = false);
 
-  // access a mesh vertex by tag, using the vertex cache
-  MVertex *getMeshVertexByTag(int n);
+  // access a mesh vertex by tag, using the vertex cache (thread-safe once the
+  // cache has been built)
+  MVertex *getMeshVertexByTag(std::size_t n);
 
   // get all the mesh vertices associated with the physical group
   // of dimension "dim" and id number "num"
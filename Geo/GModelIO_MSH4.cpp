@@ -591,10 +591,22 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
         return 0;
       }
       if(swap) SwapBytes((char *)&coord[0], sizeof(double), n * numNodes);
-      std::size_t k = 0;
-      for(std::size_t j = 0; j < numNodes; j++) {
+      if(nodeRead + numNodes > totalNumNodes) {
+        Msg::Error("Too many nodes in section (%lu > %lu)",
+                   nodeRead + numNodes, totalNumNodes);
+        delete[] vertexCache;
+        return 0;
+      }
+      // the whole block is in memory: create the nodes in parallel
+      std::pair<std::size_t, MVertex *> *blockCache = &vertexCache[nodeRead];
+      const long int numNodesInBlock = numNodes;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for(long int j = 0; j < numNodesInBlock; j++) {
         MVertex *mv = 0;
         std::size_t tagNode = tags[j];
+        std::size_t k = n * j;
         if(n == 5) {
           mv = new MFaceVertex(coord[k], coord[k + 1], coord[k + 2], entity,
                                coord[k + 3], coord[k + 4], tagNode);
@@ -607,16 +619,20 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
           mv =
             new MVertex(coord[k], coord[k + 1], coord[k + 2], entity, tagNode);
         }
-        k += n;
-        entity->addMeshVertex(mv);
-        mv->setEntity(entity);
-        minNodeNum = std::min(minNodeNum, tagNode);
-        maxNodeNum = std::max(maxNodeNum, tagNode);
-        vertexCache[nodeRead] = std::pair<std::size_t, MVertex *>(tagNode, mv);
-        nodeRead++;
-        if(totalNumNodes > 100000)
-          Msg::ProgressMeter(nodeRead, true, "Reading nodes");
+        blockCache[j] = std::pair<std::size_t, MVertex *>(tagNode, mv);
       }
+      entity->mesh_vertices.reserve(entity->mesh_vertices.size() + numNodes);
+      for(std::size_t j = 0; j < numNodes; j++) {
+        entity->addMeshVertex(blockCache[j].second);
+        minNodeNum = std::min(minNodeNum, blockCache[j].first);
+        maxNodeNum = std::max(maxNodeNum, blockCache[j].first);
+      }
+      // the maximum node number is not updated atomically by the concurrent
+      // constructors
+      if(numNodes) model->setMaxVertexNumber(maxNodeNum);
+      nodeRead += numNodes;
+      if(totalNumNodes > 100000)
+        Msg::ProgressMeter(nodeRead, true, "Reading nodes");
     }
     else {
       if(version >= 4.1) {
@@ -812,43 +828,68 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
       if(swap)
         SwapBytes((char *)&data[0], sizeof(std::size_t), numElements * n);
 
-      std::vector<MVertex *> vertices(numVertPerElm, (MVertex *)0);
-      for(std::size_t j = 0; j < numElements * n; j += n) {
-        for(int k = 0; k < numVertPerElm; k++) {
-          vertices[k] = model->getMeshVertexByTag(data[j + k + 1]);
-          if(!vertices[k]) {
-            Msg::Error("Unknown node %lu in element %lu", data[j + k + 1],
-                       data[j]);
-            delete[] elementCache;
-            return 0;
-          }
-        }
+      if(elementRead + numElements > totalNumElements) {
+        Msg::Error("Too many elements in section (%lu > %lu)",
+                   elementRead + numElements, totalNumElements);
+        delete[] elementCache;
+        return 0;
+      }
 
-        MElementFactory elementFactory;
-        MElement *element = elementFactory.create(elmType, vertices, data[j], 0,
-                                                  false, 0, 0, 0, 0);
+      // the node cache is read-only once built: look up the nodes and create
+      // the elements of the block in parallel
+      model->rebuildMeshVertexCache(true);
+      std::pair<std::size_t, MElement *> *blockCache =
+        &elementCache[elementRead];
+      const long int numElementsInBlock = numElements;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for(long int j = 0; j < numElementsInBlock; j++) {
+        std::vector<MVertex *> vertices(numVertPerElm);
+        MElement *element = 0;
+        int k = 0;
+        for(; k < numVertPerElm; k++) {
+          vertices[k] = model->getMeshVertexByTag(data[j * n + k + 1]);
+          if(!vertices[k]) break;
+        }
+        if(k == numVertPerElm) {
+          MElementFactory elementFactory;
+          element = elementFactory.create(elmType, vertices, data[j * n], 0,
+                                          false, 0, 0, 0, 0);
+        }
+        blockCache[j] = std::pair<std::size_t, MElement *>(data[j * n], element);
+      }
+
+      bool ghost = (entity->geomType() == GEntity::GhostCurve ||
+                    entity->geomType() == GEntity::GhostSurface ||
+                    entity->geomType() == GEntity::GhostVolume);
+      for(std::size_t j = 0; j < numElements; j++) {
+        MElement *element = blockCache[j].second;
         if(!element) {
-          Msg::Error("Could not create element %lu of type %d", data[j],
-                     elmType);
+          for(int k = 0; k < numVertPerElm; k++) {
+            std::size_t tag = data[j * n + k + 1];
+            if(!model->getMeshVertexByTag(tag))
+              Msg::Error("Unknown node %lu in element %lu", tag,
+                         blockCache[j].first);
+          }
+          Msg::Error("Could not create element %lu of type %d",
+                     blockCache[j].first, elmType);
+          for(std::size_t k = j; k < numElements; k++)
+            if(blockCache[k].second) delete blockCache[k].second;
           delete[] elementCache;
           return 0;
         }
-        if(entity->geomType() != GEntity::GhostCurve &&
-           entity->geomType() != GEntity::GhostSurface &&
-           entity->geomType() != GEntity::GhostVolume) {
-          entity->addElement(element->getType(), element);
-        }
-
-        minElementNum = std::min(minElementNum, data[j]);
-        maxElementNum = std::max(maxElementNum, data[j]);
-
-        elementCache[elementRead] =
-          std::pair<std::size_t, MElement *>(data[j], element);
-        elementRead++;
-
-        if(totalNumElements > 100000)
-          Msg::ProgressMeter(elementRead, true, "Reading elements");
+        if(!ghost) entity->addElement(element->getType(), element);
+        minElementNum = std::min(minElementNum, blockCache[j].first);
+        maxElementNum = std::max(maxElementNum, blockCache[j].first);
       }
+      // the maximum element number is not updated atomically by the
+      // concurrent constructors
+      if(numElements) model->setMaxElementNumber(maxElementNum);
+      elementRead += numElements;
+
+      if(totalNumElements > 100000)
+        Msg::ProgressMeter(elementRead, true, "Reading elements");
     }
     else {
       for(std::size_t j = 0; j < numElements; j++) {
@@ -1355,6 +1396,7 @@ int GModel::_readMSH4(const std::string &name)
     }
     else if(!strncmp(&str[1], "Nodes", 5)) {
       _vertexVectorCache.clear();
+      _vertexHashCache.clear();
       _vertexMapCache.clear();
       bool dense = false;
       std::size_t totalNumNodes = 0, maxNodeNum;
@@ -1378,14 +1420,16 @@ int GModel::_readMSH4(const std::string &name)
         }
       }
       else {
-        for(std::size_t i = 0; i < totalNumNodes; i++) {
-          if(_vertexMapCache.count(vertexCache[i].first) == 0) {
-            _vertexMapCache[vertexCache[i].first] = vertexCache[i].second;
-          }
-          else {
-            Msg::Info("Skipping duplicate node %d", vertexCache[i].first);
-          }
-        }
+        // the first node with a given tag in the file is kept
+        std::vector<std::size_t> skipped;
+        _vertexHashCache.insert(
+          totalNumNodes,
+          [vertexCache](std::size_t i) { return vertexCache[i].first; },
+          [vertexCache](std::size_t i) { return vertexCache[i].second; },
+          skipped);
+        for(std::size_t i = 0; i < skipped.size(); i++)
+          Msg::Info("Skipping duplicate node %lu",
+                    vertexCache[skipped[i]].first);
       }
       delete[] vertexCache;
     }
@@ -1413,14 +1457,16 @@ int GModel::_readMSH4(const std::string &name)
         }
       }
       else {
-        for(std::size_t i = 0; i < totalNumElements; i++) {
-          if(_elementMapCache.count(elementCache[i].first) == 0) {
-            _elementMapCache[elementCache[i].first] = elementCache[i].second;
-          }
-          else {
-            Msg::Info("Skipping duplicate element %d", elementCache[i].first);
-          }
-        }
+        // the first element with a given tag in the file is kept
+        std::vector<std::size_t> skipped;
+        _elementHashCache.insert(
+          totalNumElements,
+          [elementCache](std::size_t i) { return elementCache[i].first; },
+          [elementCache](std::size_t i) { return elementCache[i].second; },
+          skipped);
+        for(std::size_t i = 0; i < skipped.size(); i++)
+          Msg::Info("Skipping duplicate element %lu",
+                    elementCache[skipped[i]].first);
       }
       delete[] elementCache;
     }
@@ -2336,6 +2382,73 @@ static void writeMSH4Nodes(GModel *const model, FILE *fp, bool partitioned,
   fprintf(fp, "$EndNodes\n");
 }
 
+// a block of elements of the same type, stored contiguously in the mesh of an
+// entity; consecutive blocks of the same entity and type are written in a
+// single section
+struct MSH4ElementBlock {
+  GEntity *ge;
+  int family, elmType;
+  std::size_t first, num;
+  // number of elements in the section starting with this block, or 0 if the
+  // block continues the section of the previous block
+  std::size_t sectionSize;
+  MElement *element(std::size_t i) const
+  {
+    return ge->getMeshElementByType(family, first + i);
+  }
+};
+
+class MSH4ElementBlockLessThan {
+public:
+  bool operator()(const MSH4ElementBlock &b1, const MSH4ElementBlock &b2) const
+  {
+    return b1.elmType < b2.elmType;
+  }
+};
+
+// a part of a block, formatted in memory before being written
+struct MSH4ElementChunk {
+  std::size_t block, first, num;
+  std::vector<std::size_t> tags;
+  std::string text;
+};
+
+static void addMSH4ElementBlocks(GEntity *ge, int family,
+                                 std::vector<MSH4ElementBlock> &blocks)
+{
+  std::size_t num = ge->getNumMeshElementsByType(family);
+  MSH4ElementBlock b;
+  b.ge = ge;
+  b.family = family;
+  b.elmType = 0;
+  b.first = 0;
+  for(std::size_t i = 0; i < num; i++) {
+    int elmType = ge->getMeshElementByType(family, i)->getTypeForMSH();
+    if(i && elmType != b.elmType) {
+      b.num = i - b.first;
+      blocks.push_back(b);
+      b.first = i;
+    }
+    b.elmType = elmType;
+  }
+  if(num) {
+    b.num = num - b.first;
+    blocks.push_back(b);
+  }
+}
+
+static inline void appendMSH4Tag(std::string &s, std::size_t tag)
+{
+  char tmp[32];
+  int n = 0;
+  do {
+    tmp[n++] = '0' + tag % 10;
+    tag /= 10;
+  } while(tag);
+  while(n) s.push_back(tmp[--n]);
+  s.push_back(' ');
+}
+
 static void writeMSH4Elements(GModel *const model, FILE *fp, bool partitioned,
                               bool binary, bool saveAll, double version)
 {
@@ -2387,79 +2500,78 @@ static void writeMSH4Elements(GModel *const model, FILE *fp, bool partitioned,
         regions.insert(*it);
   }
 
-  std::map<std::pair<int, int>, std::vector<MElement *> > elementsByType[4];
-  std::size_t numElements = 0;
+  // elements are written by blocks of elements of the same type, stored
+  // contiguously in the mesh of an entity: no copy of the element pointers is
+  // needed
+  std::vector<MSH4ElementBlock> blocks;
 
   for(GModel::viter it = vertices.begin(); it != vertices.end(); ++it) {
     if(!saveAll && (*it)->physicals.size() == 0) continue;
-
-    numElements += (*it)->points.size();
-    for(std::size_t i = 0; i < (*it)->points.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->points[i]->getTypeForMSH());
-      elementsByType[0][p].push_back((*it)->points[i]);
-    }
+    std::size_t first = blocks.size();
+    addMSH4ElementBlocks(*it, TYPE_PNT, blocks);
+    std::stable_sort(blocks.begin() + first, blocks.end(),
+                     MSH4ElementBlockLessThan());
   }
 
   for(GModel::eiter it = edges.begin(); it != edges.end(); ++it) {
     if(!saveAll && (*it)->physicals.size() == 0 &&
        (*it)->geomType() != GEntity::GhostCurve)
       continue;
-
-    numElements += (*it)->lines.size();
-    for(std::size_t i = 0; i < (*it)->lines.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->lines[i]->getTypeForMSH());
-      elementsByType[1][p].push_back((*it)->lines[i]);
-    }
+    std::size_t first = blocks.size();
+    addMSH4ElementBlocks(*it, TYPE_LIN, blocks);
+    std::stable_sort(blocks.begin() + first, blocks.end(),
+                     MSH4ElementBlockLessThan());
   }
 
   for(GModel::fiter it = faces.begin(); it != faces.end(); ++it) {
     if(!saveAll && (*it)->physicals.size() == 0 &&
        (*it)->geomType() != GEntity::GhostSurface)
       continue;
-
-    numElements += (*it)->triangles.size();
-    for(std::size_t i = 0; i < (*it)->triangles.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->triangles[i]->getTypeForMSH());
-      elementsByType[2][p].push_back((*it)->triangles[i]);
-    }
-    numElements += (*it)->quadrangles.size();
-    for(std::size_t i = 0; i < (*it)->quadrangles.size(); i++) {
-      std::pair<int, int> p((*it)->tag(),
-                            (*it)->quadrangles[i]->getTypeForMSH());
-      elementsByType[2][p].push_back((*it)->quadrangles[i]);
-    }
+    std::size_t first = blocks.size();
+    addMSH4ElementBlocks(*it, TYPE_TRI, blocks);
+    addMSH4ElementBlocks(*it, TYPE_QUA, blocks);
+    std::stable_sort(blocks.begin() + first, blocks.end(),
+                     MSH4ElementBlockLessThan());
   }
 
   for(GModel::riter it = regions.begin(); it != regions.end(); ++it) {
     if(!saveAll && (*it)->physicals.size() == 0 &&
        (*it)->geomType() != GEntity::GhostVolume)
       continue;
-
-    numElements += (*it)->tetrahedra.size();
-    for(std::size_t i = 0; i < (*it)->tetrahedra.size(); i++) {
-      std::pair<int, int> p((*it)->tag(),
-                            (*it)->tetrahedra[i]->getTypeForMSH());
-      elementsByType[3][p].push_back((*it)->tetrahedra[i]);
+    std::size_t first = blocks.size();
+    addMSH4ElementBlocks(*it, TYPE_TET, blocks);
+    addMSH4ElementBlocks(*it, TYPE_HEX, blocks);
+    addMSH4ElementBlocks(*it, TYPE_PRI, blocks);
+    addMSH4ElementBlocks(*it, TYPE_PYR, blocks);
+    addMSH4ElementBlocks(*it, TYPE_TRIH, blocks);
+    std::stable_sort(blocks.begin() + first, blocks.end(),
+                     MSH4ElementBlockLessThan());
+  }
+
+  // all the elements of the same type in an entity form a single section, in
+  // the order in which they are stored in the entity
+  std::size_t numSection = 0, section = 0;
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    if(i && blocks[i].ge == blocks[section].ge &&
+       blocks[i].elmType == blocks[section].elmType) {
+      blocks[i].sectionSize = 0;
+      blocks[section].sectionSize += blocks[i].num;
     }
-    numElements += (*it)->hexahedra.size();
-    for(std::size_t i = 0; i < (*it)->hexahedra.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->hexahedra[i]->getTypeForMSH());
-      elementsByType[3][p].push_back((*it)->hexahedra[i]);
-    }
-    numElements += (*it)->prisms.size();
-    for(std::size_t i = 0; i < (*it)->prisms.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->prisms[i]->getTypeForMSH());
-      elementsByType[3][p].push_back((*it)->prisms[i]);
-    }
-    numElements += (*it)->pyramids.size();
-    for(std::size_t i = 0; i < (*it)->pyramids.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->pyramids[i]->getTypeForMSH());
-      elementsByType[3][p].push_back((*it)->pyramids[i]);
+    else {
+      section = i;
+      blocks[i].sectionSize = blocks[i].num;
+      numSection++;
     }
-    numElements += (*it)->trihedra.size();
-    for(std::size_t i = 0; i < (*it)->trihedra.size(); i++) {
-      std::pair<int, int> p((*it)->tag(), (*it)->trihedra[i]->getTypeForMSH());
-      elementsByType[3][p].push_back((*it)->trihedra[i]);
+  }
+
+  std::size_t numElements = 0;
+  std::size_t minTag = std::numeric_limits<std::size_t>::max(), maxTag = 0;
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    numElements += blocks[i].num;
+    for(std::size_t j = 0; j < blocks[i].num; j++) {
+      std::size_t num = blocks[i].element(j)->getNum();
+      minTag = std::min(minTag, num);
+      maxTag = std::max(maxTag, num);
     }
   }
 
@@ -2467,21 +2579,6 @@ static void writeMSH4Elements(GModel *const model, FILE *fp, bool partitioned,
 
   fprintf(fp, "$Elements\n");
 
-  std::size_t numSection = 0;
-  for(int dim = 0; dim <= 3; dim++) numSection += elementsByType[dim].size();
-
-  std::size_t minTag = std::numeric_limits<std::size_t>::max(), maxTag = 0;
-  for(int dim = 0; dim <= 3; dim++) {
-    for(std::map<std::pair<int, int>, std::vector<MElement *> >::iterator it =
-          elementsByType[dim].begin();
-        it != elementsByType[dim].end(); ++it) {
-      for(std::size_t i = 0; i < it->second.size(); i++) {
-        minTag = std::min(minTag, it->second[i]->getNum());
-        maxTag = std::max(maxTag, it->second[i]->getNum());
-      }
-    }
-  }
-
   if(binary) {
     fwrite(&numSection, sizeof(std::size_t), 1, fp);
     fwrite(&numElements, sizeof(std::size_t), 1, fp);
@@ -2495,49 +2592,80 @@ static void writeMSH4Elements(GModel *const model, FILE *fp, bool partitioned,
       fprintf(fp, "%lu %lu\n", numSection, numElements);
   }
 
-  for(int dim = 0; dim <= 3; dim++) {
-    for(std::map<std::pair<int, int>, std::vector<MElement *> >::iterator it =
-          elementsByType[dim].begin();
-        it != elementsByType[dim].end(); ++it) {
-      int entityTag = it->first.first;
-      int elmType = it->first.second;
-      std::size_t numElm = it->second.size();
+  // split the blocks into chunks of bounded size, which are formatted in
+  // memory in parallel and written to disk in order, a batch at a time
+  const std::size_t chunkSize = 100000;
+  std::vector<MSH4ElementChunk> chunks;
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    for(std::size_t j = 0; j < blocks[i].num; j += chunkSize) {
+      MSH4ElementChunk c;
+      c.block = i;
+      c.first = j;
+      c.num = std::min(chunkSize, blocks[i].num - j);
+      chunks.push_back(c);
+    }
+  }
+
+  const std::size_t batchSize = 4 * Msg::GetMaxThreads();
+  for(std::size_t start = 0; start < chunks.size(); start += batchSize) {
+    const long int end = std::min(start + batchSize, chunks.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(long int i = start; i < end; i++) {
+      MSH4ElementChunk &c = chunks[i];
+      const MSH4ElementBlock &b = blocks[c.block];
       if(binary) {
-        fwrite(&dim, sizeof(int), 1, fp);
-        fwrite(&entityTag, sizeof(int), 1, fp);
-        fwrite(&elmType, sizeof(int), 1, fp);
-        fwrite(&numElm, sizeof(std::size_t), 1, fp);
-      }
-      else {
-        fprintf(fp, "%d %d %d %lu\n", (version >= 4.1) ? dim : entityTag,
-                (version >= 4.1) ? entityTag : dim, elmType, numElm);
-      }
-
-      std::size_t N = it->second.size();
-      if(binary) {
-        const int numVertPerElm = MElement::getInfoMSH(elmType);
-        std::size_t n = 1 + numVertPerElm;
-        std::vector<std::size_t> tags(N * n);
+        const std::size_t n = 1 + MElement::getInfoMSH(b.elmType);
+        c.tags.resize(c.num * n);
         std::size_t k = 0;
-        for(std::size_t i = 0; i < N; i++) {
-          MElement *e = it->second[i];
-          tags[k] = e->getNum();
-          for(int j = 0; j < numVertPerElm; j++) {
-            tags[k + 1 + j] = e->getVertex(j)->getNum();
-          }
+        for(std::size_t j = 0; j < c.num; j++) {
+          MElement *e = b.element(c.first + j);
+          c.tags[k] = e->getNum();
+          for(std::size_t l = 1; l < n; l++)
+            c.tags[k + l] = e->getVertex(l - 1)->getNum();
           k += n;
         }
-        fwrite(&tags[0], sizeof(std::size_t), N * n, fp);
       }
       else {
-        for(std::size_t i = 0; i < N; i++) {
-          MElement *e = it->second[i];
-          fprintf(fp, "%lu ", e->getNum());
-          for(std::size_t i = 0; i < e->getNumVertices(); i++) {
-            fprintf(fp, "%lu ", e->getVertex(i)->getNum());
-          }
-          fprintf(fp, "\n");
+        c.text.reserve(c.num * 8 * (1 + MElement::getInfoMSH(b.elmType)));
+        for(std::size_t j = 0; j < c.num; j++) {
+          MElement *e = b.element(c.first + j);
+          appendMSH4Tag(c.text, e->getNum());
+          for(std::size_t l = 0; l < e->getNumVertices(); l++)
+            appendMSH4Tag(c.text, e->getVertex(l)->getNum());
+          c.text.push_back('\n');
+        }
+      }
+    }
+
+    for(long int i = start; i < end; i++) {
+      MSH4ElementChunk &c = chunks[i];
+      const MSH4ElementBlock &b = blocks[c.block];
+      if(c.first == 0 && b.sectionSize) {
+        int dim = b.ge->dim();
+        int entityTag = b.ge->tag();
+        int elmType = b.elmType;
+        std::size_t numElm = b.sectionSize;
+        if(binary) {
+          fwrite(&dim, sizeof(int), 1, fp);
+          fwrite(&entityTag, sizeof(int), 1, fp);
+          fwrite(&elmType, sizeof(int), 1, fp);
+          fwrite(&numElm, sizeof(std::size_t), 1, fp);
         }
+        else {
+          fprintf(fp, "%d %d %d %lu\n", (version >= 4.1) ? dim : entityTag,
+                  (version >= 4.1) ? entityTag : dim, elmType, numElm);
+        }
+      }
+      if(binary) {
+        if(c.tags.size())
+          fwrite(&c.tags[0], sizeof(std::size_t), c.tags.size(), fp);
+        std::vector<std::size_t>().swap(c.tags);
+      }
+      else {
+        fwrite(c.text.data(), sizeof(char), c.text.size(), fp);
+        std::string().swap(c.text);
       }
     }
   }
@@ -4,6 +4,8 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <string>
 #include <algorithm>
 #include <sstream>
@@ -19,6 +21,35 @@
 
 static bool invalidChar(char c) { return !(c >= 32 && c <= 126); }
 
+// parse "vertex x y z" (the keyword is not checked)
+static bool readSTLVertex(const char *buffer, SPoint3 &p)
+{
+  const char *s = buffer;
+  while(*s == ' ' || *s == '\t') s++;
+  while(*s && *s != ' ' && *s != '\t') s++;
+  for(int k = 0; k < 3; k++) {
+    char *end;
+    p[k] = strtod(s, &end);
+    if(end == s) return false;
+    s = end;
+  }
+  return true;
+}
+
+// sorted vertex indices of a triangle, for the detection of duplicates
+struct stlTriangle {
+  std::size_t v[3];
+  std::size_t index;
+  bool operator<(const stlTriangle &other) const
+  {
+    for(int k = 0; k < 3; k++) {
+      if(v[k] < other.v[k]) return true;
+      if(v[k] > other.v[k]) return false;
+    }
+    return index < other.index;
+  }
+};
+
 int GModel::readSTL(const std::string &name, double tolerance)
 {
   FILE *fp = Fopen(name.c_str(), "rb");
@@ -26,9 +57,12 @@ int GModel::readSTL(const std::string &name, double tolerance)
     Msg::Error("Unable to open file '%s'", name.c_str());
     return 0;
   }
+  setvbuf(fp, NULL, _IOFBF, 1 << 20);
 
-  // store triplets of points for each solid found in the file
-  std::vector<std::vector<SPoint3> > points;
+  // store triplets of points for all the solids found in the file, with the
+  // index of the first point of each solid
+  std::vector<SPoint3> points;
+  std::vector<std::size_t> solids;
   SBoundingBox3d bbox;
   std::vector<std::string> names;
 
@@ -39,8 +73,6 @@ int GModel::readSTL(const std::string &name, double tolerance)
     return 0;
   }
 
-  //SPoint3 p0(1.9e6, 4e6, 0);
-
   bool binary = strncmp(buffer, "solid", 5) && strncmp(buffer, "SOLID", 5);
 
   // ASCII STL
@@ -49,7 +81,7 @@ int GModel::readSTL(const std::string &name, double tolerance)
       names.push_back(&buffer[6]);
     else
       names.push_back("");
-    points.resize(1);
+    solids.push_back(0);
     while(!feof(fp)) {
       // "facet normal x y z" or "endsolid"
       if(!fgets(buffer, sizeof(buffer), fp)) break;
@@ -61,7 +93,7 @@ int GModel::readSTL(const std::string &name, double tolerance)
             names.push_back(&buffer[6]);
           else
             names.push_back("");
-          points.resize(points.size() + 1);
+          solids.push_back(points.size());
           // "facet normal x y z"
           if(!fgets(buffer, sizeof(buffer), fp)) break;
         }
@@ -71,12 +103,9 @@ int GModel::readSTL(const std::string &name, double tolerance)
       // "vertex x y z"
       for(int i = 0; i < 3; i++) {
         if(!fgets(buffer, sizeof(buffer), fp)) break;
-        char s1[256];
-        double x, y, z;
-        if(sscanf(buffer, "%s %lf %lf %lf", s1, &x, &y, &z) != 4) break;
-        SPoint3 p(x, y, z);
-        //p -= p0;
-        points.back().push_back(p);
+        SPoint3 p;
+        if(!readSTLVertex(buffer, p)) break;
+        points.push_back(p);
         bbox += p;
       }
       // "endloop"
@@ -87,14 +116,11 @@ int GModel::readSTL(const std::string &name, double tolerance)
   }
 
   // check if we could parse something
-  bool empty = true;
-  for(std::size_t i = 0; i < points.size(); i++) {
-    if(points[i].size()) {
-      empty = false;
-      break;
-    }
+  bool empty = points.empty();
+  if(empty) {
+    solids.clear();
+    names.clear();
   }
-  if(empty) points.clear();
 
   // binary STL (we also try to read in binary mode if the header told
   // us the format was ASCII but we could not read any vertices)
@@ -117,17 +143,19 @@ int GModel::readSTL(const std::string &name, double tolerance)
       }
       if(ret && nfacets) {
         names.push_back(header);
-        points.resize(points.size() + 1);
-        char *data = new char[nfacets * 50 * sizeof(char)];
-        ret = fread(data, sizeof(char), nfacets * 50, fp);
-        if(ret == nfacets * 50) {
+        solids.push_back(points.size());
+        std::size_t size = (std::size_t)nfacets * 50;
+        char *data = new char[size];
+        ret = fread(data, sizeof(char), size, fp);
+        if(ret == size) {
+          points.reserve(points.size() + 3 * (std::size_t)nfacets);
           for(std::size_t i = 0; i < nfacets; i++) {
-            float *xyz = (float *)&data[i * 50 * sizeof(char)];
+            float xyz[12];
+            memcpy(xyz, &data[i * 50], 12 * sizeof(float));
             if(swap) SwapBytes((char *)xyz, sizeof(float), 12);
             for(int j = 0; j < 3; j++) {
               SPoint3 p(xyz[3 + 3 * j], xyz[3 + 3 * j + 1], xyz[3 + 3 * j + 2]);
-              //p -= p0;
-              points.back().push_back(p);
+              points.push_back(p);
               bbox += p;
             }
           }
@@ -136,33 +164,33 @@ int GModel::readSTL(const std::string &name, double tolerance)
       }
     }
   }
+  fclose(fp);
 
   // cleanup names
-  if(names.size() != points.size()){
+  if(names.size() != solids.size()) {
     Msg::Debug("Invalid number of names in STL file - should never happen");
-    names.resize(points.size());
+    names.resize(solids.size());
   }
-  for(std::size_t i = 0; i < names.size(); i++){
+  for(std::size_t i = 0; i < names.size(); i++) {
     names[i].erase(remove_if(names[i].begin(), names[i].end(), invalidChar),
                    names[i].end());
   }
+  solids.push_back(points.size());
 
   std::vector<GFace *> faces;
-  for(std::size_t i = 0; i < points.size(); i++) {
-    if(points[i].empty()) {
+  for(std::size_t i = 0; i + 1 < solids.size(); i++) {
+    std::size_t n = solids[i + 1] - solids[i];
+    if(!n) {
       Msg::Error("No facets found in STL file for solid %d %s", i,
                  names[i].c_str());
-      fclose(fp);
       return 0;
     }
-    if(points[i].size() % 3) {
+    if(n % 3) {
       Msg::Error("Wrong number of points (%d) in STL file for solid %d %s",
-                 points[i].size(), i, names[i].c_str());
-      fclose(fp);
+                 (int)n, i, names[i].c_str());
       return 0;
     }
-    Msg::Info("%d facets in solid %d %s", points[i].size() / 3, i,
-              names[i].c_str());
+    Msg::Info("%d facets in solid %d %s", (int)(n / 3), i, names[i].c_str());
     // create face
     GFace *face = new discreteFace(this, getMaxElementaryNumber(2) + 1);
     faces.push_back(face);
@@ -170,51 +198,60 @@ int GModel::readSTL(const std::string &name, double tolerance)
     if(!names[i].empty()) setElementaryName(2, face->tag(), names[i]);
   }
 
-  // create triangles using unique vertices
+  // weld the points up to the tolerance, and only create vertices for the
+  // unique ones
   double eps = norm(SVector3(bbox.max(), bbox.min())) * tolerance;
-  std::vector<MVertex *> vertices;
-  for(std::size_t i = 0; i < points.size(); i++)
-    for(std::size_t j = 0; j < points[i].size(); j++)
-      vertices.push_back(
-        new MVertex(points[i][j].x(), points[i][j].y(), points[i][j].z()));
-  MVertexRTree pos(eps);
-  pos.insert(vertices);
+  std::vector<std::size_t> unique;
+  MVertexRTree::findDuplicates(points, eps, unique);
+  std::vector<MVertex *> vertices, pointVertex(points.size(), 0);
+  for(std::size_t i = 0; i < points.size(); i++) {
+    if(unique[i] != i) continue;
+    pointVertex[i] = new MVertex(points[i].x(), points[i].y(), points[i].z());
+    vertices.push_back(pointVertex[i]);
+  }
+  std::vector<SPoint3>().swap(points);
 
-  std::set<MFace, MFaceLessThan> unique;
+  // detect degenerate and duplicate triangles on the vertex indices
+  std::size_t numTriangles = unique.size() / 3;
+  std::vector<char> skip(numTriangles, 0);
+  std::vector<stlTriangle> triangles;
+  if(CTX::instance()->mesh.stlRemoveDuplicateTriangles)
+    triangles.reserve(numTriangles);
   int nbDuplic = 0, nbDegen = 0;
-  for(std::size_t i = 0; i < points.size(); i++) {
-    for(std::size_t j = 0; j < points[i].size(); j += 3) {
-      MVertex *v[3];
-      for(int k = 0; k < 3; k++) {
-        double x = points[i][j + k].x();
-        double y = points[i][j + k].y();
-        double z = points[i][j + k].z();
-        v[k] = pos.find(x, y, z);
-        if(!v[k])
-          Msg::Error("Could not find node at position (%.16g, %.16g, %.16g) "
-                     "with tol=%.16g", x, y, z, eps);
-      }
-      if(!v[0] || !v[1] || !v[2]) {
-        // error
-      }
-      else if(v[0] == v[1] || v[0] == v[2] || v[1] == v[2]) {
-        Msg::Debug("Skipping degenerated triangle %lu %lu %lu",
-                   v[0]->getNum(), v[1]->getNum(), v[2]->getNum());
-        nbDegen++;
-      }
-      else if(CTX::instance()->mesh.stlRemoveDuplicateTriangles) {
-        MFace mf(v[0], v[1], v[2]);
-        if(unique.find(mf) == unique.end()) {
-          faces[i]->triangles.push_back(new MTriangle(v[0], v[1], v[2]));
-          unique.insert(mf);
-        }
-        else {
-          nbDuplic++;
-        }
-      }
-      else{
-        faces[i]->triangles.push_back(new MTriangle(v[0], v[1], v[2]));
-      }
+  for(std::size_t t = 0; t < numTriangles; t++) {
+    stlTriangle tri;
+    for(int k = 0; k < 3; k++) tri.v[k] = unique[3 * t + k];
+    if(tri.v[0] == tri.v[1] || tri.v[0] == tri.v[2] || tri.v[1] == tri.v[2]) {
+      Msg::Debug("Skipping degenerated triangle %lu %lu %lu",
+                 pointVertex[tri.v[0]]->getNum(),
+                 pointVertex[tri.v[1]]->getNum(),
+                 pointVertex[tri.v[2]]->getNum());
+      skip[t] = 1;
+      nbDegen++;
+    }
+    else if(CTX::instance()->mesh.stlRemoveDuplicateTriangles) {
+      std::sort(tri.v, tri.v + 3);
+      tri.index = t;
+      triangles.push_back(tri);
+    }
+  }
+  // keep the first occurrence of each triangle
+  std::sort(triangles.begin(), triangles.end());
+  for(std::size_t i = 1; i < triangles.size(); i++) {
+    if(std::equal(triangles[i].v, triangles[i].v + 3, triangles[i - 1].v)) {
+      skip[triangles[i].index] = 1;
+      nbDuplic++;
+    }
+  }
+  std::vector<stlTriangle>().swap(triangles);
+
+  for(std::size_t i = 0; i + 1 < solids.size(); i++) {
+    faces[i]->triangles.reserve((solids[i + 1] - solids[i]) / 3);
+    for(std::size_t t = solids[i] / 3; t < solids[i + 1] / 3; t++) {
+      if(skip[t]) continue;
+      faces[i]->triangles.push_back(new MTriangle(
+        pointVertex[unique[3 * t]], pointVertex[unique[3 * t + 1]],
+        pointVertex[unique[3 * t + 2]]));
     }
   }
   if(nbDuplic || nbDegen)
@@ -225,7 +262,6 @@ int GModel::readSTL(const std::string &name, double tolerance)
 
   _storeVerticesInEntities(vertices); // will delete unused vertices
 
-  fclose(fp);
   return 1;
 }
 
@@ -7,6 +7,8 @@
 #include <set>
 #include <map>
 #include <stack>
+#include <limits>
+#include <algorithm>
 #include <sstream>
 #include <string.h>
 #include "GmshConfig.h"
@@ -32,10 +34,8 @@
 #include "meshGFaceOptimize.h"
 #endif
 
-#if defined(HAVE_SOLVER)
+#if defined(HAVE_SOLVER) && defined(HAVE_PETSC)
 #include "linearSystemPETSc.h"
-#include "linearSystemCSR.h"
-#include "linearSystemFull.h"
 #endif
 
 #if defined(HAVE_MESH)
@@ -506,6 +506,150 @@ int computeDiscreteCurvatures(GModel *gm)
   return 0;
 }
 
+// edge of a triangle, with the (sorted) numbers of its nodes, so that sorting
+// the edges of a triangulation groups them as with MEdgeLessThan
+struct triangleEdge {
+  std::size_t num[2];
+  std::size_t triangle;
+  int node[2]; // indices of the nodes, oriented as in the triangle
+  int opposite; // index of the third node of the triangle
+  bool operator<(const triangleEdge &other) const
+  {
+    if(num[0] != other.num[0]) return num[0] < other.num[0];
+    if(num[1] != other.num[1]) return num[1] < other.num[1];
+    return triangle < other.triangle;
+  }
+};
+
+static int nodeIndex(const std::vector<std::pair<MVertex *, int> > &index,
+                     MVertex *v)
+{
+  std::vector<std::pair<MVertex *, int> >::const_iterator it =
+    std::lower_bound(index.begin(), index.end(),
+                     std::make_pair(v, std::numeric_limits<int>::min()));
+  return (it != index.end() && it->first == v) ? it->second : -1;
+}
+
+// sparse matrix in compressed row storage, with sorted columns in each row
+class parametrizationMatrix {
+public:
+  std::vector<int> rowStart, col;
+  std::vector<double> val;
+  std::size_t size() const
+  {
+    return rowStart.empty() ? 0 : rowStart.size() - 1;
+  }
+  void mult(const std::vector<double> &x, std::vector<double> &y) const
+  {
+    for(std::size_t i = 0; i < size(); i++) {
+      double sum = 0.;
+      for(int k = rowStart[i]; k < rowStart[i + 1]; k++)
+        sum += val[k] * x[col[k]];
+      y[i] = sum;
+    }
+  }
+};
+
+// incomplete LU factorization without fill-in, for a matrix whose diagonal
+// entries are all stored
+class parametrizationILU {
+private:
+  const parametrizationMatrix &_a;
+  std::vector<double> _lu;
+  std::vector<int> _diag;
+
+public:
+  parametrizationILU(const parametrizationMatrix &a)
+    : _a(a), _lu(a.val), _diag(a.size(), -1)
+  {
+    std::vector<int> pos(a.size(), -1);
+    for(std::size_t i = 0; i < a.size(); i++) {
+      for(int k = a.rowStart[i]; k < a.rowStart[i + 1]; k++)
+        pos[a.col[k]] = k;
+      _diag[i] = pos[i];
+      for(int k = a.rowStart[i]; k < _diag[i]; k++) {
+        int j = a.col[k];
+        _lu[k] /= _lu[_diag[j]];
+        for(int l = _diag[j] + 1; l < a.rowStart[j + 1]; l++)
+          if(pos[a.col[l]] >= 0) _lu[pos[a.col[l]]] -= _lu[k] * _lu[l];
+      }
+      for(int k = a.rowStart[i]; k < a.rowStart[i + 1]; k++)
+        pos[a.col[k]] = -1;
+    }
+  }
+  // solve L U z = r
+  void solve(const std::vector<double> &r, std::vector<double> &z) const
+  {
+    const std::vector<int> &rs = _a.rowStart, &col = _a.col;
+    for(std::size_t i = 0; i < _a.size(); i++) {
+      double sum = r[i];
+      for(int k = rs[i]; k < _diag[i]; k++) sum -= _lu[k] * z[col[k]];
+      z[i] = sum;
+    }
+    for(std::size_t i = _a.size(); i-- > 0;) {
+      double sum = z[i];
+      for(int k = _diag[i] + 1; k < rs[i + 1]; k++) sum -= _lu[k] * z[col[k]];
+      z[i] = sum / _lu[_diag[i]];
+    }
+  }
+};
+
+static double dot(const std::vector<double> &a, const std::vector<double> &b)
+{
+  double sum = 0.;
+  for(std::size_t i = 0; i < a.size(); i++) sum += a[i] * b[i];
+  return sum;
+}
+
+// solve a x = b with the preconditioned BiCGSTAB method (the matrix of the
+// mean value coordinates is not symmetric), starting from the initial guess
+// x; res is set to the final relative residual
+static bool solveBiCGSTAB(const parametrizationMatrix &a,
+                          const parametrizationILU &ilu,
+                          const std::vector<double> &b, std::vector<double> &x,
+                          double tol, int maxIter, double &res)
+{
+  std::size_t n = b.size();
+  std::vector<double> r(n), p(n, 0.), v(n, 0.), s(n), t(n), ph(n), sh(n);
+  a.mult(x, r);
+  for(std::size_t i = 0; i < n; i++) r[i] = b[i] - r[i];
+  std::vector<double> r0(r);
+  double nb = sqrt(dot(b, b));
+  if(nb == 0.) nb = 1.;
+  res = sqrt(dot(r, r)) / nb;
+  if(res < tol) return true;
+  double rho = 1., alpha = 1., omega = 1.;
+  for(int iter = 0; iter < maxIter; iter++) {
+    double rho1 = dot(r0, r);
+    if(rho1 == 0.) return false;
+    double beta = (rho1 / rho) * (alpha / omega);
+    rho = rho1;
+    for(std::size_t i = 0; i < n; i++)
+      p[i] = r[i] + beta * (p[i] - omega * v[i]);
+    ilu.solve(p, ph);
+    a.mult(ph, v);
+    alpha = rho / dot(r0, v);
+    for(std::size_t i = 0; i < n; i++) s[i] = r[i] - alpha * v[i];
+    res = sqrt(dot(s, s)) / nb;
+    if(res < tol) {
+      for(std::size_t i = 0; i < n; i++) x[i] += alpha * ph[i];
+      return true;
+    }
+    ilu.solve(s, sh);
+    a.mult(sh, t);
+    double tt = dot(t, t);
+    omega = (tt > 0.) ? dot(t, s) / tt : 0.;
+    for(std::size_t i = 0; i < n; i++) {
+      x[i] += alpha * ph[i] + omega * sh[i];
+      r[i] = s[i] - omega * t[i];
+    }
+    res = sqrt(dot(r, r)) / nb;
+    if(res < tol) return true;
+    if(omega == 0.) return false;
+  }
+  return false;
+}
+
 bool computeParametrization(const std::vector<MTriangle *> &triangles,
                             std::vector<MVertex *> &nodes,
                             std::vector<SPoint2> &stl_vertices_uv,
@@ -519,48 +663,96 @@ bool computeParametrization(const std::vector<MTriangle *> &triangles,
 
   if(triangles.empty()) return false;
 
-  // get nodes and edges
-  std::map<MVertex *, int> nodeIndex;
-  std::map<MEdge, std::vector<MTriangle *>, MEdgeLessThan> edges;
-  for(std::size_t i = 0; i < triangles.size(); i++) {
-    MTriangle *t = triangles[i];
+  // number the nodes in the order of their first appearance in the triangles
+  std::size_t T = triangles.size();
+  std::vector<std::pair<MVertex *, std::size_t> > occ(3 * T);
+  for(std::size_t i = 0; i < T; i++)
+    for(int j = 0; j < 3; j++)
+      occ[3 * i + j] = std::make_pair(triangles[i]->getVertex(j), 3 * i + j);
+  std::sort(occ.begin(), occ.end());
+  std::vector<std::size_t> first(3 * T);
+  for(std::size_t k = 0; k < occ.size();) {
+    std::size_t l = k;
+    for(; l < occ.size() && occ[l].first == occ[k].first; l++)
+      first[occ[l].second] = occ[k].second;
+    k = l;
+  }
+  stl_triangles.resize(3 * T);
+  for(std::size_t k = 0; k < 3 * T; k++) {
+    if(first[k] == k) {
+      stl_triangles[k] = nodes.size();
+      nodes.push_back(triangles[k / 3]->getVertex(k % 3));
+    }
+    else
+      stl_triangles[k] = stl_triangles[first[k]];
+  }
+  const std::vector<int> &tri = stl_triangles;
+  std::vector<std::pair<MVertex *, int> > index(occ.size());
+  for(std::size_t k = 0; k < occ.size(); k++)
+    index[k] = std::make_pair(occ[k].first, tri[occ[k].second]);
+  index.erase(std::unique(index.begin(), index.end()), index.end());
+  std::vector<std::pair<MVertex *, std::size_t> >().swap(occ);
+  std::vector<std::size_t>().swap(first);
+
+  // get the edges, grouped by pairs of nodes
+  std::vector<triangleEdge> edges(3 * T);
+  for(std::size_t i = 0; i < T; i++) {
     for(int j = 0; j < 3; j++) {
-      MVertex *v = t->getVertex(j);
-      if(nodeIndex.find(v) == nodeIndex.end()) {
-        nodeIndex[v] = nodes.size();
-        nodes.push_back(v);
-      }
-      edges[t->getEdge(j)].push_back(t);
+      triangleEdge &e = edges[3 * i + j];
+      int j0 = MTriangle::edges_tri(j, 0), j1 = MTriangle::edges_tri(j, 1);
+      e.node[0] = tri[3 * i + j0];
+      e.node[1] = tri[3 * i + j1];
+      e.opposite = tri[3 * i + 3 - j0 - j1];
+      std::size_t n0 = nodes[e.node[0]]->getNum();
+      std::size_t n1 = nodes[e.node[1]]->getNum();
+      e.num[0] = std::min(n0, n1);
+      e.num[1] = std::max(n0, n1);
+      e.triangle = i;
     }
   }
+  std::sort(edges.begin(), edges.end());
+  std::vector<std::size_t> edgeStart;
+  for(std::size_t k = 0; k < edges.size(); k++) {
+    if(!k || edges[k].num[0] != edges[k - 1].num[0] ||
+       edges[k].num[1] != edges[k - 1].num[1])
+      edgeStart.push_back(k);
+  }
+  edgeStart.push_back(edges.size());
 
   // compute edge loops
   std::vector<MEdge> es;
-  for(std::map<MEdge, std::vector<MTriangle *>, MEdgeLessThan>::const_iterator
-        it = edges.begin(); it != edges.end(); ++it) {
-    if(it->second.size() == 1) { // on boundary
-      es.push_back(it->first);
+  for(std::size_t i = 0; i + 1 < edgeStart.size(); i++) {
+    std::size_t num = edgeStart[i + 1] - edgeStart[i];
+    if(num == 1) { // on boundary
+      const triangleEdge &e = edges[edgeStart[i]];
+      es.push_back(MEdge(nodes[e.node[0]], nodes[e.node[1]]));
     }
-    else if(it->second.size() == 2) { // inside
+    else if(num == 2) { // inside
     }
     else { // non-manifold: not supported
       Msg::Error("Wrong topology of triangulation for parametrization: one "
-                 "edge is incident to %d triangles", it->second.size());
+                 "edge is incident to %d triangles", (int)num);
+      stl_triangles.clear();
+      nodes.clear();
       return false;
     }
   }
   std::vector<std::vector<MVertex *> > vs;
   if(!SortEdgeConsecutive(es, vs)) {
     Msg::Error("Wrong topology of boundary mesh for parametrization");
+    stl_triangles.clear();
+    nodes.clear();
     return false;
   }
   if(vs.empty() || vs[0].size() < 2) {
     Msg::Error("Invalid exterior boundary mesh for parametrization");
+    stl_triangles.clear();
+    nodes.clear();
     return false;
   }
 
   Msg::Debug("Parametrisation of surface with %lu triangles, %lu edges and "
-             "%lu holes", triangles.size(), edges.size(), vs.size() - 1);
+             "%lu holes", T, edgeStart.size() - 1, vs.size() - 1);
 
   // find longest loop and use it as the "exterior" loop
   int loop = 0;
@@ -578,147 +770,151 @@ bool computeParametrization(const std::vector<MTriangle *> &triangles,
 
   // check orientation of the loop and reverse if necessary
   bool reverse = true;
-  MEdge ref(vs[loop][0], vs[loop][1]);
-  for(std::size_t i = 0; i < triangles.size(); i++) {
-    MTriangle *t = triangles[i];
+  int ref0 = nodeIndex(index, vs[loop][0]);
+  int ref1 = nodeIndex(index, vs[loop][1]);
+  for(std::size_t i = 0; i < T && reverse; i++) {
     for(int j = 0; j < 3; j++) {
-      MEdge e = t->getEdge(j);
-      if(e.getVertex(0) == ref.getVertex(0) &&
-         e.getVertex(1) == ref.getVertex(1)) {
+      if(tri[3 * i + MTriangle::edges_tri(j, 0)] == ref0 &&
+         tri[3 * i + MTriangle::edges_tri(j, 1)] == ref1) {
         reverse = false;
         break;
       }
     }
-    if(!reverse) break;
   }
   if(reverse) { std::reverse(vs[0].begin(), vs[0].end()); }
 
-  std::vector<double> u(nodes.size(), 0.), v(nodes.size(), 0.);
+  std::size_t N = nodes.size();
+  std::vector<double> u(N, 0.), v(N, 0.);
 
   // boundary conditions
-  std::vector<bool> bc(nodes.size(), false);
+  std::vector<bool> bc(N, false);
   double currentLength = 0;
-  int index = nodeIndex[vs[loop][0]];
-  bc[index] = true;
-  u[index] = 1.;
-  v[index] = 0.;
+  int idx = nodeIndex(index, vs[loop][0]);
+  bc[idx] = true;
+  u[idx] = 1.;
+  v[idx] = 0.;
   for(std::size_t i = 1; i < vs[loop].size() - 1; i++) {
     currentLength += vs[loop][i]->point().distance(vs[loop][i - 1]->point());
     double angle = 2 * M_PI * currentLength / longest;
-    index = nodeIndex[vs[loop][i]];
-    bc[index] = true;
-    u[index] = cos(angle);
-    v[index] = sin(angle);
+    idx = nodeIndex(index, vs[loop][i]);
+    bc[idx] = true;
+    u[idx] = cos(angle);
+    v[idx] = sin(angle);
   }
 
-  // assemble matrix
-#if defined(HAVE_SOLVER)
-#if defined(HAVE_PETSC)
-  linearSystemPETSc<double> *lsys = new linearSystemPETSc<double>;
-  std::string options = "-ksp_type preonly -pc_type lu ";
-#if defined(PETSC_HAVE_MUMPS)
-  options += "-pc_factor_mat_solver_type mumps";
-#elif defined(PETSC_HAVE_MKL_PARDISO)
-  options += "-pc_factor_mat_solver_type mkl_pardiso";
-#elif defined(PETSC_HAVE_UMFPACK) || defined(PETSC_HAVE_SUITESPARSE)
-  options += "-pc_factor_mat_solver_type umfpack";
-#endif
-  lsys->setParameter("petsc_solver_options", options);
-  lsys->setParameter("matrix_reuse", "same_matrix");
-#elif defined(HAVE_GMM)
-  linearSystemCSRGmm<double> *lsys = new linearSystemCSRGmm<double>;
-#else
-  linearSystemFull<double> *lsys = new linearSystemFull<double>;
-#endif
-
-  lsys->allocate(nodes.size());
-
-#if defined(HAVE_PETSC)
-  for(std::map<MEdge, std::vector<MTriangle *>, MEdgeLessThan>::const_iterator
-        it = edges.begin();
-      it != edges.end(); ++it) {
-    for(int i = 0; i < 2; i++) {
-      for(int j = 0; j < 2; j++) {
-        lsys->insertInSparsityPattern(nodeIndex[it->first.getVertex(i)],
-                                      nodeIndex[it->first.getVertex(j)]);
-      }
-    }
-  }
-#endif
-
-  for(std::map<MEdge, std::vector<MTriangle *>, MEdgeLessThan>::const_iterator
-        it = edges.begin();
-      it != edges.end(); ++it) {
+  // assemble the matrix, with one row per node: mean value coordinates for the
+  // free nodes, identity for the nodes on the exterior loop
+  std::vector<std::pair<int, double> > offDiag(2 * (edgeStart.size() - 1));
+  std::vector<int> offDiagRow(offDiag.size(), -1);
+  std::vector<double> diag(N, 0.);
+  for(std::size_t i = 0; i + 1 < edgeStart.size(); i++) {
+    const triangleEdge &eLeft = edges[edgeStart[i]];
     for(int ij = 0; ij < 2; ij++) {
-      MVertex *v0 = it->first.getVertex(ij);
-      int index0 = nodeIndex[v0];
+      int index0 = eLeft.node[ij];
       if(bc[index0]) continue; // boundary condition
-      MVertex *v1 = it->first.getVertex(1 - ij);
-      int index1 = nodeIndex[v1];
-      MTriangle *tLeft = it->second[0];
-      MVertex *vLeft = tLeft->getVertex(0);
-      if(vLeft == v0 || vLeft == v1) vLeft = tLeft->getVertex(1);
-      if(vLeft == v0 || vLeft == v1) vLeft = tLeft->getVertex(2);
+      int index1 = eLeft.node[1 - ij];
+      MVertex *v0 = nodes[index0], *v1 = nodes[index1];
+      MVertex *vLeft = nodes[eLeft.opposite];
       double e[3] = {v1->x() - v0->x(), v1->y() - v0->y(), v1->z() - v0->z()};
       double ne = sqrt(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
-      double a[3] = {vLeft->x() - v0->x(),
-                     vLeft->y() - v0->y(),
+      double a[3] = {vLeft->x() - v0->x(), vLeft->y() - v0->y(),
                      vLeft->z() - v0->z()};
       double na = sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
-      double thetaL = acos((a[0] * e[0] + a[1] * e[1] + a[2] * e[2]) / (na * ne));
+      double thetaL =
+        acos((a[0] * e[0] + a[1] * e[1] + a[2] * e[2]) / (na * ne));
       double thetaR = 0.;
-      if(it->second.size() == 2) {
-        MTriangle *tRight = it->second[1];
-        MVertex *vRight = tRight->getVertex(0);
-        if(vRight == v0 || vRight == v1) vRight = tRight->getVertex(1);
-        if(vRight == v0 || vRight == v1) vRight = tRight->getVertex(2);
-        double b[3] = {vRight->x() - v0->x(),
-                       vRight->y() - v0->y(),
+      if(edgeStart[i + 1] - edgeStart[i] == 2) {
+        MVertex *vRight = nodes[edges[edgeStart[i] + 1].opposite];
+        double b[3] = {vRight->x() - v0->x(), vRight->y() - v0->y(),
                        vRight->z() - v0->z()};
         double nb = sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
         thetaR = acos((b[0] * e[0] + b[1] * e[1] + b[2] * e[2]) / (nb * ne));
       }
       double c = (tan(.5 * thetaL) + tan(.5 * thetaR)) / ne;
-      lsys->addToMatrix(index0, index1, -c);
-      lsys->addToMatrix(index0, index0, c);
+      offDiag[2 * i + ij] = std::make_pair(index1, -c);
+      offDiagRow[2 * i + ij] = index0;
+      diag[index0] += c;
     }
   }
-  for(std::size_t i = 0; i < vs[loop].size() - 1; i++) {
-    int row = nodeIndex[vs[loop][i]];
-    lsys->addToMatrix(row, row, 1);
+  for(std::size_t i = 0; i < N; i++)
+    if(bc[i]) diag[i] += 1.;
+
+  parametrizationMatrix A;
+  A.rowStart.assign(N + 1, 0);
+  for(std::size_t i = 0; i < N; i++) A.rowStart[i + 1] = 1;
+  for(std::size_t k = 0; k < offDiag.size(); k++)
+    if(offDiagRow[k] >= 0) A.rowStart[offDiagRow[k] + 1]++;
+  for(std::size_t i = 0; i < N; i++) A.rowStart[i + 1] += A.rowStart[i];
+  std::vector<std::pair<int, double> > entries(A.rowStart[N]);
+  std::vector<int> fill(A.rowStart.begin(), A.rowStart.end() - 1);
+  for(std::size_t i = 0; i < N; i++)
+    entries[fill[i]++] = std::make_pair((int)i, diag[i]);
+  for(std::size_t k = 0; k < offDiag.size(); k++)
+    if(offDiagRow[k] >= 0) entries[fill[offDiagRow[k]]++] = offDiag[k];
+  A.col.resize(entries.size());
+  A.val.resize(entries.size());
+  for(std::size_t i = 0; i < N; i++) {
+    std::sort(entries.begin() + A.rowStart[i],
+              entries.begin() + A.rowStart[i + 1]);
+    for(int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++) {
+      A.col[k] = entries[k].first;
+      A.val[k] = entries[k].second;
+    }
   }
 
-  lsys->zeroRightHandSide();
-  for(std::size_t i = 0; i < vs[loop].size() - 1; i++) {
-    int row = nodeIndex[vs[loop][i]];
-    lsys->addToRightHandSide(row, u[row]);
+  // right-hand sides: the boundary conditions (also used as initial guess)
+  std::vector<double> bu(N, 0.), bv(N, 0.);
+  for(std::size_t i = 0; i < N; i++) {
+    if(!bc[i]) continue;
+    bu[i] = u[i];
+    bv[i] = v[i];
   }
-  lsys->systemSolve();
-  for(std::size_t i = 0; i < nodes.size(); i++) lsys->getFromSolution(i, u[i]);
 
-  lsys->zeroRightHandSide();
-  for(std::size_t i = 0; i < vs[loop].size() - 1; i++) {
-    int row = nodeIndex[vs[loop][i]];
-    lsys->addToRightHandSide(row, v[row]);
+#if defined(HAVE_SOLVER) && defined(HAVE_PETSC)
+  linearSystemPETSc<double> *lsys = new linearSystemPETSc<double>;
+  std::string options = "-ksp_type preonly -pc_type lu ";
+#if defined(PETSC_HAVE_MUMPS)
+  options += "-pc_factor_mat_solver_type mumps";
+#elif defined(PETSC_HAVE_MKL_PARDISO)
+  options += "-pc_factor_mat_solver_type mkl_pardiso";
+#elif defined(PETSC_HAVE_UMFPACK) || defined(PETSC_HAVE_SUITESPARSE)
+  options += "-pc_factor_mat_solver_type umfpack";
+#endif
+  lsys->setParameter("petsc_solver_options", options);
+  lsys->setParameter("matrix_reuse", "same_matrix");
+  lsys->allocate(N);
+  for(std::size_t i = 0; i < N; i++)
+    for(int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++)
+      lsys->insertInSparsityPattern(i, A.col[k]);
+  for(std::size_t i = 0; i < N; i++)
+    for(int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++)
+      lsys->addToMatrix(i, A.col[k], A.val[k]);
+  for(int uv = 0; uv < 2; uv++) {
+    std::vector<double> &b = uv ? bv : bu, &x = uv ? v : u;
+    lsys->zeroRightHandSide();
+    for(std::size_t i = 0; i < N; i++)
+      if(bc[i]) lsys->addToRightHandSide(i, b[i]);
+    lsys->systemSolve();
+    for(std::size_t i = 0; i < N; i++) lsys->getFromSolution(i, x[i]);
   }
-  lsys->systemSolve();
-  for(std::size_t i = 0; i < nodes.size(); i++) lsys->getFromSolution(i, v[i]);
-
   delete lsys;
+#else
+  // the factorization is shared by the two solves
+  parametrizationILU ilu(A);
+  for(int uv = 0; uv < 2; uv++) {
+    double res;
+    if(!solveBiCGSTAB(A, ilu, uv ? bv : bu, uv ? v : u, 1.e-10, 10000, res))
+      Msg::Warning("Iterative linear solver has not converged (res = %g)",
+                   res);
+  }
 #endif
 
-  stl_vertices_uv.resize(nodes.size());
-  stl_vertices_xyz.resize(nodes.size());
-  for(std::size_t i = 0; i < nodes.size(); i++) {
+  stl_vertices_uv.resize(N);
+  stl_vertices_xyz.resize(N);
+  for(std::size_t i = 0; i < N; i++) {
     stl_vertices_uv[i] = SPoint2(u[i], v[i]);
     stl_vertices_xyz[i] = nodes[i]->point();
   }
-  stl_triangles.resize(3 * triangles.size());
-  for(std::size_t i = 0; i < triangles.size(); i++) {
-    stl_triangles[3 * i + 0] = nodeIndex[triangles[i]->getVertex(0)];
-    stl_triangles[3 * i + 1] = nodeIndex[triangles[i]->getVertex(1)];
-    stl_triangles[3 * i + 2] = nodeIndex[triangles[i]->getVertex(2)];
-  }
 
   return true;
 }
@@ -764,7 +764,7 @@ static double _computeDeterminantAndRegularize(const MElement *ele,
   return dJ;
 }
 
-static double _computeDeterminantAndRegularize(const MElement *ele, double *jac)
+double MElement::computeDeterminantAndRegularize(int dim, double *jac)
 {
   double dJ = 0;
 
@@ -774,7 +774,7 @@ static double _computeDeterminantAndRegularize(const MElement *ele, double *jac)
   //  |3 4 5|
   //  |6 7 8|
 
-  switch(ele->getDim()) {
+  switch(dim) {
   case 0: {
     dJ = 1.0;
     jac[0] = jac[4] = jac[8] = 1.0;
@@ -920,7 +920,7 @@ double MElement::getJacobian(const std::vector<SVector3> &gsf,
       jac[3 * j + 2] += v->z() * mult;
     }
   }
-  return _computeDeterminantAndRegularize(this, jac);
+  return computeDeterminantAndRegularize(getDim(), jac);
 }
 
 double MElement::getJacobian(double u, double v, double w,
@@ -361,6 +361,10 @@ public:
   virtual double getJacobian(double u, double v, double w,
                              double jac[3][3]) const;
   double getJacobian(double u, double v, double w, fullMatrix<double> &j) const;
+  // compute the determinant of the row-major Jacobian jac of an element of
+  // dimension dim and regularize it, i.e. complete it with unit normal rows
+  // so that it is invertible
+  static double computeDeterminantAndRegularize(int dim, double *jac);
   virtual double getPrimaryJacobian(double u, double v, double w,
                                     double jac[3][3]) const;
   double getJacobianDeterminant(double u, double v, double w) const
@@ -403,8 +407,14 @@ public:
   virtual void movePointFromElementSpaceToParentSpace(double &u, double &v,
                                                       double &w) const;
 
-  // test if a point, given in parametric coordinates, belongs to the element
-  virtual bool isInside(double u, double v, double w) const = 0;
+  // test if a point, given in parametric coordinates, belongs to the element,
+  // up to the given tolerance (or to the global tolerance set with
+  // setTolerance())
+  virtual bool isInside(double u, double v, double w, double tol) const = 0;
+  bool isInside(double u, double v, double w) const
+  {
+    return isInside(u, v, w, _isInsideTolerance);
+  }
 
   // interpolate the given nodal data (resp. its gradient, curl and divergence)
   // at point (u,v,w) in parametric coordinates
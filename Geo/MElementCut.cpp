@@ -81,7 +81,7 @@ void MPolyhedron::_init()
   }
 }
 
-bool MPolyhedron::isInside(double u, double v, double w) const
+bool MPolyhedron::isInside(double u, double v, double w, double tol) const
 {
   if(!_orig) return false;
   double uvw[3] = {u, v, w};
@@ -99,7 +99,7 @@ bool MPolyhedron::isInside(double u, double v, double w) const
     MTetrahedron t(&v0, &v1, &v2, &v3);
     double ksi[3];
     t.xyz2uvw(uvw, ksi);
-    if(t.isInside(ksi[0], ksi[1], ksi[2])) return true;
+    if(t.isInside(ksi[0], ksi[1], ksi[2], tol)) return true;
   }
   return false;
 }
@@ -254,7 +254,7 @@ void MPolygon::_initVertices()
   }
 }
 
-bool MPolygon::isInside(double u, double v, double w) const
+bool MPolygon::isInside(double u, double v, double w, double tol) const
 {
   if(!getParent()) return false;
   double uvw[3] = {u, v, w};
@@ -271,7 +271,7 @@ bool MPolygon::isInside(double u, double v, double w) const
     MTriangle t(&v0, &v1, &v2);
     double ksi[3];
     t.xyz2uvw(uvw, ksi);
-    if(t.isInside(ksi[0], ksi[1], ksi[2])) return true;
+    if(t.isInside(ksi[0], ksi[1], ksi[2], tol)) return true;
   }
   return false;
 }
@@ -318,7 +318,7 @@ void MPolygon::getIntegrationPoints(int pOrder, int *npts, IntPt **pts)
 
 //----------------------------------- MLineChild ------------------------------
 
-bool MLineChild::isInside(double u, double v, double w) const
+bool MLineChild::isInside(double u, double v, double w, double tol) const
 {
   if(!_orig) return false;
   double uvw[3] = {u, v, w};
@@ -333,7 +333,7 @@ bool MLineChild::isInside(double u, double v, double w) const
   MLine l(&v0, &v1);
   double ksi[3];
   l.xyz2uvw(uvw, ksi);
-  if(l.isInside(ksi[0], ksi[1], ksi[2])) return true;
+  if(l.isInside(ksi[0], ksi[1], ksi[2], tol)) return true;
   return false;
 }
 
@@ -373,7 +373,7 @@ void MLineChild::getIntegrationPoints(int pOrder, int *npts, IntPt **pts)
 //----------------------------------- MTriangleBorder
 //------------------------------
 
-bool MTriangleBorder::isInside(double u, double v, double w) const
+bool MTriangleBorder::isInside(double u, double v, double w, double tol) const
 {
   if(!getParent()) return false;
   double uvw[3] = {u, v, w};
@@ -389,7 +389,7 @@ bool MTriangleBorder::isInside(double u, double v, double w) const
   MTriangle t(&v0, &v1, &v2);
   double ksi[3];
   t.xyz2uvw(uvw, ksi);
-  if(t.isInside(ksi[0], ksi[1], ksi[2])) return true;
+  if(t.isInside(ksi[0], ksi[1], ksi[2], tol)) return true;
   return false;
 }
 
@@ -432,7 +432,7 @@ void MTriangleBorder::getIntegrationPoints(int pOrder, int *npts, IntPt **pts)
 //-------------------------------------- MLineBorder
 //------------------------------
 
-bool MLineBorder::isInside(double u, double v, double w) const
+bool MLineBorder::isInside(double u, double v, double w, double tol) const
 {
   if(!getParent()) return false;
   double uvw[3] = {u, v, w};
@@ -447,7 +447,7 @@ bool MLineBorder::isInside(double u, double v, double w) const
   MLine l(&v0, &v1);
   double ksi[3];
   l.xyz2uvw(uvw, ksi);
-  if(l.isInside(ksi[0], ksi[1], ksi[2])) return true;
+  if(l.isInside(ksi[0], ksi[1], ksi[2], tol)) return true;
   return false;
 }
 
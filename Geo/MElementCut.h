@@ -169,7 +169,8 @@ public:
 
   // the parametric coordinates of the polyhedron are
   // the coordinates in the local parent element.
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
   virtual MElement *getParent() const { return _orig; }
   virtual void setParent(MElement *p, bool owner = false)
@@ -344,7 +345,8 @@ public:
 
   // the parametric coordinates of the polygon are
   // the coordinates in the local parent element.
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
   virtual std::size_t getNumVerticesForMSH() { return _parts.size() * 3; }
   virtual void getVerticesIdForMSH(std::vector<int> &verts)
@@ -413,7 +415,8 @@ public:
   }
   // the parametric coordinates of the LineChildren are
   // the coordinates in the local parent element.
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
   virtual MElement *getParent() const { return _orig; }
   virtual void setParent(MElement *p, bool owner = false)
@@ -456,7 +459,8 @@ public:
     return NULL;
   }
   virtual int getTypeForMSH() const { return MSH_TRI_B; }
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   // the integration points of the MTriangleBorder are in the parent element
   // space
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
@@ -526,7 +530,8 @@ public:
     return NULL;
   }
   virtual int getTypeForMSH() const { return MSH_LIN_B; }
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   // the integration points of the MLineBorder are in the parent element space
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
 };
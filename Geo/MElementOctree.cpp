@@ -6,7 +6,6 @@
 #include "GModel.h"
 #include "MElement.h"
 #include "MElementOctree.h"
-#include "Octree.h"
 #include "Context.h"
 #include "fullMatrix.h"
 #include "bezierBasis.h"
@@ -55,26 +54,6 @@ void MElementBB(void *a, double *min, double *max)
   }
 }
 
-static void MElementCentroid(void *a, double *x)
-{
-  MElement *e = (MElement *)a;
-  MVertex *v = e->getVertex(0);
-  int n = e->getNumVertices();
-  x[0] = v->x();
-  x[1] = v->y();
-  x[2] = v->z();
-  for(int i = 1; i < n; i++) {
-    v = e->getVertex(i);
-    x[0] += v->x();
-    x[1] += v->y();
-    x[2] += v->z();
-  }
-  double oc = 1. / (double)n;
-  x[0] *= oc;
-  x[1] *= oc;
-  x[2] *= oc;
-}
-
 int MElementInEle(void *a, double *x)
 {
   MElement *e = (MElement *)a;
@@ -83,20 +62,103 @@ int MElementInEle(void *a, double *x)
   return e->isInside(uvw[0], uvw[1], uvw[2]) ? 1 : 0;
 }
 
+namespace {
+
+  // find the first element of the given dimension containing the point
+  class elementContaining {
+  private:
+    const std::vector<MElement *> &_elements;
+    double *_P;
+    int _dim;
+
+  public:
+    MElement *found;
+    elementContaining(const std::vector<MElement *> &elements, double *P,
+                      int dim)
+      : _elements(elements), _P(P), _dim(dim), found(0)
+    {
+    }
+    bool operator()(std::size_t i)
+    {
+      MElement *e = _elements[i];
+      if(_dim != -1 && e->getDim() != _dim) return false;
+      if(!MElementInEle(e, _P)) return false;
+      found = e;
+      return true;
+    }
+  };
+
+  // collect all the elements of the given dimension containing the point
+  class elementsContaining {
+  private:
+    const std::vector<MElement *> &_elements;
+    double *_P;
+    int _dim;
+
+  public:
+    std::vector<MElement *> found;
+    elementsContaining(const std::vector<MElement *> &elements, double *P,
+                       int dim)
+      : _elements(elements), _P(P), _dim(dim)
+    {
+    }
+    bool operator()(std::size_t i)
+    {
+      MElement *e = _elements[i];
+      if((_dim == -1 || e->getDim() == _dim) && MElementInEle(e, _P))
+        found.push_back(e);
+      return false;
+    }
+  };
+
+  bool inElementWithTolerance(MElement *e, double *x, int dim, double tol)
+  {
+    if(dim != -1 && e->getDim() != dim) return false;
+    double uvw[3];
+    e->xyz2uvw(x, uvw);
+    return e->isInside(uvw[0], uvw[1], uvw[2], tol);
+  }
+
+  // brute-force search with a progressively increased isInside() tolerance,
+  // up to maxTol; find the first element, or all the elements if all is set.
+  // The tolerance is passed to each test, so that concurrent searches do not
+  // interfere
+  void findWithTolerance(GModel *gm, const std::vector<MElement *> &elems,
+                         double *P, int dim, double maxTol, bool all,
+                         std::vector<MElement *> &e)
+  {
+    std::vector<GEntity *> entities;
+    if(gm) gm->getEntities(entities);
+    double tol = MElement::getTolerance();
+    while(tol < maxTol) {
+      tol *= 10.;
+      if(gm) {
+        for(std::size_t i = 0; i < entities.size(); i++) {
+          for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
+            MElement *el = entities[i]->getMeshElement(j);
+            if(inElementWithTolerance(el, P, dim, tol)) {
+              e.push_back(el);
+              if(!all) return;
+            }
+          }
+        }
+      }
+      else {
+        for(std::size_t i = 0; i < elems.size(); i++) {
+          if(inElementWithTolerance(elems[i], P, dim, tol)) {
+            e.push_back(elems[i]);
+            if(!all) return;
+          }
+        }
+      }
+      if(!e.empty()) return;
+    }
+  }
+
+} // namespace
+
 MElementOctree::MElementOctree(GModel *m) : _gm(m)
 {
-  SBoundingBox3d bb = m->bounds();
-  // make bounding box larger up to (absolute) geometrical tolerance
-  double eps = CTX::instance()->geom.tolerance;
-  SPoint3 bbmin = bb.min(), bbmax = bb.max(), bbeps(eps, eps, eps);
-  bbmin -= bbeps;
-  bbmax += bbeps;
-  double min[3] = {bbmin.x(), bbmin.y(), bbmin.z()};
-  double size[3] = {bbmax.x() - bbmin.x(), bbmax.y() - bbmin.y(),
-                    bbmax.z() - bbmin.z()};
-  const int maxElePerBucket = 100; // memory vs. speed trade-off
-  _octree = Octree_Create(maxElePerBucket, min, size, MElementBB,
-                          MElementCentroid, MElementInEle);
   std::vector<GEntity *> entities;
   m->getEntities(entities);
   // do not add Gvertex non-associated to any GEdge
@@ -105,104 +167,43 @@ MElementOctree::MElementOctree(GModel *m) : _gm(m)
       if(entities[i]->dim() == 0) {
         GVertex *gv = dynamic_cast<GVertex *>(entities[i]);
         if(gv && gv->edges().size() > 0) {
-          Octree_Insert(entities[i]->getMeshElement(j), _octree);
+          _elements.push_back(entities[i]->getMeshElement(j));
         }
       }
       else
-        Octree_Insert(entities[i]->getMeshElement(j), _octree);
+        _elements.push_back(entities[i]->getMeshElement(j));
     }
   }
-  Octree_Arrange(_octree);
+  _build();
 }
 
 MElementOctree::MElementOctree(const std::vector<MElement *> &v)
-  : _gm(0), _elems(v)
+  : _gm(0), _elems(v), _elements(v)
 {
-  SBoundingBox3d bb;
-  for(std::size_t i = 0; i < v.size(); i++) {
-    for(std::size_t j = 0; j < v[i]->getNumVertices(); j++) {
-      bb += SPoint3(v[i]->getVertex(j)->x(), v[i]->getVertex(j)->y(),
-                    v[i]->getVertex(j)->z());
-    }
-  }
-  // make bounding box larger up to (absolute) geometrical tolerance
-  double eps = CTX::instance()->geom.tolerance;
-  SPoint3 bbmin = bb.min(), bbmax = bb.max(), bbeps(eps, eps, eps);
-  bbmin -= bbeps;
-  bbmax += bbeps;
-  double min[3] = {bbmin.x(), bbmin.y(), bbmin.z()};
-  double size[3] = {bbmax.x() - bbmin.x(), bbmax.y() - bbmin.y(),
-                    bbmax.z() - bbmin.z()};
-  const int maxElePerBucket = 100; // memory vs. speed trade-off
-  _octree = Octree_Create(maxElePerBucket, min, size, MElementBB,
-                          MElementCentroid, MElementInEle);
-  for(std::size_t i = 0; i < v.size(); i++) Octree_Insert(v[i], _octree);
-  Octree_Arrange(_octree);
+  _build();
 }
 
-MElementOctree::~MElementOctree() { Octree_Delete(_octree); }
+MElementOctree::~MElementOctree() {}
 
-std::vector<MElement *> MElementOctree::findAll(double x, double y, double z,
-                                                int dim, bool strict)
+void MElementOctree::_build()
 {
-  double maxTol = 1.;
-  double tolIncr = 10.;
+  std::vector<SBoundingBox3d> boxes(_elements.size());
+  for(std::size_t i = 0; i < _elements.size(); i++) {
+    double min[3], max[3];
+    MElementBB(_elements[i], min, max);
+    boxes[i] = SBoundingBox3d(min[0], min[1], min[2], max[0], max[1], max[2]);
+  }
+  _tree.build(boxes);
+}
 
+std::vector<MElement *> MElementOctree::findAll(double x, double y, double z,
+                                                int dim, bool strict) const
+{
   double P[3] = {x, y, z};
-  std::vector<void *> v;
-  std::vector<MElement *> e;
-  Octree_SearchAll(P, _octree, &v);
-  for(std::vector<void *>::iterator it = v.begin(); it != v.end(); ++it) {
-    MElement *el = (MElement *)*it;
-    if(dim == -1 || el->getDim() == dim) e.push_back(el);
-  }
-  if(e.empty() && !strict && _gm) {
-    double initialTol = MElement::getTolerance();
-    double tol = initialTol;
-    while(tol < maxTol) {
-      tol *= tolIncr;
-      MElement::setTolerance(tol);
-      std::vector<GEntity *> entities;
-      _gm->getEntities(entities);
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          MElement *el = entities[i]->getMeshElement(j);
-          if(dim == -1 || el->getDim() == dim) {
-            if(MElementInEle(el, P)) {
-              e.push_back(el);
-            }
-          }
-        }
-      }
-      if(!e.empty()) {
-        MElement::setTolerance(initialTol);
-        return e;
-      }
-    }
-    MElement::setTolerance(initialTol);
-  }
-  else if(e.empty() && !strict && !_gm) {
-    double initialTol = MElement::getTolerance();
-    double tol = initialTol;
-    while(tol < maxTol) {
-      tol *= tolIncr;
-      MElement::setTolerance(tol);
-      for(std::size_t i = 0; i < _elems.size(); i++) {
-        MElement *el = _elems[i];
-        if(dim == -1 || el->getDim() == dim) {
-          if(MElementInEle(el, P)) {
-            e.push_back(el);
-          }
-        }
-      }
-      if(!e.empty()) {
-        MElement::setTolerance(initialTol);
-        return e;
-      }
-    }
-    MElement::setTolerance(initialTol);
-    // Msg::Warning("Point %g %g %g not found",x,y,z);
-  }
+  elementsContaining visitor(_elements, P, dim);
+  _tree.search(P, visitor);
+  std::vector<MElement *> &e = visitor.found;
+  if(e.empty() && !strict) findWithTolerance(_gm, _elems, P, dim, 1., true, e);
   return e;
 }
 
@@ -210,59 +211,12 @@ MElement *MElementOctree::find(double x, double y, double z, int dim,
                                bool strict) const
 {
   double P[3] = {x, y, z};
-  MElement *e = (MElement *)Octree_Search(P, _octree);
-  if(e && (dim == -1 || e->getDim() == dim)) return e;
-  std::vector<void *> l;
-  if(e && e->getDim() != dim) {
-    Octree_SearchAll(P, _octree, &l);
-    for(std::vector<void *>::iterator it = l.begin(); it != l.end(); it++) {
-      MElement *el = (MElement *)*it;
-      if(el->getDim() == dim) {
-        return el;
-      }
-    }
-  }
-  if(!strict && _gm) {
-    double initialTol = MElement::getTolerance();
-    double tol = initialTol;
-    while(tol < 1.) {
-      tol *= 10;
-      MElement::setTolerance(tol);
-      std::vector<GEntity *> entities;
-      _gm->getEntities(entities);
-      for(std::size_t i = 0; i < entities.size(); i++) {
-        for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          e = entities[i]->getMeshElement(j);
-          if(dim == -1 || e->getDim() == dim) {
-            if(MElementInEle(e, P)) {
-              MElement::setTolerance(initialTol);
-              return e;
-            }
-          }
-        }
-      }
-    }
-    MElement::setTolerance(initialTol);
-    // Msg::Warning("Point %g %g %g not found",x,y,z);
-  }
-  else if(!strict && !_gm) {
-    double initialTol = MElement::getTolerance();
-    double tol = initialTol;
-    while(tol < 0.1) {
-      tol *= 10.0;
-      MElement::setTolerance(tol);
-      for(std::size_t i = 0; i < _elems.size(); i++) {
-        e = _elems[i];
-        if(dim == -1 || e->getDim() == dim) {
-          if(MElementInEle(e, P)) {
-            MElement::setTolerance(initialTol);
-            return e;
-          }
-        }
-      }
-    }
-    MElement::setTolerance(initialTol);
-    // Msg::Warning("Point %g %g %g not found",x,y,z);
+  elementContaining visitor(_elements, P, dim);
+  if(_tree.search(P, visitor)) return visitor.found;
+  if(!strict) {
+    std::vector<MElement *> e;
+    findWithTolerance(_gm, _elems, P, dim, _gm ? 1. : 0.1, false, e);
+    if(e.size()) return e[0];
   }
   return NULL;
 }
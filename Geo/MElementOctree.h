@@ -7,16 +7,23 @@
 #define MELEMENT_OCTREE
 
 #include <vector>
+#include "SBoundingBoxTree.h"
 
-class Octree;
 class GModel;
 class MElement;
 
+// Point location in a set of mesh elements, using a bounding volume hierarchy
+// over the bounding boxes of the elements. The searches are thread-safe. When
+// the point is not found and the search is not strict, all the elements are
+// tested with a progressively increased isInside() tolerance.
 class MElementOctree {
 private:
-  Octree *_octree;
+  SBoundingBoxTree _tree;
   GModel *_gm;
   std::vector<MElement *> _elems;
+  // elements in the tree
+  std::vector<MElement *> _elements;
+  void _build();
 
 public:
   MElementOctree(GModel *);
@@ -24,8 +31,7 @@ public:
   ~MElementOctree();
   MElement *find(double x, double y, double z, int dim = -1,
                  bool strict = false) const;
-  Octree *getInternalOctree() { return _octree; }
   std::vector<MElement *> findAll(double x, double y, double z, int dim,
-                                  bool strict = false);
+                                  bool strict = false) const;
 };
 #endif
@@ -178,9 +178,9 @@ public:
     }
   }
   virtual SPoint3 barycenterUVW() const { return SPoint3(0., 0., 0.); }
-  virtual bool isInside(double u, double v, double w) const
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const
   {
-    double tol = getTolerance();
     if(u < -(1. + tol) || v < -(1. + tol) || w < -(1. + tol) ||
        u > (1. + tol) || v > (1. + tol) || w > (1. + tol))
       return false;
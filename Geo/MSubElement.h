@@ -96,7 +96,8 @@ public:
                                                       double &w) const;
   virtual void movePointFromElementSpaceToParentSpace(double &u, double &v,
                                                       double &w) const;
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
 
   virtual MElement *getParent() const { return _orig; }
@@ -203,7 +204,8 @@ public:
                                                       double &w) const;
   virtual void movePointFromElementSpaceToParentSpace(double &u, double &v,
                                                       double &w) const;
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
 
   virtual MElement *getParent() const { return _orig; }
@@ -310,7 +312,8 @@ public:
                                                       double &w) const;
   virtual void movePointFromElementSpaceToParentSpace(double &u, double &v,
                                                       double &w) const;
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
 
   virtual MElement *getParent() const { return _orig; }
@@ -417,7 +420,8 @@ public:
                                                       double &w) const;
   virtual void movePointFromElementSpaceToParentSpace(double &u, double &v,
                                                       double &w) const;
-  virtual bool isInside(double u, double v, double w) const;
+  using MElement::isInside;
+  virtual bool isInside(double u, double v, double w, double tol) const;
   virtual void getIntegrationPoints(int pOrder, int *npts, IntPt **pts);
 
   virtual MElement *getParent() const { return _orig; }
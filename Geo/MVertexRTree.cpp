@@ -0,0 +1,188 @@
+// Gmsh - Copyright (C) 1997-2020 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
+
+#include <algorithm>
+#include <cmath>
+#include "MVertexRTree.h"
+
+namespace {
+
+  struct cellEntry {
+    long long cell[3];
+    std::size_t index;
+    bool operator<(const cellEntry &other) const
+    {
+      for(int k = 0; k < 3; k++) {
+        if(cell[k] < other.cell[k]) return true;
+        if(cell[k] > other.cell[k]) return false;
+      }
+      return index < other.index;
+    }
+  };
+
+  inline void coordinates(const std::vector<MVertex *> &v, std::size_t i,
+                          double xyz[3])
+  {
+    xyz[0] = v[i]->x();
+    xyz[1] = v[i]->y();
+    xyz[2] = v[i]->z();
+  }
+
+  inline void coordinates(const std::vector<SPoint3> &p, std::size_t i,
+                          double xyz[3])
+  {
+    xyz[0] = p[i].x();
+    xyz[1] = p[i].y();
+    xyz[2] = p[i].z();
+  }
+
+  // same test as the overlap of the tolerance boxes in the R-tree
+  inline bool overlap(const double a[3], const double b[3], double tol)
+  {
+    return (a[0] - tol <= b[0] + tol && b[0] - tol <= a[0] + tol &&
+            a[1] - tol <= b[1] + tol && b[1] - tol <= a[1] + tol &&
+            a[2] - tol <= b[2] + tol && b[2] - tol <= a[2] + tol);
+  }
+
+  // Points is either a vector of MVertex pointers or a vector of SPoint3
+  template <class Points> class spatialHash {
+  private:
+    const Points &_v;
+    double _tol, _min[3], _h;
+    std::vector<cellEntry> _entries;
+
+  public:
+    spatialHash(const Points &v, double tol) : _v(v), _tol(tol)
+    {
+      double max[3];
+      for(int k = 0; k < 3; k++) {
+        _min[k] = 1.e300;
+        max[k] = -1.e300;
+      }
+      for(std::size_t i = 0; i < v.size(); i++) {
+        double xyz[3];
+        coordinates(v, i, xyz);
+        for(int k = 0; k < 3; k++) {
+          _min[k] = std::min(_min[k], xyz[k]);
+          max[k] = std::max(max[k], xyz[k]);
+        }
+      }
+      // vertices closer than 2 * tol (the cell size) are in adjacent cells;
+      // make sure that the cell indices cannot overflow
+      double ext = std::max(max[0] - _min[0],
+                            std::max(max[1] - _min[1], max[2] - _min[2]));
+      _h = 2. * tol * (1. + 1.e-6);
+      if(_h < ext * 1.e-12) _h = ext * 1.e-12;
+      if(_h <= 0.) _h = 1.;
+      _entries.resize(v.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for(long int i = 0; i < (long int)v.size(); i++) {
+        cell(i, _entries[i].cell);
+        _entries[i].index = i;
+      }
+      std::sort(_entries.begin(), _entries.end());
+    }
+    void cell(std::size_t i, long long c[3]) const
+    {
+      double xyz[3];
+      coordinates(_v, i, xyz);
+      for(int k = 0; k < 3; k++)
+        c[k] = (long long)std::floor((xyz[k] - _min[k]) / _h);
+    }
+    // smallest index j < i of a vertex overlapping v[i] (or i if there is
+    // none); if duplicateOf is given, only consider the vertices j that are
+    // not duplicates, i.e. such that (*duplicateOf)[j] == j
+    std::size_t first(std::size_t i,
+                      const std::vector<std::size_t> *duplicateOf = 0) const
+    {
+      std::size_t best = i;
+      double xyz[3];
+      coordinates(_v, i, xyz);
+      cellEntry e;
+      cell(i, e.cell);
+      long long c[3] = {e.cell[0], e.cell[1], e.cell[2]};
+      for(int dx = -1; dx <= 1; dx++) {
+        for(int dy = -1; dy <= 1; dy++) {
+          for(int dz = -1; dz <= 1; dz++) {
+            e.cell[0] = c[0] + dx;
+            e.cell[1] = c[1] + dy;
+            e.cell[2] = c[2] + dz;
+            e.index = 0;
+            std::vector<cellEntry>::const_iterator it =
+              std::lower_bound(_entries.begin(), _entries.end(), e);
+            for(; it != _entries.end(); ++it) {
+              if(it->cell[0] != e.cell[0] || it->cell[1] != e.cell[1] ||
+                 it->cell[2] != e.cell[2] || it->index >= best)
+                break;
+              if(duplicateOf && (*duplicateOf)[it->index] != it->index)
+                continue;
+              double xyzj[3];
+              coordinates(_v, it->index, xyzj);
+              if(overlap(xyzj, xyz, _tol)) {
+                best = it->index;
+                break;
+              }
+            }
+          }
+        }
+      }
+      return best;
+    }
+  };
+
+  template <class Points>
+  std::size_t findDuplicateIndices(const Points &v, double tolerance,
+                                   std::vector<std::size_t> &duplicateOf)
+  {
+    duplicateOf.resize(v.size());
+    for(std::size_t i = 0; i < v.size(); i++) duplicateOf[i] = i;
+    if(v.size() < 2) return 0;
+
+    spatialHash<Points> hash(v, tolerance);
+
+    // first overlapping vertex, computed in parallel
+    std::vector<std::size_t> first(v.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 4096)
+#endif
+    for(long int i = 0; i < (long int)v.size(); i++) first[i] = hash.first(i);
+
+    // resolve the duplicates in order: the first overlapping vertex v[j] can
+    // only be a duplicate itself if the vertex it duplicates does not overlap
+    // v[i]; only in that (rare) case do we need to look further
+    std::size_t num = 0;
+    for(std::size_t i = 0; i < v.size(); i++) {
+      std::size_t j = first[i];
+      if(j == i) continue;
+      if(duplicateOf[j] != j) j = hash.first(i, &duplicateOf);
+      if(j == i) continue;
+      duplicateOf[i] = j;
+      num++;
+    }
+    return num;
+  }
+
+} // namespace
+
+std::size_t MVertexRTree::findDuplicates(const std::vector<MVertex *> &v,
+                                         double tolerance,
+                                         std::vector<MVertex *> &duplicateOf)
+{
+  std::vector<std::size_t> index;
+  std::size_t num = findDuplicateIndices(v, tolerance, index);
+  duplicateOf.assign(v.size(), 0);
+  for(std::size_t i = 0; i < v.size(); i++)
+    if(index[i] != i) duplicateOf[i] = v[index[i]];
+  return num;
+}
+
+std::size_t MVertexRTree::findDuplicates(const std::vector<SPoint3> &p,
+                                         double tolerance,
+                                         std::vector<std::size_t> &duplicateOf)
+{
+  return findDuplicateIndices(p, tolerance, duplicateOf);
+}
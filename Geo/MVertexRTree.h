@@ -9,6 +9,7 @@
 #include <vector>
 #include "GmshMessage.h"
 #include "MVertex.h"
+#include "SPoint3.h"
 #include "rtree.h"
 
 // Stores MVertex pointers in an R-Tree so we can query unique vertices by their
@@ -50,12 +51,7 @@ public:
         duplicates->insert(out);
         duplicates->insert(v);
       }
-      if(warnIfExists) {
-        Msg::Warning("Vertex %d (%.16g, %.16g, %.16g) already exists in the "
-                     "mesh with tolerance %g: Vertex %d (%.16g, %.16g, %.16g)",
-                     v->getNum(), v->x(), v->y(), v->z(), _tol, out->getNum(),
-                     out->x(), out->y(), out->z());
-      }
+      if(warnIfExists) warnDuplicate(v, out, _tol);
       return out;
     }
   }
@@ -76,6 +72,30 @@ public:
     return 0;
   }
   std::size_t size() { return _rtree->Count(); }
+  // warn that vertex v is a duplicate of vertex out, with the given tolerance
+  static void warnDuplicate(MVertex *v, MVertex *out, double tolerance)
+  {
+    Msg::Warning("Vertex %d (%.16g, %.16g, %.16g) already exists in the "
+                 "mesh with tolerance %g: Vertex %d (%.16g, %.16g, %.16g)",
+                 v->getNum(), v->x(), v->y(), v->z(), tolerance, out->getNum(),
+                 out->x(), out->y(), out->z());
+  }
+  // bulk version of insert(): for each vertex v[i], in order, set
+  // duplicateOf[i] to the first vertex v[j], j < i, that is not itself a
+  // duplicate and that would be found by insert(v[i]) (i.e. whose coordinates
+  // are within 2 * tolerance of those of v[i]), or to 0 if there is none. The
+  // set of duplicates is thus the same as when inserting the vertices one at a
+  // time, but the search is performed in parallel using a spatial hash instead
+  // of an R-tree. Return the number of duplicates.
+  static std::size_t findDuplicates(const std::vector<MVertex *> &v,
+                                    double tolerance,
+                                    std::vector<MVertex *> &duplicateOf);
+  // same as above, for bare points (e.g. before any MVertex is created):
+  // duplicateOf[i] is the index j of the point duplicated by p[i], or i if
+  // p[i] is not a duplicate
+  static std::size_t findDuplicates(const std::vector<SPoint3> &p,
+                                    double tolerance,
+                                    std::vector<std::size_t> &duplicateOf);
 };
 
 #endif
@@ -0,0 +1,91 @@
+// Gmsh - Copyright (C) 1997-2020 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
+
+#include <algorithm>
+#include "SBoundingBoxTree.h"
+
+class centerLessThan {
+private:
+  const std::vector<double> &_centers;
+  int _axis;
+
+public:
+  centerLessThan(const std::vector<double> &centers, int axis)
+    : _centers(centers), _axis(axis)
+  {
+  }
+  bool operator()(std::size_t a, std::size_t b) const
+  {
+    return _centers[3 * a + _axis] < _centers[3 * b + _axis];
+  }
+};
+
+void SBoundingBoxTree::clear()
+{
+  _nodes.clear();
+  _items.clear();
+  _numItems = 0;
+}
+
+void SBoundingBoxTree::build(const std::vector<SBoundingBox3d> &boxes,
+                             int leafSize)
+{
+  clear();
+  std::vector<double> centers(3 * boxes.size());
+  for(std::size_t i = 0; i < boxes.size(); i++) {
+    if(boxes[i].min().x() > boxes[i].max().x()) continue; // empty box
+    SPoint3 c = boxes[i].center();
+    for(int k = 0; k < 3; k++) centers[3 * i + k] = c[k];
+    _items.push_back(i);
+  }
+  _numItems = _items.size();
+  if(_items.empty()) return;
+  _nodes.reserve(2 * (_items.size() / std::max(1, leafSize)) + 1);
+  _build(boxes, centers, 0, _items.size(), std::max(1, leafSize));
+}
+
+void SBoundingBoxTree::_build(const std::vector<SBoundingBox3d> &boxes,
+                              std::vector<double> &centers, std::size_t begin,
+                              std::size_t end, std::size_t leafSize)
+{
+  std::size_t index = _nodes.size();
+  _nodes.push_back(node());
+  node &n = _nodes.back();
+  double cmin[3], cmax[3];
+  for(int k = 0; k < 3; k++) {
+    n.min[k] = cmin[k] = 1.e300;
+    n.max[k] = cmax[k] = -1.e300;
+  }
+  for(std::size_t i = begin; i < end; i++) {
+    const SBoundingBox3d &b = boxes[_items[i]];
+    for(int k = 0; k < 3; k++) {
+      n.min[k] = std::min(n.min[k], b.min()[k]);
+      n.max[k] = std::max(n.max[k], b.max()[k]);
+      double c = centers[3 * _items[i] + k];
+      cmin[k] = std::min(cmin[k], c);
+      cmax[k] = std::max(cmax[k], c);
+    }
+  }
+  if(end - begin <= leafSize) {
+    n.first = begin;
+    n.num = end - begin;
+    return;
+  }
+  n.num = 0;
+
+  // split at the median of the centers along the largest extent
+  int axis = 0;
+  for(int k = 1; k < 3; k++)
+    if(cmax[k] - cmin[k] > cmax[axis] - cmin[axis]) axis = k;
+  std::size_t mid = begin + (end - begin) / 2;
+  std::nth_element(_items.begin() + begin, _items.begin() + mid,
+                   _items.begin() + end, centerLessThan(centers, axis));
+
+  // n is invalidated by the recursive calls
+  _build(boxes, centers, begin, mid, leafSize);
+  std::size_t right = _nodes.size();
+  _nodes[index].first = right;
+  _build(boxes, centers, mid, end, leafSize);
+}
@@ -0,0 +1,134 @@
+// Gmsh - Copyright (C) 1997-2020 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
+
+#ifndef SBOUNDING_BOX_TREE_H
+#define SBOUNDING_BOX_TREE_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "SBoundingBox3d.h"
+
+// A bounding volume hierarchy over a set of axis-aligned bounding boxes (e.g.
+// of mesh elements), stored in flat arrays. Items are identified by their
+// index in the vector of boxes given to build(). All the queries are const and
+// can thus be performed concurrently.
+class SBoundingBoxTree {
+private:
+  // nodes are stored depth-first: the left child of an internal node
+  // immediately follows it, and "first" is the index of its right child; for
+  // leaves, "first" is the index in _items of the first item and "num" the
+  // number of items (num == 0 for internal nodes)
+  struct node {
+    double min[3], max[3];
+    std::size_t first;
+    std::size_t num;
+  };
+  std::vector<node> _nodes;
+  std::vector<std::size_t> _items;
+  std::size_t _numItems;
+  void _build(const std::vector<SBoundingBox3d> &boxes,
+              std::vector<double> &centers, std::size_t begin,
+              std::size_t end, std::size_t leafSize);
+  static double _distance2(const node &n, const double xyz[3])
+  {
+    double d2 = 0.;
+    for(int k = 0; k < 3; k++) {
+      double d = 0.;
+      if(xyz[k] < n.min[k])
+        d = n.min[k] - xyz[k];
+      else if(xyz[k] > n.max[k])
+        d = xyz[k] - n.max[k];
+      d2 += d * d;
+    }
+    return d2;
+  }
+  static bool _inside(const node &n, const double xyz[3])
+  {
+    return xyz[0] >= n.min[0] && xyz[0] <= n.max[0] && xyz[1] >= n.min[1] &&
+           xyz[1] <= n.max[1] && xyz[2] >= n.min[2] && xyz[2] <= n.max[2];
+  }
+
+public:
+  SBoundingBoxTree() : _numItems(0) {}
+  // build the tree, with at most leafSize items per leaf; empty boxes are
+  // ignored
+  void build(const std::vector<SBoundingBox3d> &boxes, int leafSize = 4);
+  void clear();
+  bool empty() const { return _numItems == 0; }
+  std::size_t size() const { return _numItems; }
+
+  // call visit(i) for each item i whose box contains the point, until visit
+  // returns true; return true if the search was stopped that way
+  template <class Visitor>
+  bool search(const double xyz[3], Visitor &visit) const
+  {
+    if(_nodes.empty()) return false;
+    std::size_t stack[128];
+    int n = 0;
+    stack[n++] = 0;
+    while(n) {
+      std::size_t i = stack[--n];
+      const node &nd = _nodes[i];
+      if(!_inside(nd, xyz)) continue;
+      if(nd.num) {
+        for(std::size_t j = nd.first; j < nd.first + nd.num; j++)
+          if(visit(_items[j])) return true;
+      }
+      else {
+        stack[n++] = nd.first;
+        stack[n++] = i + 1;
+      }
+    }
+    return false;
+  }
+
+  // find the item closest to the point, as measured by distance(i, xyz),
+  // which should never be smaller than the distance from xyz to the box of
+  // item i; set d to the distance to that item. Return false if the tree is
+  // empty
+  template <class Distance>
+  bool nearest(const double xyz[3], const Distance &distance,
+               std::size_t &best, double &d) const
+  {
+    best = 0;
+    d = 1.e300;
+    if(_nodes.empty()) return false;
+    std::pair<double, std::size_t> stack[128];
+    int n = 0;
+    stack[n++] = std::make_pair(_distance2(_nodes[0], xyz), (std::size_t)0);
+    while(n) {
+      std::pair<double, std::size_t> top = stack[--n];
+      if(top.first >= d * d) continue;
+      const node &nd = _nodes[top.second];
+      if(nd.num) {
+        for(std::size_t j = nd.first; j < nd.first + nd.num; j++) {
+          double dj = distance(_items[j], xyz);
+          if(dj < d) {
+            d = dj;
+            best = _items[j];
+          }
+        }
+      }
+      else {
+        // visit the closest child first
+        std::size_t l = top.second + 1, r = nd.first;
+        double dl = _distance2(_nodes[l], xyz);
+        double dr = _distance2(_nodes[r], xyz);
+        if(dl < dr) {
+          stack[n++] = std::make_pair(dr, r);
+          stack[n++] = std::make_pair(dl, l);
+        }
+        else {
+          stack[n++] = std::make_pair(dl, l);
+          stack[n++] = std::make_pair(dr, r);
+        }
+      }
+    }
+    return true;
+  }
+};
+
+#endif
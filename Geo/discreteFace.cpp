@@ -428,16 +428,23 @@ void discreteFace::_debugParametrization(bool uv)
 }
 
 int discreteFace::createGeometry()
+{
+  computeParametrization();
+  createGeometryFromParametrization();
+  return 0;
+}
+
+void discreteFace::computeParametrization()
 {
   stl_vertices_uv.clear();
   stl_vertices_xyz.clear();
   stl_curvatures.clear();
   stl_triangles.clear();
-  if(triangles.empty()) return 0;
+  if(triangles.empty()) return;
 
   std::vector<MVertex *> nodes;
-  computeParametrization(triangles, nodes,
-                         stl_vertices_uv, stl_vertices_xyz, stl_triangles);
+  ::computeParametrization(triangles, nodes, stl_vertices_uv, stl_vertices_xyz,
+                           stl_triangles);
 
   if(model()->getCurvatures().size()) {
     stl_curvatures.resize(2 * nodes.size());
@@ -455,11 +462,13 @@ int discreteFace::createGeometry()
   }
 
   _computeSTLNormals();
+}
+
+void discreteFace::createGeometryFromParametrization()
+{
   _createGeometryFromSTL();
 
   //_debugParametrization(false);
-
-  return 0;
 }
 
 void discreteFace::_computeSTLNormals()
@@ -58,6 +58,12 @@ public:
   virtual void secondDer(const SPoint2 &param, SVector3 &dudu, SVector3 &dvdv,
                          SVector3 &dudv) const;
   int createGeometry();
+  // compute the parametrization of the mesh (the stl_* data), without modifying
+  // the model: this can be done concurrently for several surfaces
+  void computeParametrization();
+  // create the geometry from the parametrization (this creates mesh nodes and
+  // elements, and must thus be done serially)
+  void createGeometryFromParametrization();
   virtual bool haveParametrization() { return !_param.empty(); }
   virtual void mesh(bool verbose);
   int trianglePosition(double par1, double par2, double &u, double &v) const;
@@ -239,7 +239,7 @@ std::vector<BDS_Face *> BDS_Point::getTriangles() const
   std::vector<BDS_Face *> t;
   t.reserve(edges.size());
 
-  std::vector<BDS_Edge *>::const_iterator it = edges.begin();
+  edgeContainer::const_iterator it = edges.begin();
   while(it != edges.end()) {
     std::size_t const number_of_faces = (*it)->numfaces();
 
@@ -254,10 +254,25 @@ std::vector<BDS_Face *> BDS_Point::getTriangles() const
   return t;
 }
 
+BDS_Point *BDS_Mesh::_newPoint(int num, double x, double y, double z)
+{
+  return new(_pointPool.slot()) BDS_Point(num, x, y, z);
+}
+
+BDS_Edge *BDS_Mesh::_newEdge(BDS_Point *p1, BDS_Point *p2)
+{
+  return new(_edgePool.slot()) BDS_Edge(p1, p2);
+}
+
+BDS_Face *BDS_Mesh::_newFace(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3)
+{
+  return new(_facePool.slot()) BDS_Face(e1, e2, e3);
+}
+
 BDS_Point *BDS_Mesh::add_point(int const num, double const x, double const y,
                                double const z)
 {
-  BDS_Point *pp = new BDS_Point(num, x, y, z);
+  BDS_Point *pp = _newPoint(num, x, y, z);
   points.insert(pp);
   MAXPOINTNUMBER = std::max(MAXPOINTNUMBER, num);
   return pp;
@@ -266,7 +281,7 @@ BDS_Point *BDS_Mesh::add_point(int const num, double const x, double const y,
 BDS_Point *BDS_Mesh::add_point(int num, double u, double v, GFace *gf)
 {
   GPoint gp = gf->point(u, v);
-  BDS_Point *pp = new BDS_Point(num, gp.x(), gp.y(), gp.z());
+  BDS_Point *pp = _newPoint(num, gp.x(), gp.y(), gp.z());
   pp->u = u;
   pp->v = v;
   points.insert(pp);
@@ -284,7 +299,7 @@ BDS_Point *BDS_Mesh::find_point(int p)
 
 BDS_Edge *BDS_Mesh::find_edge(BDS_Point *p, int num2)
 {
-  std::vector<BDS_Edge *>::iterator eit = p->edges.begin();
+  BDS_Point::edgeContainer::iterator eit = p->edges.begin();
   while(eit != p->edges.end()) {
     if((*eit)->p1 == p && (*eit)->p2->iD == num2) return (*eit);
     if((*eit)->p2 == p && (*eit)->p1->iD == num2) return (*eit);
@@ -490,7 +505,7 @@ BDS_Edge *BDS_Mesh::add_edge(int const p1, int const p2)
     Msg::Error("Could not find points %d or %d", p1, p2);
     return 0;
   }
-  edges.push_back(new BDS_Edge(pp1, pp2));
+  edges.push_back(_newEdge(pp1, pp2));
 
   return edges.back();
 }
@@ -507,7 +522,7 @@ BDS_Face *BDS_Mesh::add_triangle(int p1, int p2, int p3)
 BDS_Face *BDS_Mesh::add_triangle(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3)
 {
   if(e1 && e2 && e3) {
-    BDS_Face *t = new BDS_Face(e1, e2, e3);
+    BDS_Face *t = _newFace(e1, e2, e3);
     triangles.push_back(t);
     return t;
   }
@@ -535,7 +550,7 @@ void BDS_Mesh::del_edge(BDS_Edge *e)
 void BDS_Mesh::del_point(BDS_Point *p)
 {
   if(!p) return;
-  if(points.erase(p)) delete p;
+  if(points.erase(p)) _pointPool.release(p);
 }
 
 void BDS_Mesh::add_geom(int p1, int p2)
@@ -638,6 +653,15 @@ template <class IT> void DESTROOOY(IT beg, IT end)
   }
 }
 
+template <class IT, class T>
+void DESTROOOY(IT beg, IT end, BDS_Pool<T> &pool)
+{
+  while(beg != end) {
+    pool.release(*beg);
+    beg++;
+  }
+}
+
 struct is_not_deleted {
   template <class T> bool operator()(T *const face) { return !face->deleted; }
 };
@@ -649,7 +673,7 @@ void BDS_Mesh::cleanup()
       std::partition(triangles.begin(), triangles.end(), is_not_deleted());
     std::vector<BDS_Face *>::iterator it = last;
     while(it != triangles.end()) {
-      delete *it;
+      _facePool.release(*it);
       ++it;
     }
     triangles.erase(last, triangles.end());
@@ -659,7 +683,7 @@ void BDS_Mesh::cleanup()
       std::partition(edges.begin(), edges.end(), is_not_deleted());
     std::vector<BDS_Edge *>::iterator it = last;
     while(it != edges.end()) {
-      delete *it;
+      _edgePool.release(*it);
       ++it;
     }
     edges.erase(last, edges.end());
@@ -669,10 +693,10 @@ void BDS_Mesh::cleanup()
 BDS_Mesh::~BDS_Mesh()
 {
   DESTROOOY(geom.begin(), geom.end());
-  DESTROOOY(points.begin(), points.end());
+  DESTROOOY(points.begin(), points.end(), _pointPool);
   cleanup();
-  DESTROOOY(edges.begin(), edges.end());
-  DESTROOOY(triangles.begin(), triangles.end());
+  DESTROOOY(edges.begin(), edges.end(), _edgePool);
+  DESTROOOY(triangles.begin(), triangles.end(), _facePool);
 }
 
 bool BDS_Mesh::split_edge(BDS_Edge *e, BDS_Point *mid, bool check_area_param)
@@ -748,27 +772,27 @@ bool BDS_Mesh::split_edge(BDS_Edge *e, BDS_Point *mid, bool check_area_param)
 
   del_edge(e);
 
-  BDS_Edge *p1_mid = new BDS_Edge(p1, mid);
+  BDS_Edge *p1_mid = _newEdge(p1, mid);
   edges.push_back(p1_mid);
-  BDS_Edge *mid_p2 = new BDS_Edge(mid, p2);
+  BDS_Edge *mid_p2 = _newEdge(mid, p2);
   edges.push_back(mid_p2);
-  BDS_Edge *op1_mid = new BDS_Edge(op[0], mid);
+  BDS_Edge *op1_mid = _newEdge(op[0], mid);
   edges.push_back(op1_mid);
-  BDS_Edge *mid_op2 = new BDS_Edge(mid, op[1]);
+  BDS_Edge *mid_op2 = _newEdge(mid, op[1]);
   edges.push_back(mid_op2);
 
   BDS_Face *t1, *t2, *t3, *t4;
   if(orientation == 1) {
-    t1 = new BDS_Face(op1_mid, p1_op1, p1_mid);
-    t2 = new BDS_Face(mid_op2, op2_p2, mid_p2);
-    t3 = new BDS_Face(op1_p2, op1_mid, mid_p2);
-    t4 = new BDS_Face(p1_op2, mid_op2, p1_mid);
+    t1 = _newFace(op1_mid, p1_op1, p1_mid);
+    t2 = _newFace(mid_op2, op2_p2, mid_p2);
+    t3 = _newFace(op1_p2, op1_mid, mid_p2);
+    t4 = _newFace(p1_op2, mid_op2, p1_mid);
   }
   else {
-    t1 = new BDS_Face(p1_op1, op1_mid, p1_mid);
-    t2 = new BDS_Face(op2_p2, mid_op2, mid_p2);
-    t3 = new BDS_Face(op1_mid, op1_p2, mid_p2);
-    t4 = new BDS_Face(mid_op2, p1_op2, p1_mid);
+    t1 = _newFace(p1_op1, op1_mid, p1_mid);
+    t2 = _newFace(op2_p2, mid_op2, mid_p2);
+    t3 = _newFace(op1_mid, op1_p2, mid_p2);
+    t4 = _newFace(mid_op2, p1_op2, p1_mid);
   }
   t1->g = g1;
   t2->g = g2;
@@ -1024,16 +1048,16 @@ bool BDS_Mesh::swap_edge(BDS_Edge *e, const BDS_SwapEdgeTest &theTest,
   }
   del_edge(e);
 
-  edges.push_back(new BDS_Edge(op[0], op[1]));
+  edges.push_back(_newEdge(op[0], op[1]));
 
   BDS_Face *t1, *t2;
   if(orientation == 1) {
-    t1 = new BDS_Face(p1_op1, p1_op2, edges.back());
-    t2 = new BDS_Face(edges.back(), op2_p2, op1_p2);
+    t1 = _newFace(p1_op1, p1_op2, edges.back());
+    t2 = _newFace(edges.back(), op2_p2, op1_p2);
   }
   else {
-    t1 = new BDS_Face(p1_op2, p1_op1, edges.back());
-    t2 = new BDS_Face(op2_p2, edges.back(), op1_p2);
+    t1 = _newFace(p1_op2, p1_op1, edges.back());
+    t2 = _newFace(op2_p2, edges.back(), op1_p2);
   }
 
   t1->g = g1;
@@ -1055,7 +1079,7 @@ bool BDS_Mesh::swap_edge(BDS_Edge *e, const BDS_SwapEdgeTest &theTest,
 int BDS_Edge::numTriangles() const
 {
   return std::count_if(
-    begin(_faces), end(_faces),
+    _faces.begin(), _faces.end(),
     [](const BDS_Face *const face) { return face->numEdges() == 3; });
 }
 
@@ -1188,7 +1212,7 @@ bool BDS_Mesh::collapse_edge_parametric(BDS_Edge *e, BDS_Point *p, bool force)
 
   int kk = 0;
   {
-    std::vector<BDS_Edge *> edges(p->edges);
+    std::vector<BDS_Edge *> edges(p->edges.begin(), p->edges.end());
     std::vector<BDS_Edge *>::iterator eit = edges.begin();
     while(eit != edges.end()) {
       (*eit)->p1->config_modified = (*eit)->p2->config_modified = true;
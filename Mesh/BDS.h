@@ -28,6 +28,69 @@ class GFace;
 class GEdge;
 class GVertex;
 
+// Small array of pointers, for the adjacency of BDS entities: the first N
+// entries are stored inline, so that the adjacency of most points (about 6
+// edges) and edges (2 faces) is stored within the entity itself, without any
+// allocation; larger arrays are moved to the heap.
+template <class T, std::size_t N> class BDS_SmallArray {
+private:
+  T *_data;
+  std::size_t _size, _capacity;
+  T _inline[N];
+  void _reserve(std::size_t n)
+  {
+    if(n <= _capacity) return;
+    T *data = new T[n];
+    std::copy(_data, _data + _size, data);
+    if(_data != _inline) delete[] _data;
+    _data = data;
+    _capacity = n;
+  }
+
+public:
+  typedef T *iterator;
+  typedef const T *const_iterator;
+  BDS_SmallArray() : _data(_inline), _size(0), _capacity(N) {}
+  BDS_SmallArray(const BDS_SmallArray &other)
+    : _data(_inline), _size(0), _capacity(N)
+  {
+    *this = other;
+  }
+  ~BDS_SmallArray()
+  {
+    if(_data != _inline) delete[] _data;
+  }
+  BDS_SmallArray &operator=(const BDS_SmallArray &other)
+  {
+    if(this != &other) {
+      _reserve(other._size);
+      std::copy(other._data, other._data + other._size, _data);
+      _size = other._size;
+    }
+    return *this;
+  }
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  T &operator[](std::size_t i) { return _data[i]; }
+  const T &operator[](std::size_t i) const { return _data[i]; }
+  iterator begin() { return _data; }
+  iterator end() { return _data + _size; }
+  const_iterator begin() const { return _data; }
+  const_iterator end() const { return _data + _size; }
+  void push_back(const T &t)
+  {
+    if(_size == _capacity) _reserve(2 * _capacity);
+    _data[_size++] = t;
+  }
+  // remove the entries in [first, last)
+  iterator erase(iterator first, iterator last)
+  {
+    std::copy(last, end(), first);
+    _size -= last - first;
+    return first;
+  }
+};
+
 class BDS_GeomEntity {
 public:
   int classif_tag;
@@ -60,7 +123,8 @@ public:
   BDS_Point *_periodicCounterpart;
   int iD;
   BDS_GeomEntity *g;
-  std::vector<BDS_Edge *> edges;
+  typedef BDS_SmallArray<BDS_Edge *, 8> edgeContainer;
+  edgeContainer edges;
 
   double &lcBGM() { return _lcBGM; }
   double &lc() { return _lcPTS; }
@@ -83,7 +147,7 @@ public:
 };
 
 class BDS_Edge {
-  std::vector<BDS_Face *> _faces;
+  BDS_SmallArray<BDS_Face *, 2> _faces;
 
 public:
   BDS_Edge(BDS_Point *A, BDS_Point *B) : deleted(false), g(0)
@@ -335,7 +399,62 @@ struct EdgeToRecover {
   }
 };
 
+// Pool of BDS entities (points, edges or faces), allocated in contiguous
+// blocks: entities are constructed in place in free slots, and the slots of
+// released entities are recycled.
+template <class T> class BDS_Pool {
+private:
+  std::vector<T *> _blocks;
+  std::vector<T *> _free;
+  std::size_t _numSlots;
+  static const std::size_t _blockSize = 1024;
+  BDS_Pool(const BDS_Pool &);
+  BDS_Pool &operator=(const BDS_Pool &);
+
+public:
+  BDS_Pool() : _numSlots(0) {}
+  ~BDS_Pool() { clear(); }
+  // a free slot, in which an entity should be constructed with placement new
+  void *slot()
+  {
+    if(_free.size()) {
+      T *t = _free.back();
+      _free.pop_back();
+      return t;
+    }
+    if(_numSlots == _blocks.size() * _blockSize)
+      _blocks.push_back(
+        static_cast<T *>(::operator new(_blockSize * sizeof(T))));
+    T *t = _blocks[_numSlots / _blockSize] + _numSlots % _blockSize;
+    _numSlots++;
+    return t;
+  }
+  void release(T *t)
+  {
+    t->~T();
+    _free.push_back(t);
+  }
+  // free the memory of the pool; all the entities should have been released
+  void clear()
+  {
+    for(std::size_t i = 0; i < _blocks.size(); i++)
+      ::operator delete(_blocks[i]);
+    _blocks.clear();
+    _free.clear();
+    _numSlots = 0;
+  }
+};
+
 class BDS_Mesh {
+private:
+  // points, edges and faces are allocated in (and owned by) these pools
+  BDS_Pool<BDS_Point> _pointPool;
+  BDS_Pool<BDS_Edge> _edgePool;
+  BDS_Pool<BDS_Face> _facePool;
+  BDS_Point *_newPoint(int num, double x, double y, double z);
+  BDS_Edge *_newEdge(BDS_Point *p1, BDS_Point *p2);
+  BDS_Face *_newFace(BDS_Edge *e1, BDS_Edge *e2, BDS_Edge *e3);
+
 public:
   int MAXPOINTNUMBER;
   double Min[3], Max[3], LC;
@@ -247,6 +247,47 @@ double BGM_MeshSizeWithoutScaling(GEntity *ge, double U, double V, double X,
   return lc;
 }
 
+// Same as above for n points inside a volume (i.e. without parametric
+// coordinates) with coordinates xyz[3 * i + 0..2], with the background field
+// evaluated in batch
+void BGM_MeshSizeWithoutScaling(GEntity *ge, std::size_t n, const double *xyz,
+                                double *lc)
+{
+  if(ge && ge->dim() < 3) {
+    for(std::size_t i = 0; i < n; i++)
+      lc[i] = BGM_MeshSizeWithoutScaling(ge, 0, 0, xyz[3 * i], xyz[3 * i + 1],
+                                         xyz[3 * i + 2]);
+    return;
+  }
+
+  // global lc from entity
+  double l4 = ge ? ge->getMeshSize() : MAX_LC;
+  for(std::size_t i = 0; i < n; i++) lc[i] = l4;
+
+  // lc from fields
+  if(ge) {
+    FieldManager *fields = ge->model()->getFields();
+    if(fields->getBackgroundField() > 0) {
+      Field *f = fields->get(fields->getBackgroundField());
+      if(f) {
+        std::vector<double> l3(n);
+        if(n) f->evaluate(xyz, n, &l3[0], ge);
+        for(std::size_t i = 0; i < n; i++) lc[i] = std::min(lc[i], l3[i]);
+      }
+    }
+  }
+
+  // lc from callback
+  if(CTX::instance()->mesh.lcCallback) {
+    int dim = (ge ? ge->dim() : -1);
+    int tag = (ge ? ge->tag() : -1);
+    for(std::size_t i = 0; i < n; i++)
+      lc[i] = std::min(lc[i], CTX::instance()->mesh.lcCallback(
+                                dim, tag, xyz[3 * i], xyz[3 * i + 1],
+                                xyz[3 * i + 2]));
+  }
+}
+
 // This is the only function that is used by the meshers
 double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
                     double Z)
@@ -6,6 +6,7 @@
 #ifndef BACKGROUND_MESH_TOOLS_H
 #define BACKGROUND_MESH_TOOLS_H
 
+#include <cstddef>
 #include "STensor3.h"
 
 class GFace;
@@ -20,6 +21,8 @@ double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
                     double Z);
 double BGM_MeshSizeWithoutScaling(GEntity *ge, double U, double V, double X,
                                   double Y, double Z);
+void BGM_MeshSizeWithoutScaling(GEntity *ge, std::size_t n, const double *xyz,
+                                double *lc);
 SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
                         double Z);
 bool Extend1dMeshIn2dSurfaces(GFace *gf);
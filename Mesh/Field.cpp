@@ -45,10 +45,6 @@
 #include <unistd.h>
 #endif
 
-#if defined(HAVE_ANN)
-#include "ANN/ANN.h"
-#endif
-
 Field::~Field()
 {
   for(std::map<std::string, FieldOption *>::iterator it = options.begin();
@@ -59,6 +55,13 @@ Field::~Field()
     delete it->second;
 }
 
+void Field::evaluate(const double *xyz, std::size_t n, double *val,
+                     GEntity *ge)
+{
+  for(std::size_t i = 0; i < n; i++)
+    val[i] = (*this)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ge);
+}
+
 FieldOption *Field::getOption(const std::string &optionName)
 {
   std::map<std::string, FieldOption *>::iterator it = options.find(optionName);
@@ -75,6 +78,7 @@ void FieldManager::reset()
     delete it->second;
   }
   clear();
+  _version++;
 }
 
 Field *FieldManager::get(int id)
@@ -98,6 +102,7 @@ Field *FieldManager::newField(int id, const std::string &type_name)
   if(!f) return 0;
   f->id = id;
   (*this)[id] = f;
+  _version++;
   return f;
 }
 
@@ -130,6 +135,7 @@ void FieldManager::deleteField(int id)
   }
   delete it->second;
   erase(it);
+  _version++;
 }
 
 // StructuredField
@@ -662,7 +668,24 @@ public:
   {
     Field *field = GModel::current()->getFields()->get(_inField);
     if(!field || _inField == id) return MAX_LC;
-    double r = ((*field)(x, y, z) - _dMin) / (_dMax - _dMin);
+    return _size((*field)(x, y, z));
+  }
+  void evaluate(const double *xyz, std::size_t n, double *val,
+                GEntity *ge = 0)
+  {
+    Field *field = GModel::current()->getFields()->get(_inField);
+    if(!field || _inField == id) {
+      std::fill(val, val + n, MAX_LC);
+      return;
+    }
+    field->evaluate(xyz, n, val);
+    for(std::size_t i = 0; i < n; i++) val[i] = _size(val[i]);
+  }
+
+private:
+  double _size(double d) const
+  {
+    double r = (d - _dMin) / (_dMax - _dMin);
     r = std::max(std::min(r, 1.), 0.);
     double lc;
     if(_stopAtDistMax && r >= 1.) { lc = MAX_LC; }
@@ -924,13 +947,43 @@ public:
   }
 };
 
+// A mathematical expression of x, y, z and of the values of other fields
+// F0, F1, ... The expression is compiled once by set_function(); evaluate()
+// is then reentrant, and does not allocate memory for single points.
 class MathEvalExpression {
 private:
   mathEvaluator *_f;
-  std::set<int> _fields;
+  std::vector<int> _fields;
+  // pointers to the fields appearing in the expression, resolved in the field
+  // manager _manager when its version was _version (both are published with
+  // release semantics once the pointers are set, so that the fast path of
+  // _resolveFields() does not lock)
+  std::vector<Field *> _fieldPointers;
+  std::atomic<FieldManager *> _manager;
+  std::atomic<int> _version;
+  void _resolveFields()
+  {
+    FieldManager *manager = GModel::current()->getFields();
+    if(_manager.load(std::memory_order_acquire) == manager &&
+       _version.load(std::memory_order_acquire) == manager->getVersion())
+      return;
+#if defined(_OPENMP)
+#pragma omp critical(MathEvalExpressionFields)
+#endif
+    {
+      if(_manager.load(std::memory_order_relaxed) != manager ||
+         _version.load(std::memory_order_relaxed) != manager->getVersion()) {
+        _fieldPointers.resize(_fields.size());
+        for(std::size_t i = 0; i < _fields.size(); i++)
+          _fieldPointers[i] = manager->get(_fields[i]);
+        _version.store(manager->getVersion(), std::memory_order_release);
+        _manager.store(manager, std::memory_order_release);
+      }
+    }
+  }
 
 public:
-  MathEvalExpression() : _f(0) {}
+  MathEvalExpression() : _f(0), _manager(0), _version(0) {}
   ~MathEvalExpression()
   {
     if(_f) delete _f;
@@ -938,7 +991,7 @@ public:
   bool set_function(const std::string &f)
   {
     // get id numbers of fields appearing in the function
-    _fields.clear();
+    std::set<int> fields;
     std::size_t i = 0;
     while(i < f.size()) {
       std::size_t j = 0;
@@ -949,21 +1002,21 @@ public:
           id += f[i + 1 + j];
           j++;
         }
-        _fields.insert(atoi(id.c_str()));
+        fields.insert(atoi(id.c_str()));
       }
       i += j + 1;
     }
+    _fields.assign(fields.begin(), fields.end());
+    _manager = 0;
     std::vector<std::string> expressions(1), variables(3 + _fields.size());
     expressions[0] = f;
     variables[0] = "x";
     variables[1] = "y";
     variables[2] = "z";
-    i = 3;
-    for(std::set<int>::iterator it = _fields.begin(); it != _fields.end();
-        it++) {
+    for(i = 0; i < _fields.size(); i++) {
       std::ostringstream sstream;
-      sstream << "F" << *it;
-      variables[i++] = sstream.str();
+      sstream << "F" << _fields[i];
+      variables[3 + i] = sstream.str();
     }
     if(_f) delete _f;
     _f = new mathEvaluator(expressions, variables);
@@ -977,101 +1030,71 @@ public:
   double evaluate(double x, double y, double z)
   {
     if(!_f) return MAX_LC;
-    std::vector<double> values(3 + _fields.size()), res(1);
+    _resolveFields();
+    double buffer[32], res;
+    std::vector<double> tmp;
+    double *values = buffer;
+    if(3 + _fields.size() > 32) {
+      tmp.resize(3 + _fields.size());
+      values = &tmp[0];
+    }
     values[0] = x;
     values[1] = y;
     values[2] = z;
-    int i = 3;
-    for(std::set<int>::iterator it = _fields.begin(); it != _fields.end();
-        it++) {
-      Field *field = GModel::current()->getFields()->get(*it);
-      values[i++] = field ? (*field)(x, y, z) : MAX_LC;
+    for(std::size_t i = 0; i < _fields.size(); i++) {
+      Field *field = _fieldPointers[i];
+      values[3 + i] = field ? (*field)(x, y, z) : MAX_LC;
     }
-    if(_f->eval(values, res))
-      return res[0];
+    if(_f->eval(values, &res))
+      return res;
     else
       return MAX_LC;
   }
+  // evaluate at n points: the fields appearing in the function are evaluated
+  // in batch beforehand, and the expression is then evaluated for all the
+  // points at once
+  void evaluate(const double *xyz, std::size_t n, double *val)
+  {
+    if(!n) return;
+    if(!_f) {
+      std::fill(val, val + n, MAX_LC);
+      return;
+    }
+    _resolveFields();
+    std::size_t nv = 3 + _fields.size();
+    std::vector<double> values(nv * n, MAX_LC);
+    for(std::size_t i = 0; i < n; i++)
+      for(int k = 0; k < 3; k++) values[k * n + i] = xyz[3 * i + k];
+    for(std::size_t j = 0; j < _fields.size(); j++) {
+      Field *field = _fieldPointers[j];
+      if(field) field->evaluate(xyz, n, &values[(3 + j) * n]);
+    }
+    if(_f->eval(&values[0], n, val)) return;
+    // the evaluation failed for some points: evaluate them one at a time
+    std::vector<double> v(nv);
+    for(std::size_t i = 0; i < n; i++) {
+      for(std::size_t j = 0; j < nv; j++) v[j] = values[j * n + i];
+      double res;
+      val[i] = _f->eval(&v[0], &res) ? res : MAX_LC;
+    }
+  }
 };
 
 class MathEvalExpressionAniso {
 private:
-  mathEvaluator *_f[6];
-  std::set<int> _fields[6];
+  MathEvalExpression _expr[6];
 
 public:
-  MathEvalExpressionAniso()
-  {
-    for(int i = 0; i < 6; i++) _f[i] = 0;
-  }
-  ~MathEvalExpressionAniso()
-  {
-    for(int i = 0; i < 6; i++)
-      if(_f[i]) delete _f[i];
-  }
   bool set_function(int iFunction, const std::string &f)
   {
-    // get id numbers of fields appearing in the function
-    _fields[iFunction].clear();
-    std::size_t i = 0;
-    while(i < f.size()) {
-      std::size_t j = 0;
-      if(f[i] == 'F') {
-        std::string id("");
-        while(i + 1 + j < f.size() && f[i + 1 + j] >= '0' &&
-              f[i + 1 + j] <= '9') {
-          id += f[i + 1 + j];
-          j++;
-        }
-        _fields[iFunction].insert(atoi(id.c_str()));
-      }
-      i += j + 1;
-    }
-    std::vector<std::string> expressions(1),
-      variables(3 + _fields[iFunction].size());
-    expressions[0] = f;
-    variables[0] = "x";
-    variables[1] = "y";
-    variables[2] = "z";
-    i = 3;
-    for(std::set<int>::iterator it = _fields[iFunction].begin();
-        it != _fields[iFunction].end(); it++) {
-      std::ostringstream sstream;
-      sstream << "F" << *it;
-      variables[i++] = sstream.str();
-    }
-    if(_f[iFunction]) delete _f[iFunction];
-    _f[iFunction] = new mathEvaluator(expressions, variables);
-    if(expressions.empty()) {
-      delete _f[iFunction];
-      _f[iFunction] = 0;
-      return false;
-    }
-    return true;
+    return _expr[iFunction].set_function(f);
   }
   void evaluate(double x, double y, double z, SMetric3 &metr)
   {
     const int index[6][2] = {{0, 0}, {1, 1}, {2, 2}, {0, 1}, {0, 2}, {1, 2}};
-    for(int iFunction = 0; iFunction < 6; iFunction++) {
-      if(!_f[iFunction])
-        metr(index[iFunction][0], index[iFunction][1]) = MAX_LC;
-      else {
-        std::vector<double> values(3 + _fields[iFunction].size()), res(1);
-        values[0] = x;
-        values[1] = y;
-        values[2] = z;
-        int i = 3;
-        for(std::set<int>::iterator it = _fields[iFunction].begin();
-            it != _fields[iFunction].end(); it++) {
-          Field *field = GModel::current()->getFields()->get(*it);
-          values[i++] = field ? (*field)(x, y, z) : MAX_LC;
-        }
-        if(_f[iFunction]->eval(values, res))
-          metr(index[iFunction][0], index[iFunction][1]) = res[0];
-        else
-          metr(index[iFunction][0], index[iFunction][1]) = MAX_LC;
-      }
-    }
+    for(int iFunction = 0; iFunction < 6; iFunction++)
+      metr(index[iFunction][0], index[iFunction][1]) =
+        _expr[iFunction].evaluate(x, y, z);
   }
 };
 
@@ -1079,6 +1102,22 @@ class MathEvalField : public Field {
 private:
   MathEvalExpression _expr;
   std::string _f;
+  void _update()
+  {
+    if(updateNeeded) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      {
+        if(updateNeeded) {
+          if(!_expr.set_function(_f))
+            Msg::Error("Field %i: invalid matheval expression \"%s\"",
+                       this->id, _f.c_str());
+          updateNeeded = false;
+        }
+      }
+    }
+  }
 
 public:
   MathEvalField()
@@ -1090,20 +1129,14 @@ public:
   using Field::operator();
   double operator()(double x, double y, double z, GEntity *ge = 0)
   {
-    double ret = 0;
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-    {
-      if(updateNeeded) {
-        if(!_expr.set_function(_f))
-          Msg::Error("Field %i: invalid matheval expression \"%s\"", this->id,
-                     _f.c_str());
-        updateNeeded = false;
-      }
-      ret = _expr.evaluate(x, y, z);
-    }
-    return ret;
+    _update();
+    return _expr.evaluate(x, y, z);
+  }
+  void evaluate(const double *xyz, std::size_t n, double *val,
+                GEntity *ge = 0)
+  {
+    _update();
+    _expr.evaluate(xyz, n, val);
   }
   const char *getName() { return "MathEval"; }
   std::string getDescription()
@@ -1118,6 +1151,24 @@ class MathEvalFieldAniso : public Field {
 private:
   MathEvalExpressionAniso _expr;
   std::string _f[6];
+  void _update()
+  {
+    if(updateNeeded) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      {
+        if(updateNeeded) {
+          for(int i = 0; i < 6; i++) {
+            if(!_expr.set_function(i, _f[i]))
+              Msg::Error("Field %i: invalid matheval expression \"%s\"",
+                         this->id, _f[i].c_str());
+          }
+          updateNeeded = false;
+        }
+      }
+    }
+  }
 
 public:
   virtual bool isotropic() const { return false; }
@@ -1159,38 +1210,14 @@ public:
   }
   void operator()(double x, double y, double z, SMetric3 &metr, GEntity *ge = 0)
   {
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-    {
-      if(updateNeeded) {
-        for(int i = 0; i < 6; i++) {
-          if(!_expr.set_function(i, _f[i]))
-            Msg::Error("Field %i: invalid matheval expression \"%s\"", this->id,
-                       _f[i].c_str());
-        }
-        updateNeeded = false;
-      }
-      _expr.evaluate(x, y, z, metr);
-    }
+    _update();
+    _expr.evaluate(x, y, z, metr);
   }
   double operator()(double x, double y, double z, GEntity *ge = 0)
   {
     SMetric3 metr;
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-    {
-      if(updateNeeded) {
-        for(int i = 0; i < 6; i++) {
-          if(!_expr.set_function(i, _f[i]))
-            Msg::Error("Field %i: invalid matheval expression \"%s\"", this->id,
-                       _f[i].c_str());
-        }
-        updateNeeded = false;
-      }
-      _expr.evaluate(x, y, z, metr);
-    }
+    _update();
+    _expr.evaluate(x, y, z, metr);
     return metr(0, 0);
   }
   const char *getName() { return "MathEvalAniso"; }
@@ -1473,12 +1500,19 @@ public:
   double operator()(double x, double y, double z, GEntity *ge = 0)
   {
     if(updateNeeded) {
-      for(int i = 0; i < 3; i++) {
-        if(!_expr[i].set_function(_f[i]))
-          Msg::Error("Field %i: invalid matheval expression \"%s\"", this->id,
-                     _f[i].c_str());
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      {
+        if(updateNeeded) {
+          for(int i = 0; i < 3; i++) {
+            if(!_expr[i].set_function(_f[i]))
+              Msg::Error("Field %i: invalid matheval expression \"%s\"",
+                         this->id, _f[i].c_str());
+          }
+          updateNeeded = false;
+        }
       }
-      updateNeeded = false;
     }
     Field *field = GModel::current()->getFields()->get(_inField);
     if(!field || _inField == id) return MAX_LC;
@@ -1552,9 +1586,16 @@ public:
     PView *v = getView();
     if(!v) return MAX_LC;
     if(updateNeeded) {
-      if(_octree) delete _octree;
-      _octree = new OctreePost(v);
-      updateNeeded = false;
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      {
+        if(updateNeeded) {
+          if(_octree) delete _octree;
+          _octree = new OctreePost(v);
+          updateNeeded = false;
+        }
+      }
     }
     double l = 0.;
     // use large tolerance (in element reference coordinates) to maximize chance
@@ -1569,9 +1610,16 @@ public:
     PView *v = getView();
     if(!v) return;
     if(updateNeeded) {
-      if(_octree) delete _octree;
-      _octree = new OctreePost(v);
-      updateNeeded = false;
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      {
+        if(updateNeeded) {
+          if(_octree) delete _octree;
+          _octree = new OctreePost(v);
+          updateNeeded = false;
+        }
+      }
     }
     double l[9] = {0., 0., 0., 0., 0., 0., 0., 0., 0.};
     // use large tolerance (in element reference coordinates) to maximize chance
@@ -1775,6 +1823,32 @@ public:
     }
     return v;
   }
+  void evaluate(const double *xyz, std::size_t n, double *val,
+                GEntity *ge = 0)
+  {
+    if(!n) return;
+    std::fill(val, val + n, MAX_LC);
+    std::vector<double> v(n);
+    for(std::list<int>::iterator it = _fieldIds.begin(); it != _fieldIds.end();
+        it++) {
+      Field *f = (GModel::current()->getFields()->get(*it));
+      if(f && *it != id) {
+        if(f->isotropic())
+          f->evaluate(xyz, n, &v[0], ge);
+        else {
+          for(std::size_t i = 0; i < n; i++) {
+            SMetric3 ff;
+            (*f)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ff, ge);
+            fullMatrix<double> V(3, 3);
+            fullVector<double> S(3);
+            ff.eig(V, S, 1);
+            v[i] = sqrt(1. / S(2));
+          }
+        }
+        for(std::size_t i = 0; i < n; i++) val[i] = std::min(val[i], v[i]);
+      }
+    }
+  }
   const char *getName() { return "Min"; }
 };
 
@@ -1814,6 +1888,32 @@ public:
     }
     return v;
   }
+  void evaluate(const double *xyz, std::size_t n, double *val,
+                GEntity *ge = 0)
+  {
+    if(!n) return;
+    std::fill(val, val + n, -MAX_LC);
+    std::vector<double> v(n);
+    for(std::list<int>::iterator it = _fieldIds.begin(); it != _fieldIds.end();
+        it++) {
+      Field *f = (GModel::current()->getFields()->get(*it));
+      if(f && *it != id) {
+        if(f->isotropic())
+          f->evaluate(xyz, n, &v[0], ge);
+        else {
+          for(std::size_t i = 0; i < n; i++) {
+            SMetric3 ff;
+            (*f)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ff, ge);
+            fullMatrix<double> V(3, 3);
+            fullVector<double> S(3);
+            ff.eig(V, S, 1);
+            v[i] = sqrt(1. / S(0));
+          }
+        }
+        for(std::size_t i = 0; i < n; i++) val[i] = std::max(val[i], v[i]);
+      }
+    }
+  }
   const char *getName() { return "Max"; }
 };
 
@@ -1879,24 +1979,77 @@ struct AttractorInfo {
   double u, v;
 };
 
-#if defined(HAVE_ANN)
+struct PointCloud {
+  std::vector<SPoint3> pts;
+};
+
+// And this is the "dataset to kd-tree" adaptor class:
+template <typename Derived> struct PointCloudAdaptor {
+  const Derived &obj; //!< A const ref to the data set origin
+
+  // The constructor that sets the data set source
+  PointCloudAdaptor(const Derived &obj_) : obj(obj_) {}
+
+  // CRTP helper method
+  inline const Derived &derived() const { return obj; }
+
+  // Must return the number of data points
+  inline size_t kdtree_get_point_count() const { return derived().pts.size(); }
+
+  // Returns the distance between the vector "p1[0:size-1]" and the data point
+  // with index "idx_p2" stored in the class:
+  inline double kdtree_distance(const double *p1, const size_t idx_p2,
+                                size_t /*size*/) const
+  {
+    const double d0 = p1[0] - derived().pts[idx_p2].x();
+    const double d1 = p1[1] - derived().pts[idx_p2].y();
+    const double d2 = p1[2] - derived().pts[idx_p2].z();
+    return d0 * d0 + d1 * d1 + d2 * d2;
+  }
+
+  // Returns the dim'th component of the idx'th point in the class: Since this
+  // is inlined and the "dim" argument is typically an immediate value, the
+  // "if/else's" are actually solved at compile time.
+  inline double kdtree_get_pt(const size_t idx, int dim) const
+  {
+    if(dim == 0)
+      return derived().pts[idx].x();
+    else if(dim == 1)
+      return derived().pts[idx].y();
+    else
+      return derived().pts[idx].z();
+  }
+
+  // Optional bounding-box computation: return false to default to a standard
+  // bbox computation loop.  Return true if the BBOX was already computed by the
+  // class and returned in "bb" so it can be avoided to redo it again.  Look at
+  // bb.size() to find out the expected dimensionality (e.g. 2 or 3 for point
+  // clouds)
+  template <class BBOX> bool kdtree_get_bbox(BBOX & /*bb*/) const
+  {
+    return false;
+  }
+
+}; // end of PointCloudAdaptor
+
+typedef PointCloudAdaptor<PointCloud> PC2KD;
+typedef nanoflann::KDTreeSingleIndexAdaptor<
+  nanoflann::L2_Simple_Adaptor<double, PC2KD>, PC2KD, 3>
+  my_kd_tree_t;
 
 class AttractorAnisoCurveField : public Field {
 private:
-  ANNkd_tree *_kdTree;
-  ANNpointArray _zeroNodes;
-  ANNidxArray _index;
-  ANNdistArray _dist;
+  PointCloud _zeroNodes;
+  PC2KD _pc2kd;
+  my_kd_tree_t *_kdTree;
   std::list<int> _curveTags;
   double _dMin, _dMax, _lMinTangent, _lMaxTangent, _lMinNormal, _lMaxNormal;
   int _numPointsPerCurve;
   std::vector<SVector3> _tg;
 
 public:
-  AttractorAnisoCurveField() : _kdTree(0), _zeroNodes(0)
+  AttractorAnisoCurveField() : _pc2kd(_zeroNodes), _kdTree(0)
   {
-    _index = new ANNidx[1];
-    _dist = new ANNdist[1];
     _numPointsPerCurve = 20;
     updateNeeded = true;
     _dMin = 0.1;
@@ -1974,9 +2127,6 @@ public:
   ~AttractorAnisoCurveField()
   {
     if(_kdTree) delete _kdTree;
-    if(_zeroNodes) annDeallocPts(_zeroNodes);
-    delete[] _index;
-    delete[] _dist;
   }
   const char *getName() { return "AttractorAnisoCurve"; }
   std::string getDescription()
@@ -1990,14 +2140,9 @@ public:
   }
   void update()
   {
-    if(_zeroNodes) {
-      annDeallocPts(_zeroNodes);
-      delete _kdTree;
-    }
-    int totpoints = _numPointsPerCurve * _curveTags.size();
-    if(totpoints) { _zeroNodes = annAllocPts(totpoints, 3); }
-    _tg.resize(totpoints);
-    int k = 0;
+    if(_kdTree) delete _kdTree;
+    _zeroNodes.pts.clear();
+    _tg.clear();
     for(std::list<int>::iterator it = _curveTags.begin();
         it != _curveTags.end(); ++it) {
       GEdge *e = GModel::current()->getEdgeByTag(*it);
@@ -2008,28 +2153,45 @@ public:
           double t = b.low() + u * (b.high() - b.low());
           GPoint gp = e->point(t);
           SVector3 d = e->firstDer(t);
-          _zeroNodes[k][0] = gp.x();
-          _zeroNodes[k][1] = gp.y();
-          _zeroNodes[k][2] = gp.z();
-          _tg[k] = d;
-          _tg[k].normalize();
-          k++;
+          d.normalize();
+          _zeroNodes.pts.push_back(SPoint3(gp.x(), gp.y(), gp.z()));
+          _tg.push_back(d);
         }
       }
     }
-    _kdTree = new ANNkd_tree(_zeroNodes, totpoints, 3);
+    _kdTree = new my_kd_tree_t(3, _pc2kd,
+                               nanoflann::KDTreeSingleIndexAdaptorParams(10));
+    _kdTree->buildIndex();
     updateNeeded = false;
   }
+  // distance to the closest point; thread-safe
+  bool closest(double x, double y, double z, std::size_t &index,
+               double &d) const
+  {
+    if(!_kdTree || _zeroNodes.pts.empty()) return false;
+    double xyz[3] = {x, y, z}, d2 = 0.;
+    nanoflann::KNNResultSet<double> resultSet(1);
+    resultSet.init(&index, &d2);
+    _kdTree->findNeighbors(resultSet, xyz, nanoflann::SearchParams(10));
+    d = sqrt(d2);
+    return true;
+  }
   void operator()(double x, double y, double z, SMetric3 &metr, GEntity *ge = 0)
   {
-    if(updateNeeded) update();
-    double xyz[3] = {x, y, z};
+    if(updateNeeded) {
 #if defined(_OPENMP)
-#pragma omp                                                                    \
-  critical // just to avoid crash (still incorrect) - should use nanoflann
+#pragma omp critical
 #endif
-    _kdTree->annkSearch(xyz, 1, _index, _dist);
-    double d = sqrt(_dist[0]);
+      {
+        if(updateNeeded) update();
+      }
+    }
+    std::size_t index = 0;
+    double d = 0.;
+    if(!closest(x, y, z, index, d)) {
+      metr = SMetric3(1. / (MAX_LC * MAX_LC));
+      return;
+    }
     double lTg = d < _dMin ?
                    _lMinTangent :
                    d > _dMax ? _lMaxTangent :
@@ -2040,7 +2202,7 @@ public:
                   d > _dMax ? _lMaxNormal :
                               _lMinNormal + (_lMaxNormal - _lMinNormal) *
                                               (d - _dMin) / (_dMax - _dMin);
-    SVector3 t = _tg[_index[0]];
+    SVector3 t = _tg[index];
     SVector3 n0 = crossprod(t, fabs(t(0)) > fabs(t(1)) ? SVector3(0, 1, 0) :
                                                          SVector3(1, 0, 0));
     SVector3 n1 = crossprod(t, n0);
@@ -2048,36 +2210,36 @@ public:
   }
   virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
   {
-    if(updateNeeded) update();
-    double xyz[3] = {X, Y, Z};
+    if(updateNeeded) {
 #if defined(_OPENMP)
-#pragma omp                                                                    \
-  critical // just to avoid crash (still incorrect) - should use nanoflann
+#pragma omp critical
 #endif
-    _kdTree->annkSearch(xyz, 1, _index, _dist);
-    double d = sqrt(_dist[0]);
+      {
+        if(updateNeeded) update();
+      }
+    }
+    std::size_t index = 0;
+    double d = 0.;
+    if(!closest(X, Y, Z, index, d)) return MAX_LC;
     return std::max(d, 0.05);
   }
 };
 
 class AttractorField : public Field {
 private:
-  ANNkd_tree *_kdTree;
-  ANNpointArray _zeroNodes;
+  PointCloud _zeroNodes;
+  PC2KD _pc2kd;
+  my_kd_tree_t *_kdTree;
   std::list<int> _pointTags, _curveTags, _surfaceTags;
   std::vector<AttractorInfo> _infos;
   int _xFieldId, _yFieldId, _zFieldId;
   Field *_xField, *_yField, *_zField;
   int _numPointsPerCurve;
-  ANNidxArray _index;
-  ANNdistArray _dist;
 
 public:
   AttractorField(int dim, int tag, int nbe)
-    : _kdTree(0), _zeroNodes(0), _numPointsPerCurve(nbe)
+    : _pc2kd(_zeroNodes), _kdTree(0), _numPointsPerCurve(nbe)
   {
-    _index = new ANNidx[1];
-    _dist = new ANNdist[1];
     if(dim == 0)
       _pointTags.push_back(tag);
     else if(dim == 1)
@@ -2088,10 +2250,8 @@ public:
     _xFieldId = _yFieldId = _zFieldId = -1;
     updateNeeded = true;
   }
-  AttractorField() : _kdTree(0), _zeroNodes(0)
+  AttractorField() : _pc2kd(_zeroNodes), _kdTree(0)
   {
-    _index = new ANNidx[1];
-    _dist = new ANNdist[1];
     _numPointsPerCurve = 20;
     _xFieldId = _yFieldId = _zFieldId = -1;
 
@@ -2129,10 +2289,7 @@ public:
   }
   ~AttractorField()
   {
-    delete[] _index;
-    delete[] _dist;
     if(_kdTree) delete _kdTree;
-    if(_zeroNodes) annDeallocPts(_zeroNodes);
   }
   const char *getName() { return "Attractor"; }
   std::string getDescription()
@@ -2151,12 +2308,6 @@ public:
     cy = _yField ? (*_yField)(x, y, z, ge) : y;
     cz = _zField ? (*_zField)(x, y, z, ge) : z;
   }
-  std::pair<AttractorInfo, SPoint3> getAttractorInfo() const
-  {
-    return std::make_pair(_infos[_index[0]], SPoint3(_zeroNodes[_index[0]][0],
-                                                     _zeroNodes[_index[0]][1],
-                                                     _zeroNodes[_index[0]][2]));
-  }
   void update()
   {
     if(updateNeeded) {
@@ -2169,10 +2320,8 @@ public:
       _zField = _zFieldId >= 0 ?
                   (GModel::current()->getFields()->get(_zFieldId)) :
                   NULL;
-      if(_zeroNodes) {
-        annDeallocPts(_zeroNodes);
-        delete _kdTree;
-      }
+      if(_kdTree) delete _kdTree;
+      _infos.clear();
       std::vector<SPoint3> points;
       std::vector<SPoint2> uvpoints;
       std::vector<int> offset;
@@ -2295,40 +2444,50 @@ public:
         pz.push_back(0.);
       }
 
-      _zeroNodes = annAllocPts(totpoints, 3);
-      for(int i = 0; i < totpoints; i++) {
-        _zeroNodes[i][0] = px[i];
-        _zeroNodes[i][1] = py[i];
-        _zeroNodes[i][2] = pz[i];
-      }
-      _kdTree = new ANNkd_tree(_zeroNodes, totpoints, 3);
+      _zeroNodes.pts.resize(totpoints);
+      for(int i = 0; i < totpoints; i++)
+        _zeroNodes.pts[i] = SPoint3(px[i], py[i], pz[i]);
+      _kdTree = new my_kd_tree_t(3, _pc2kd,
+                                 nanoflann::KDTreeSingleIndexAdaptorParams(10));
+      _kdTree->buildIndex();
       updateNeeded = false;
     }
   }
 
-  using Field::operator();
-  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  // distance to the closest attractor, which is returned in closest (the
+  // results are per call, so that the field can be evaluated concurrently)
+  double getDistance(double X, double Y, double Z,
+                     std::pair<AttractorInfo, SPoint3> &closest,
+                     GEntity *ge = 0)
   {
+    if(updateNeeded) {
 #if defined(_OPENMP)
 #pragma omp critical
 #endif
-    {
-      update();
+      {
+        update();
+      }
     }
-    double xyz[3];
+    closest = std::make_pair(AttractorInfo(), SPoint3());
+    if(!_kdTree || _zeroNodes.pts.empty()) return MAX_LC;
+    double xyz[3], d2 = 0.;
     getCoord(X, Y, Z, xyz[0], xyz[1], xyz[2], ge);
-#if defined(_OPENMP)
-#pragma omp                                                                    \
-  critical // just to avoid crash (still incorrect) - should use nanoflann
-#endif
-    _kdTree->annkSearch(xyz, 1, _index, _dist);
-    double d = _dist[0];
-    return sqrt(d);
+    std::size_t index = 0;
+    nanoflann::KNNResultSet<double> resultSet(1);
+    resultSet.init(&index, &d2);
+    _kdTree->findNeighbors(resultSet, xyz, nanoflann::SearchParams(10));
+    if(index < _infos.size())
+      closest = std::make_pair(_infos[index], _zeroNodes.pts[index]);
+    return sqrt(d2);
+  }
+  using Field::operator();
+  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  {
+    std::pair<AttractorInfo, SPoint3> closest;
+    return getDistance(X, Y, Z, closest, ge);
   }
 };
 
-#endif // ANN
-
 class OctreeField : public Field {
 private:
   // octree field
@@ -2488,64 +2647,6 @@ virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
 }
 ;
 
-struct PointCloud {
-  std::vector<SPoint3> pts;
-};
-
-// And this is the "dataset to kd-tree" adaptor class:
-template <typename Derived> struct PointCloudAdaptor {
-  const Derived &obj; //!< A const ref to the data set origin
-
-  // The constructor that sets the data set source
-  PointCloudAdaptor(const Derived &obj_) : obj(obj_) {}
-
-  // CRTP helper method
-  inline const Derived &derived() const { return obj; }
-
-  // Must return the number of data points
-  inline size_t kdtree_get_point_count() const { return derived().pts.size(); }
-
-  // Returns the distance between the vector "p1[0:size-1]" and the data point
-  // with index "idx_p2" stored in the class:
-  inline double kdtree_distance(const double *p1, const size_t idx_p2,
-                                size_t /*size*/) const
-  {
-    const double d0 = p1[0] - derived().pts[idx_p2].x();
-    const double d1 = p1[1] - derived().pts[idx_p2].y();
-    const double d2 = p1[2] - derived().pts[idx_p2].z();
-    return d0 * d0 + d1 * d1 + d2 * d2;
-  }
-
-  // Returns the dim'th component of the idx'th point in the class: Since this
-  // is inlined and the "dim" argument is typically an immediate value, the
-  // "if/else's" are actually solved at compile time.
-  inline double kdtree_get_pt(const size_t idx, int dim) const
-  {
-    if(dim == 0)
-      return derived().pts[idx].x();
-    else if(dim == 1)
-      return derived().pts[idx].y();
-    else
-      return derived().pts[idx].z();
-  }
-
-  // Optional bounding-box computation: return false to default to a standard
-  // bbox computation loop.  Return true if the BBOX was already computed by the
-  // class and returned in "bb" so it can be avoided to redo it again.  Look at
-  // bb.size() to find out the expected dimensionality (e.g. 2 or 3 for point
-  // clouds)
-  template <class BBOX> bool kdtree_get_bbox(BBOX & /*bb*/) const
-  {
-    return false;
-  }
-
-}; // end of PointCloudAdaptor
-
-typedef PointCloudAdaptor<PointCloud> PC2KD;
-typedef nanoflann::KDTreeSingleIndexAdaptor<
-  nanoflann::L2_Simple_Adaptor<double, PC2KD>, PC2KD, 3>
-  my_kd_tree_t;
-
 class DistanceField : public Field {
   std::list<int> _pointTags, _curveTags, _surfaceTags;
   std::vector<AttractorInfo> _infos;
@@ -2555,11 +2656,9 @@ class DistanceField : public Field {
   PointCloud _P;
   my_kd_tree_t *_index;
   PC2KD _pc2kd;
-  std::size_t _outIndex;
-  double _outDistSqr;
 
 public:
-  DistanceField() : _index(NULL), _pc2kd(_P), _outIndex(0), _outDistSqr(0)
+  DistanceField() : _index(NULL), _pc2kd(_P)
   {
     _numPointsPerCurve = 20;
     _xFieldId = _yFieldId = _zFieldId = -1;
@@ -2597,8 +2696,7 @@ public:
       true);
   }
   DistanceField(int dim, int tag, int nbe)
-    : _numPointsPerCurve(nbe), _index(NULL), _pc2kd(_P), _outIndex(0),
-      _outDistSqr(0)
+    : _numPointsPerCurve(nbe), _index(NULL), _pc2kd(_P)
   {
     if(dim == 0)
       _pointTags.push_back(tag);
@@ -2623,12 +2721,6 @@ public:
            "surfaces are replaced by a point cloud, sampled according to "
            "NumPointsPerCurve and the size of their bounding box).";
   }
-  std::pair<AttractorInfo, SPoint3> getAttractorInfo() const
-  {
-    if(_outIndex < _infos.size() && _outIndex < _P.pts.size())
-      return std::make_pair(_infos[_outIndex], _P.pts[_outIndex]);
-    return std::make_pair(AttractorInfo(), SPoint3());
-  }
   void update()
   {
     if(updateNeeded) {
@@ -2708,22 +2800,55 @@ public:
       }
 
       // construct a kd-tree index:
+      if(_index) delete _index;
       _index = new my_kd_tree_t(3, _pc2kd,
                                 nanoflann::KDTreeSingleIndexAdaptorParams(10));
       _index->buildIndex();
       updateNeeded = false;
     }
   }
-  using Field::operator();
-  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  // distance to the closest point, which is returned in closest (the results
+  // are per call, so that the field can be evaluated concurrently)
+  double getDistance(double X, double Y, double Z,
+                     std::pair<AttractorInfo, SPoint3> &closest,
+                     GEntity *ge = 0)
   {
-    if(!_index) return MAX_LC;
+    closest = std::make_pair(AttractorInfo(), SPoint3());
+    if(!_index || _P.pts.empty()) return MAX_LC;
     double query_pt[3] = {X, Y, Z};
     const size_t num_results = 1;
+    std::size_t outIndex = 0;
+    double outDistSqr = 0.;
     nanoflann::KNNResultSet<double> resultSet(num_results);
-    resultSet.init(&_outIndex, &_outDistSqr);
+    resultSet.init(&outIndex, &outDistSqr);
     _index->findNeighbors(resultSet, &query_pt[0], nanoflann::SearchParams(10));
-    return sqrt(_outDistSqr);
+    if(outIndex < _infos.size())
+      closest = std::make_pair(_infos[outIndex], _P.pts[outIndex]);
+    return sqrt(outDistSqr);
+  }
+  using Field::operator();
+  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  {
+    std::pair<AttractorInfo, SPoint3> closest;
+    return getDistance(X, Y, Z, closest, ge);
+  }
+  void evaluate(const double *xyz, std::size_t n, double *val,
+                GEntity *ge = 0)
+  {
+    if(!n) return;
+    if(!_index || _P.pts.empty()) {
+      std::fill(val, val + n, MAX_LC);
+      return;
+    }
+    for(std::size_t i = 0; i < n; i++) {
+      std::size_t outIndex = 0;
+      double outDistSqr = 0.;
+      nanoflann::KNNResultSet<double> resultSet(1);
+      resultSet.init(&outIndex, &outDistSqr);
+      _index->findNeighbors(resultSet, &xyz[3 * i],
+                            nanoflann::SearchParams(10));
+      val[i] = sqrt(outDistSqr);
+    }
   }
 };
 
@@ -3012,9 +3137,9 @@ void BoundaryLayerField::computeFor1dMesh(double x, double y, double z,
   metr = buildMetricTangentToCurve(t1, lc_n, lc_n);
 }
 
-void BoundaryLayerField::operator()(DistanceField *cc, double dist, double x,
-                                    double y, double z, SMetric3 &metr,
-                                    GEntity *ge)
+void BoundaryLayerField::operator()(const std::pair<AttractorInfo, SPoint3> &pp,
+                                    double dist, double x, double y, double z,
+                                    SMetric3 &metr, GEntity *ge)
 {
   // dist = hwall -> lc = hwall * ratio
   // dist = hwall (1+ratio) -> lc = hwall ratio ^ 2
@@ -3035,7 +3160,6 @@ void BoundaryLayerField::operator()(DistanceField *cc, double dist, double x,
   lc_t = std::max(lc_t, CTX::instance()->mesh.lcMin);
   lc_t = std::min(lc_t, CTX::instance()->mesh.lcMax);
 
-  std::pair<AttractorInfo, SPoint3> pp = cc->getAttractorInfo();
   double beta = CTX::instance()->mesh.smoothRatio;
   if(pp.first.dim == 0) {
     GVertex *v = GModel::current()->getVertexByTag(pp.first.ent);
@@ -3122,19 +3246,19 @@ void BoundaryLayerField::operator()(double x, double y, double z,
   hop.push_back(v);
   for(std::list<DistanceField *>::iterator it = _attFields.begin();
       it != _attFields.end(); ++it) {
-    double cdist = (*(*it))(x, y, z);
-    SPoint3 CLOSEST = (*it)->getAttractorInfo().second;
+    std::pair<AttractorInfo, SPoint3> pp;
+    double cdist = (*it)->getDistance(x, y, z, pp);
     SMetric3 localMetric;
     if(iIntersect) {
-      (*this)(*it, cdist, x, y, z, localMetric, ge);
+      (*this)(pp, cdist, x, y, z, localMetric, ge);
       hop.push_back(localMetric);
     }
     if(cdist < currentDistance) {
-      if(!iIntersect) (*this)(*it, cdist, x, y, z, localMetric, ge);
+      if(!iIntersect) (*this)(pp, cdist, x, y, z, localMetric, ge);
       currentDistance = cdist;
       currentClosest = *it;
       v = localMetric;
-      _closestPoint = CLOSEST;
+      _closestPoint = pp.second;
     }
   }
   if(iIntersect)
@@ -3171,15 +3295,14 @@ FieldManager::FieldManager()
   mapTypeName["ExternalProcess"] = new FieldFactoryT<ExternalProcessField>();
   mapTypeName["MathEval"] = new FieldFactoryT<MathEvalField>();
   mapTypeName["MathEvalAniso"] = new FieldFactoryT<MathEvalFieldAniso>();
-#if defined(HAVE_ANN)
   mapTypeName["Attractor"] = new FieldFactoryT<AttractorField>();
   mapTypeName["AttractorAnisoCurve"] =
     new FieldFactoryT<AttractorAnisoCurveField>();
-#endif
   mapTypeName["MaxEigenHessian"] = new FieldFactoryT<MaxEigenHessianField>();
   mapTypeName["AutomaticMeshSizeField"] =
     new FieldFactoryT<automaticMeshSizeField>();
   _backgroundField = -1;
+  _version = 0;
 }
 
 void FieldManager::initialize()
@@ -3231,15 +3354,35 @@ void Field::putOnNewView(int viewTag)
 void Field::putOnView(PView *view, int comp)
 {
   PViewData *data = view->getData();
+  // gather the nodes, evaluate the field on all of them in parallel, then
+  // store the values
+  std::vector<double> xyz;
   for(int ent = 0; ent < data->getNumEntities(0); ent++) {
     for(int ele = 0; ele < data->getNumElements(0, ent); ele++) {
       if(data->skipElement(0, ent, ele)) continue;
       for(int nod = 0; nod < data->getNumNodes(0, ent, ele); nod++) {
         double x, y, z;
         data->getNode(0, ent, ele, nod, x, y, z);
-        double val = (*this)(x, y, z);
+        xyz.push_back(x);
+        xyz.push_back(y);
+        xyz.push_back(z);
+      }
+    }
+  }
+  const long int n = xyz.size() / 3, chunk = 1024;
+  std::vector<double> val(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(long int i = 0; i < n; i += chunk)
+    evaluate(&xyz[3 * i], std::min(chunk, n - i), &val[i]);
+  std::size_t k = 0;
+  for(int ent = 0; ent < data->getNumEntities(0); ent++) {
+    for(int ele = 0; ele < data->getNumElements(0, ent); ele++) {
+      if(data->skipElement(0, ent, ele)) continue;
+      for(int nod = 0; nod < data->getNumNodes(0, ent, ele); nod++, k++) {
         for(int comp = 0; comp < data->getNumComponents(0, ent, ele); comp++)
-          data->setValue(0, ent, ele, nod, comp, val);
+          data->setValue(0, ent, ele, nod, comp, val[k]);
       }
     }
   }
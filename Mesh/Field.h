@@ -18,6 +18,7 @@
 #include <string.h>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
 
 #if defined(HAVE_POST)
 class PView;
@@ -53,14 +54,15 @@ private:
   bool _deprecated;
 
 protected:
-  bool *status;
+  std::atomic<bool> *status;
   inline void modified()
   {
     if(status) *status = true;
   }
 
 public:
-  FieldOption(const std::string &help, bool *_status, bool deprecated)
+  FieldOption(const std::string &help, std::atomic<bool> *_status,
+              bool deprecated)
     : _help(help), _deprecated(deprecated), status(_status)
   {
   }
@@ -111,12 +113,19 @@ public:
   virtual bool isotropic() const { return true; }
   // isotropic
   virtual double operator()(double x, double y, double z, GEntity *ge = 0) = 0;
+  // isotropic, for n points with coordinates xyz[3 * i + 0..2], stored in
+  // val[i]; fields override this to avoid one virtual call per point
+  virtual void evaluate(const double *xyz, std::size_t n, double *val,
+                        GEntity *ge = 0);
   // anisotropic
   virtual void operator()(double x, double y, double z, SMetric3 &,
                           GEntity *ge = 0)
   {
   }
-  bool updateNeeded;
+  // set when an option is modified; update() should be called (in a critical
+  // section, when evaluating in parallel) before evaluating the field, and
+  // should reset the flag once the field is up to date
+  std::atomic<bool> updateNeeded;
   virtual const char *getName() = 0;
 #if defined(HAVE_POST)
   void putOnView(PView *view, int comp = -1);
@@ -136,6 +145,7 @@ class FieldManager : public std::map<int, Field *> {
 private:
   int _backgroundField;
   std::vector<int> _boundaryLayerFields;
+  int _version;
 
 public:
   std::map<std::string, FieldFactory *> mapTypeName;
@@ -146,6 +156,9 @@ public:
   void deleteField(int id);
   int newId();
   int maxId();
+  // incremented each time a field is created or deleted, so that fields can
+  // cache pointers to the fields they depend on
+  int getVersion() const { return _version; }
   FieldManager();
   ~FieldManager();
   // compatibility with -bgm
@@ -177,6 +190,7 @@ public:
 // extrusion)
 
 class DistanceField;
+struct AttractorInfo;
 
 class BoundaryLayerField : public Field {
 private:
@@ -187,8 +201,8 @@ private:
   std::list<int> _excludedSurfaceTags;
   std::list<int> _fanSizes;
   SPoint3 _closestPoint;
-  void operator()(DistanceField *cc, double dist, double x, double y, double z,
-                  SMetric3 &metr, GEntity *ge);
+  void operator()(const std::pair<AttractorInfo, SPoint3> &pp, double dist,
+                  double x, double y, double z, SMetric3 &metr, GEntity *ge);
 
 public:
   double hWallN, ratio, hFar, thickness;
@@ -257,7 +271,7 @@ public:
   std::string &val;
   virtual FieldOptionType getType() { return FIELD_OPTION_STRING; }
   FieldOptionString(std::string &_val, const std::string &help,
-                    bool *status = 0, bool deprecated = false)
+                    std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
@@ -279,8 +293,8 @@ class FieldOptionDouble : public FieldOption {
 public:
   double &val;
   FieldOptionType getType() { return FIELD_OPTION_DOUBLE; }
-  FieldOptionDouble(double &_val, const std::string &help, bool *status = 0,
-                    bool deprecated = false)
+  FieldOptionDouble(double &_val, const std::string &help,
+                    std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
@@ -303,8 +317,8 @@ class FieldOptionInt : public FieldOption {
 public:
   int &val;
   FieldOptionType getType() { return FIELD_OPTION_INT; }
-  FieldOptionInt(int &_val, const std::string &help, bool *status = 0,
-                 bool deprecated = false)
+  FieldOptionInt(int &_val, const std::string &help,
+                 std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
@@ -327,7 +341,7 @@ public:
   std::list<int> &val;
   FieldOptionType getType() { return FIELD_OPTION_LIST; }
   FieldOptionList(std::list<int> &_val, const std::string &help,
-                  bool *status = 0, bool deprecated = false)
+                  std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
@@ -355,7 +369,7 @@ public:
   std::list<double> &val;
   FieldOptionType getType() { return FIELD_OPTION_LIST_DOUBLE; }
   FieldOptionListDouble(std::list<double> &_val, const std::string &help,
-                        bool *status = 0, bool deprecated = false)
+                        std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
@@ -382,8 +396,8 @@ public:
 class FieldOptionPath : public FieldOptionString {
 public:
   virtual FieldOptionType getType() { return FIELD_OPTION_PATH; }
-  FieldOptionPath(std::string &val, const std::string &help, bool *status = 0,
-                  bool deprecated = false)
+  FieldOptionPath(std::string &val, const std::string &help,
+                  std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOptionString(val, help, status, deprecated)
   {
   }
@@ -393,8 +407,8 @@ class FieldOptionBool : public FieldOption {
 public:
   bool &val;
   FieldOptionType getType() { return FIELD_OPTION_BOOL; }
-  FieldOptionBool(bool &_val, const std::string &help, bool *status = 0,
-                  bool deprecated = false)
+  FieldOptionBool(bool &_val, const std::string &help,
+                  std::atomic<bool> *status = 0, bool deprecated = false)
     : FieldOption(help, status, deprecated), val(_val)
   {
   }
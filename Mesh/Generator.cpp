@@ -4,7 +4,10 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
 #include <stdlib.h>
+#include <cmath>
 #include <stack>
+#include <map>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "Numeric.h"
@@ -34,6 +37,7 @@
 #include "Field.h"
 #include "Options.h"
 #include "Generator.h"
+#include "robustPredicates.h"
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -561,6 +565,22 @@ static void Mesh2D(GModel *m)
   Msg::StatusBar(true, "Done meshing 2D (Wall %gs, CPU %gs)",
                  CTX::instance()->meshTimer[1], t2 - t1);
 
+  // point insertions and point location in the 2D Delaunay algorithms
+  std::size_t nbInsertion = 0, nbPointSearch = 0, nbWalkFailure = 0;
+  std::size_t nbLinearScan = 0;
+  for(GModel::fiter it = m->firstFace(); it != m->lastFace(); ++it) {
+    nbInsertion += (*it)->meshStatistics.nbInsertion;
+    nbPointSearch += (*it)->meshStatistics.nbPointSearch;
+    nbWalkFailure += (*it)->meshStatistics.nbWalkFailure;
+    nbLinearScan += (*it)->meshStatistics.nbLinearScan;
+  }
+  if(nbInsertion)
+    Msg::Info("%lu points inserted by Delaunay, %lu point searches, %lu walk "
+              "failures (%g%%), %lu linear scans",
+              nbInsertion, nbPointSearch, nbWalkFailure,
+              nbPointSearch ? 100. * nbWalkFailure / nbPointSearch : 0.,
+              nbLinearScan);
+
   PrintMesh2dStatistics(m);
 }
 
@@ -608,6 +628,166 @@ FindConnectedRegions(const std::vector<GRegion *> &del,
             connected.size() > 1 ? "s" : "");
 }
 
+// groups of connected volumes can still share curves or points (and thus
+// mesh nodes, whose index is used by the 3D mesh generators): gather the
+// groups that share any such entity into clusters, meshed by the same thread
+static void
+FindIndependentClusters(const std::vector<std::vector<GRegion *> > &connected,
+                        std::vector<std::vector<std::size_t> > &clusters)
+{
+  std::vector<std::size_t> parent(connected.size());
+  for(std::size_t i = 0; i < parent.size(); i++) parent[i] = i;
+  std::map<GEntity *, std::size_t> owner;
+  for(std::size_t i = 0; i < connected.size(); i++) {
+    std::vector<GEntity *> ents;
+    for(std::size_t j = 0; j < connected[i].size(); j++) {
+      GRegion *gr = connected[i][j];
+      std::vector<GFace *> f = gr->faces();
+      f.insert(f.end(), gr->embeddedFaces().begin(), gr->embeddedFaces().end());
+      for(std::size_t k = 0; k < f.size(); k++) {
+        std::vector<GEdge *> e = f[k]->edges();
+        std::vector<GVertex *> v = f[k]->vertices();
+        ents.push_back(f[k]);
+        ents.insert(ents.end(), e.begin(), e.end());
+        ents.insert(ents.end(), v.begin(), v.end());
+        ents.insert(ents.end(), f[k]->embeddedEdges().begin(),
+                    f[k]->embeddedEdges().end());
+        ents.insert(ents.end(), f[k]->embeddedVertices().begin(),
+                    f[k]->embeddedVertices().end());
+      }
+      ents.insert(ents.end(), gr->embeddedEdges().begin(),
+                  gr->embeddedEdges().end());
+      ents.insert(ents.end(), gr->embeddedVertices().begin(),
+                  gr->embeddedVertices().end());
+    }
+    for(std::size_t k = 0; k < ents.size(); k++) {
+      std::map<GEntity *, std::size_t>::iterator it = owner.find(ents[k]);
+      if(it == owner.end()) {
+        owner[ents[k]] = i;
+        continue;
+      }
+      std::size_t a = it->second, b = i;
+      while(parent[a] != a) a = parent[a];
+      while(parent[b] != b) b = parent[b];
+      if(a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+  }
+  clusters.clear();
+  std::vector<std::size_t> clusterOf(connected.size());
+  for(std::size_t i = 0; i < connected.size(); i++) {
+    std::size_t r = i;
+    while(parent[r] != r) r = parent[r];
+    if(r == i) {
+      clusterOf[i] = clusters.size();
+      clusters.push_back(std::vector<std::size_t>());
+    }
+    clusters[clusterOf[r]].push_back(i);
+  }
+}
+
+static bool CanMeshConnectedRegionsInParallel(
+  GModel *m, std::vector<std::vector<GRegion *> > &connected,
+  std::vector<std::vector<std::size_t> > &clusters)
+{
+  if(!CTX::instance()->mesh.parallelVolumes) return false;
+  if(connected.size() < 2 || Msg::GetMaxThreads() < 2) return false;
+
+  // only the Delaunay algorithm is safe to run concurrently on separate
+  // groups of volumes (HXT uses global predicate filters, and is parallel
+  // anyway)
+  if(CTX::instance()->mesh.algo3d != ALGO_3D_DELAUNAY &&
+     CTX::instance()->mesh.algo3d != ALGO_3D_INITIAL_ONLY)
+    return false;
+
+  // boundary recovery gives up if any error has been raised before, which
+  // cannot be reproduced when the volumes are meshed concurrently
+  if(Msg::GetErrorCount()) return false;
+
+  // boundary layers are not yet thread-safe
+  if(m->getFields()->getNumBoundaryLayerFields()) return false;
+
+  if(CTX::instance()->mesh.recombine3DAll) return false;
+  for(std::size_t i = 0; i < connected.size(); i++) {
+    for(std::size_t j = 0; j < connected[i].size(); j++) {
+      GRegion *gr = connected[i][j];
+      if(gr->meshAttributes.recombine3D) return false;
+      // pyramids on quadrangular faces are created and optimized globally
+      std::vector<GFace *> f = gr->faces();
+      for(std::size_t k = 0; k < f.size(); k++)
+        if(f[k]->quadrangles.size()) return false;
+    }
+  }
+  FindIndependentClusters(connected, clusters);
+  return clusters.size() > 1;
+}
+
+class GRegionClusterMoreWork {
+private:
+  const std::vector<std::vector<GRegion *> > &_connected;
+  std::size_t _work(const std::vector<std::size_t> &cluster) const
+  {
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < cluster.size(); i++) {
+      const std::vector<GRegion *> &group = _connected[cluster[i]];
+      for(std::size_t j = 0; j < group.size(); j++) {
+        std::vector<GFace *> f = group[j]->faces();
+        for(std::size_t k = 0; k < f.size(); k++) n += f[k]->triangles.size();
+      }
+    }
+    return n;
+  }
+
+public:
+  GRegionClusterMoreWork(const std::vector<std::vector<GRegion *> > &connected)
+    : _connected(connected)
+  {
+  }
+  bool operator()(const std::vector<std::size_t> &c1,
+                  const std::vector<std::size_t> &c2) const
+  {
+    return _work(c1) > _work(c2);
+  }
+};
+
+static void
+MeshDelaunayVolumesInParallel(std::vector<std::vector<GRegion *> > &connected,
+                              std::vector<std::vector<std::size_t> > &clusters)
+{
+  // start with the clusters having the largest surface meshes, to balance the
+  // load between threads
+  std::stable_sort(clusters.begin(), clusters.end(),
+                   GRegionClusterMoreWork(connected));
+
+  Msg::Info("Meshing %d groups of volumes in parallel", (int)clusters.size());
+
+  // the static filters of the robust predicates are shared by all the threads:
+  // compute them once, for the coordinates of all the nodes (instead of those
+  // of each group, in delaunayTriangulation())
+  double maxx = 0., maxy = 0., maxz = 0.;
+  std::vector<GEntity *> entities;
+  GModel::current()->getEntities(entities);
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    for(std::size_t j = 0; j < entities[i]->mesh_vertices.size(); j++) {
+      MVertex *v = entities[i]->mesh_vertices[j];
+      maxx = std::max(maxx, std::abs(v->x()));
+      maxy = std::max(maxy, std::abs(v->y()));
+      maxz = std::max(maxz, std::abs(v->z()));
+    }
+  }
+  robustPredicates::exactinit(1, maxx, maxy, maxz);
+
+  const std::size_t n = clusters.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for(std::size_t i = 0; i < n; i++) {
+    for(std::size_t j = 0; j < clusters[i].size(); j++) {
+      if(CTX::instance()->abortOnError && Msg::GetErrorCount()) break;
+      MeshDelaunayVolume(connected[clusters[i][j]]);
+    }
+  }
+}
+
 // JFR : use hex-splitting to resolve non conformity
 //     : if howto == 1 ---> split hexes
 //     : if howto == 2 ---> create transition elements
@@ -870,13 +1050,20 @@ static void Mesh3D(GModel *m)
   int nb_elements_recombination = 0, nb_hexa_recombination = 0;
 #endif
 
+  // disconnected groups of volumes share no surface mesh: if possible, mesh
+  // the groups that share no curve or point either concurrently (each group
+  // is then meshed by a single thread)
+  std::vector<std::vector<std::size_t> > clusters;
+  bool parallel = CanMeshConnectedRegionsInParallel(m, connected, clusters);
+  if(parallel) MeshDelaunayVolumesInParallel(connected, clusters);
+
   for(std::size_t i = 0; i < connected.size(); i++) {
     if(CTX::instance()->abortOnError && Msg::GetErrorCount()) {
       Msg::Warning("Aborted 3D meshing");
       break;
     }
 
-    MeshDelaunayVolume(connected[i]);
+    if(!parallel) MeshDelaunayVolume(connected[i]);
 
 #if defined(HAVE_DOMHEX)
     // additional code for experimental hex mesh - will eventually be replaced
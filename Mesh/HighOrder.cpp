@@ -9,6 +9,7 @@
 
 #include <sstream>
 #include <vector>
+#include <set>
 #include "GmshConfig.h"
 #include "GModel.h"
 #include "HighOrder.h"
@@ -41,6 +42,14 @@ typedef std::map<std::pair<MVertex *, MVertex *>, std::vector<MVertex *> >
 // high order representation of the face
 typedef std::map<MFace, std::vector<MVertex *>, MFaceLessThan> faceContainer;
 
+// positions of the high order vertices of mesh edges on the geometry, computed
+// in parallel before the vertices are created (serially, so that the numbering
+// of the vertices does not depend on the number of threads), for each pair of
+// vertices as passed to getEdgeVerticesOnGeo (see createVertices for the
+// storage of the positions)
+typedef std::map<std::pair<MVertex *, MVertex *>, std::vector<double> >
+  edgePoints;
+
 // Functions that help optimizing placement of points on geometry
 
 // The aim here is to build a polynomial representation that consist
@@ -244,8 +253,40 @@ void createMatLob2LagP6()
 
 // Creation of high-order edge vertices
 
-static bool getEdgeVerticesOnGeo(GEdge *ge, MVertex *v0, MVertex *v1,
-                                 std::vector<MVertex *> &ve, int nPts = 1)
+// Create vertices from their positions, stored as (x, y, z, u, v, onGeo) for
+// each vertex: if onGeo is set, (u, v) are the parametric coordinates of the
+// vertex on the entity. Return false if there are no positions
+static bool createVertices(GEntity *ge, const std::vector<double> &points,
+                           std::vector<MVertex *> &ve)
+{
+  if(points.empty()) return false;
+  for(std::size_t i = 0; i + 6 <= points.size(); i += 6) {
+    const double *p = &points[i];
+    if(p[5] && ge->dim() == 1)
+      ve.push_back(new MEdgeVertex(p[0], p[1], p[2], ge, p[3]));
+    else if(p[5] && ge->dim() == 2)
+      ve.push_back(new MFaceVertex(p[0], p[1], p[2], ge, p[3], p[4]));
+    else
+      ve.push_back(new MVertex(p[0], p[1], p[2], ge));
+  }
+  return true;
+}
+
+static void addPoint(std::vector<double> &points, double x, double y,
+                     double z, double u, double v, bool onGeo)
+{
+  points.push_back(x);
+  points.push_back(y);
+  points.push_back(z);
+  points.push_back(u);
+  points.push_back(v);
+  points.push_back(onGeo ? 1. : 0.);
+}
+
+// Compute the positions of the new vertices of a mesh edge on a curve (this
+// does not modify any shared data and can thus be called concurrently)
+static bool getEdgePointsOnGeo(GEdge *ge, MVertex *v0, MVertex *v1,
+                               std::vector<double> &points, int nPts = 1)
 {
   static bool GLLquad = false;
   static const double relaxFail = 1e-2;
@@ -301,27 +342,26 @@ static bool getEdgeVerticesOnGeo(GEdge *ge, MVertex *v0, MVertex *v1,
       M(j + 1, 2) = pc.z();
     }
     fullMatrix<double> Mlag(7, 3);
+#if defined(_OPENMP)
+#pragma omp critical(createMatLob2LagP6)
+#endif
     if(!lob2lagP6) createMatLob2LagP6();
     lob2lagP6->mult(M, Mlag);
 
     for(int j = 0; j < nPts; j++) {
-      MVertex *v;
       int count = u0 < u1 ? j + 1 : nPts + 1 - (j + 1);
       // FIXME US[count] false!!!
-      v = new MEdgeVertex(Mlag(count, 0), Mlag(count, 1), Mlag(count, 2), ge,
-                          US[count]);
+      addPoint(points, Mlag(count, 0), Mlag(count, 1), Mlag(count, 2),
+               US[count], 0., true);
       // this destroys the ordering of the mesh vertices on the edge
-      ve.push_back(v);
     }
   }
   else {
     for(int j = 0; j < nPts; j++) {
-      MVertex *v;
       int count = u0 < u1 ? j + 1 : nPts + 1 - (j + 1);
       GPoint pc = ge->point(US[count]);
-      v = new MEdgeVertex(pc.x(), pc.y(), pc.z(), ge, US[count]);
+      addPoint(points, pc.x(), pc.y(), pc.z(), US[count], 0., true);
       // this destroys the ordering of the mesh vertices on the edge
-      ve.push_back(v);
     }
   }
 
@@ -329,8 +369,10 @@ static bool getEdgeVerticesOnGeo(GEdge *ge, MVertex *v0, MVertex *v1,
   return true;
 }
 
-static bool getEdgeVerticesOnGeo(GFace *gf, MVertex *v0, MVertex *v1,
-                                 std::vector<MVertex *> &ve, int nPts = 1)
+// Compute the positions of the new vertices of a mesh edge on a surface (this
+// can be called concurrently)
+static bool getEdgePointsOnGeo(GFace *gf, MVertex *v0, MVertex *v1,
+                               std::vector<double> &points, int nPts = 1)
 {
   SPoint2 p0, p1;
   double US[100], VS[100];
@@ -357,14 +399,44 @@ static bool getEdgeVerticesOnGeo(GFace *gf, MVertex *v0, MVertex *v1,
 
   for(int j = 0; j < nPts; j++) {
     GPoint pc = gf->point(US[j + 1], VS[j + 1]);
-    MVertex *v =
-      new MFaceVertex(pc.x(), pc.y(), pc.z(), gf, US[j + 1], VS[j + 1]);
-    ve.push_back(v);
+    addPoint(points, pc.x(), pc.y(), pc.z(), US[j + 1], VS[j + 1], true);
   }
 
   return true;
 }
 
+// Compute in parallel the positions of the new vertices of the given mesh
+// edges on a curve or a surface
+template <class T>
+static void computeEdgePoints(
+  T *ge, const std::vector<std::pair<MVertex *, MVertex *> > &edges,
+  int nPts, edgePoints &points)
+{
+  std::vector<std::vector<double> > p(edges.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for(long int i = 0; i < (long int)edges.size(); i++)
+    getEdgePointsOnGeo(ge, edges[i].first, edges[i].second, p[i], nPts);
+  for(std::size_t i = 0; i < edges.size(); i++) points[edges[i]].swap(p[i]);
+}
+
+// Get the new vertices of a mesh edge on a curve or a surface, from their
+// precomputed positions if available
+template <class T>
+static bool getEdgeVerticesOnGeo(T *ge, MVertex *v0, MVertex *v1,
+                                 std::vector<MVertex *> &ve, int nPts,
+                                 const edgePoints *points)
+{
+  if(points) {
+    edgePoints::const_iterator it = points->find(std::make_pair(v0, v1));
+    if(it != points->end()) return createVertices(ge, it->second, ve);
+  }
+  std::vector<double> p;
+  getEdgePointsOnGeo(ge, v0, v1, p, nPts);
+  return createVertices(ge, p, ve);
+}
+
 static void interpVerticesInExistingEdge(GEntity *ge, const MElement *edgeEl,
                                          std::vector<MVertex *> &veEdge,
                                          int nPts)
@@ -398,7 +470,7 @@ inline static bool getMinMaxVert(MVertex *v0, MVertex *v1, MVertex *&vMin,
 static void getEdgeVertices(GEdge *ge, MElement *ele,
                             std::vector<MVertex *> &ve,
                             edgeContainer &edgeVertices, bool linear,
-                            int nPts = 1)
+                            int nPts = 1, const edgePoints *points = 0)
 {
   if(!ge->haveParametrization()) linear = true;
 
@@ -411,7 +483,9 @@ static void getEdgeVertices(GEdge *ge, MElement *ele,
   std::vector<MVertex *> veEdge;
   // Get vertices on geometry if asked
   bool gotVertOnGeo =
-    linear ? false : getEdgeVerticesOnGeo(ge, veOld[0], veOld[1], veEdge, nPts);
+    linear ?
+      false :
+      getEdgeVerticesOnGeo(ge, veOld[0], veOld[1], veEdge, nPts, points);
   // If not on geometry, create from mesh interpolation
   if(!gotVertOnGeo) interpVerticesInExistingEdge(ge, ele, veEdge, nPts);
   if(edgeVertices.count(p) == 0) {
@@ -436,7 +510,7 @@ static void getEdgeVertices(GEdge *ge, MElement *ele,
 static void getEdgeVertices(GFace *gf, MElement *ele,
                             std::vector<MVertex *> &ve,
                             edgeContainer &edgeVertices, bool linear,
-                            int nPts = 1)
+                            int nPts = 1, const edgePoints *points = 0)
 {
   if(!gf->haveParametrization()) linear = true;
 
@@ -461,7 +535,8 @@ static void getEdgeVertices(GFace *gf, MElement *ele,
       // Get vertices on geometry if asked
       bool gotVertOnGeo =
         linear ? false :
-                 getEdgeVerticesOnGeo(gf, veOld[0], veOld[1], veEdge, nPts);
+                 getEdgeVerticesOnGeo(gf, veOld[0], veOld[1], veEdge, nPts,
+                                      points);
       if(!gotVertOnGeo) {
         // If not on geometry, create from mesh interpolation
         const MLineN edgeEl(veOld, ele->getPolynomialOrder());
@@ -680,29 +755,39 @@ static void interpVerticesInExistingFace(GEntity *ge,
   }
 }
 
-static bool getFaceVerticesOnExtrudedGeo(GFace *gf,
-                                         const fullMatrix<double> &coefficients,
-                                         const std::vector<MVertex *> &vertices,
-                                         std::vector<MVertex *> &vf)
+static bool isFaceOnExtrudedGeo(GFace *gf,
+                                const fullMatrix<double> &coefficients,
+                                const std::vector<MVertex *> &vertices)
 {
   // special case for 9 node quads...
   if(coefficients.size1() != 1 || vertices.size() != 8) return false;
 
-  // ...on surfaces with recombined extruded meshes, generated by translation...
+  // ...on surfaces with recombined extruded meshes, generated by translation
   ExtrudeParams *ep = gf->meshAttributes.extrude;
   if(!ep || !ep->mesh.ExtrudeMesh || !ep->mesh.Recombine ||
      ep->geo.Mode != EXTRUDED_ENTITY || ep->geo.Type != TRANSLATE)
     return false;
+  return true;
+}
+
+static bool getFaceVerticesOnExtrudedGeo(GFace *gf,
+                                         const fullMatrix<double> &coefficients,
+                                         const std::vector<MVertex *> &vertices,
+                                         std::vector<MVertex *> &vf)
+{
+  if(!isFaceOnExtrudedGeo(gf, coefficients, vertices)) return false;
 
-  // ...then this is exact
+  // interpolation is then exact
   interpVerticesInExistingFace(gf, coefficients, vertices, vf);
   return true;
 }
 
-static void getFaceVerticesOnGeo(GFace *gf,
-                                 const fullMatrix<double> &coefficients,
-                                 const std::vector<MVertex *> &vertices,
-                                 std::vector<MVertex *> &vf)
+// Compute the positions of the new interior vertices of a 2D element on a
+// surface (this can be called concurrently)
+static void getFacePointsOnGeo(GFace *gf,
+                               const fullMatrix<double> &coefficients,
+                               const std::vector<MVertex *> &vertices,
+                               std::vector<double> &points)
 {
   SPoint2 pts[1000];
   bool reparamOK = true;
@@ -720,7 +805,6 @@ static void getFaceVerticesOnGeo(GFace *gf,
         GUESS[1] += coefficients(k, j) * pts[j][1];
       }
     }
-    MVertex *v;
     if(reparamOK) {
       // closestPoint is absolutely necessary when the parameterization is
       // degenerate
@@ -732,40 +816,60 @@ static void getFaceVerticesOnGeo(GFace *gf,
         gp = gf->closestPoint(SPoint3(X, Y, Z), GUESS);
       }
       if(gp.g()) {
-        v = new MFaceVertex(gp.x(), gp.y(), gp.z(), gf, gp.u(), gp.v());
+        addPoint(points, gp.x(), gp.y(), gp.z(), gp.u(), gp.v(), true);
       }
       else {
-        v = new MVertex(X, Y, Z, gf);
+        addPoint(points, X, Y, Z, 0., 0., false);
       }
     }
     else {
       GPoint gp = gf->closestPoint(SPoint3(X, Y, Z), GUESS);
       if(gp.succeeded())
-        v = new MVertex(gp.x(), gp.y(), gp.z(), gf);
+        addPoint(points, gp.x(), gp.y(), gp.z(), 0., 0., false);
       else
-        v = new MVertex(X, Y, Z, gf);
+        addPoint(points, X, Y, Z, 0., 0., false);
     }
-    vf.push_back(v);
   }
 }
 
+// Get the corner vertices of an element followed by its new (edge) vertices
+static void getBoundaryVertices(MElement *ele,
+                                const std::vector<MVertex *> &newVertices,
+                                std::vector<MVertex *> &boundaryVertices)
+{
+  std::size_t nCorner = ele->getNumPrimaryVertices();
+  boundaryVertices.reserve(nCorner + newVertices.size());
+  ele->getVertices(boundaryVertices);
+  boundaryVertices.resize(nCorner);
+  boundaryVertices.insert(boundaryVertices.end(), newVertices.begin(),
+                          newVertices.end());
+}
+
+// Compute the positions of the new interior vertices of a 2D element on a
+// surface, given its new edge vertices; nothing is computed if the vertices
+// are simply interpolated (see getFaceVerticesOnExtrudedGeo)
+static void getFacePointsOnGeo(GFace *gf, MElement *ele,
+                               const std::vector<MVertex *> &newVertices,
+                               int nPts, std::vector<double> &points)
+{
+  std::vector<MVertex *> boundaryVertices;
+  getBoundaryVertices(ele, newVertices, boundaryVertices);
+  fullMatrix<double> *coefficients =
+    getInnerVertexPlacement(ele->getType(), nPts + 1);
+  if(!isFaceOnExtrudedGeo(gf, *coefficients, boundaryVertices))
+    getFacePointsOnGeo(gf, *coefficients, boundaryVertices, points);
+}
+
 // Get new interior vertices for a 2D element
 static void getFaceVertices(GFace *gf, MElement *ele,
                             std::vector<MVertex *> &newVertices,
                             faceContainer &faceVertices, bool linear,
-                            int nPts = 1)
+                            int nPts = 1, const std::vector<double> *points = 0)
 {
   if(!gf->haveParametrization()) linear = true;
 
   std::vector<MVertex *> boundaryVertices;
-  {
-    std::size_t nCorner = ele->getNumPrimaryVertices();
-    boundaryVertices.reserve(nCorner + newVertices.size());
-    ele->getVertices(boundaryVertices);
-    boundaryVertices.resize(nCorner);
-    boundaryVertices.insert(boundaryVertices.end(), newVertices.begin(),
-                            newVertices.end());
-  }
+  getBoundaryVertices(ele, newVertices, boundaryVertices);
   int type = ele->getType();
   fullMatrix<double> *coefficients = getInnerVertexPlacement(type, nPts + 1);
   std::vector<MVertex *> vFace;
@@ -774,8 +878,15 @@ static void getFaceVertices(GFace *gf, MElement *ele,
     // (translation): this allows to speed up a common case (extruded OCC
     // models) by orders of magnitudes, where OCC closestPoint() is atrociously
     // slow
-    if(!getFaceVerticesOnExtrudedGeo(gf, *coefficients, boundaryVertices, vFace))
-      getFaceVerticesOnGeo(gf, *coefficients, boundaryVertices, vFace);
+    if(!getFaceVerticesOnExtrudedGeo(gf, *coefficients, boundaryVertices,
+                                     vFace)) {
+      std::vector<double> p;
+      if(!points || points->empty()) {
+        getFacePointsOnGeo(gf, *coefficients, boundaryVertices, p);
+        points = &p;
+      }
+      createVertices(gf, *points, vFace);
+    }
   }
   else { // ... otherwise, create from mesh interpolation
     interpVerticesInExistingFace(gf, *coefficients, boundaryVertices, vFace);
@@ -901,14 +1012,7 @@ static void getVolumeVertices(GRegion *gr, MElement *ele,
                               std::vector<MVertex *> &newVertices, int nPts = 1)
 {
   std::vector<MVertex *> boundaryVertices;
-  {
-    std::size_t nCorner = ele->getNumPrimaryVertices();
-    boundaryVertices.reserve(nCorner + newVertices.size());
-    ele->getVertices(boundaryVertices);
-    boundaryVertices.resize(nCorner);
-    boundaryVertices.insert(boundaryVertices.end(), newVertices.begin(),
-                            newVertices.end());
-  }
+  getBoundaryVertices(ele, newVertices, boundaryVertices);
   int type = ele->getType();
   fullMatrix<double> &coefficients = *getInnerVertexPlacement(type, nPts + 1);
 
@@ -930,11 +1034,21 @@ static void getVolumeVertices(GRegion *gr, MElement *ele,
 static void setHighOrder(GEdge *ge, edgeContainer &edgeVertices, bool linear,
                          int nbPts = 1)
 {
+  // compute the positions of the new vertices on the curve in parallel
+  edgePoints points;
+  if(!linear && ge->haveParametrization()) {
+    std::vector<std::pair<MVertex *, MVertex *> > edges;
+    for(std::size_t i = 0; i < ge->lines.size(); i++)
+      edges.push_back(
+        std::make_pair(ge->lines[i]->getVertex(0), ge->lines[i]->getVertex(1)));
+    computeEdgePoints(ge, edges, nbPts, points);
+  }
+
   std::vector<MLine *> lines2;
   for(std::size_t i = 0; i < ge->lines.size(); i++) {
     MLine *l = ge->lines[i];
     std::vector<MVertex *> ve;
-    getEdgeVertices(ge, l, ve, edgeVertices, linear, nbPts);
+    getEdgeVertices(ge, l, ve, edgeVertices, linear, nbPts, &points);
     if(nbPts == 1)
       lines2.push_back(
         new MLine3(l->getVertex(0), l->getVertex(1), ve[0], l->getPartition()));
@@ -947,31 +1061,34 @@ static void setHighOrder(GEdge *ge, edgeContainer &edgeVertices, bool linear,
   ge->deleteVertexArrays();
 }
 
+// Create a high-order triangle, given its new edge vertices v and the
+// (optional) positions of its interior vertices
 static MTriangle *setHighOrder(MTriangle *t, GFace *gf,
-                               edgeContainer &edgeVertices,
+                               std::vector<MVertex *> &v,
                                faceContainer &faceVertices, bool linear,
-                               bool incomplete, int nPts)
+                               bool incomplete, int nPts,
+                               const std::vector<double> *points)
 {
-  std::vector<MVertex *> v;
-  getEdgeVertices(gf, t, v, edgeVertices, linear, nPts);
   if(nPts == 1) {
     return new MTriangle6(t->getVertex(0), t->getVertex(1), t->getVertex(2),
                           v[0], v[1], v[2], 0, t->getPartition());
   }
   else {
-    if(!incomplete) getFaceVertices(gf, t, v, faceVertices, linear, nPts);
+    if(!incomplete)
+      getFaceVertices(gf, t, v, faceVertices, linear, nPts, points);
     return new MTriangleN(t->getVertex(0), t->getVertex(1), t->getVertex(2), v,
                           nPts + 1, 0, t->getPartition());
   }
 }
 
+// Create a high-order quadrangle, given its new edge vertices v and the
+// (optional) positions of its interior vertices
 static MQuadrangle *setHighOrder(MQuadrangle *q, GFace *gf,
-                                 edgeContainer &edgeVertices,
+                                 std::vector<MVertex *> &v,
                                  faceContainer &faceVertices, bool linear,
-                                 bool incomplete, int nPts)
+                                 bool incomplete, int nPts,
+                                 const std::vector<double> *points)
 {
-  std::vector<MVertex *> v;
-  getEdgeVertices(gf, q, v, edgeVertices, linear, nPts);
   if(incomplete) {
     if(nPts == 1) {
       return new MQuadrangle8(q->getVertex(0), q->getVertex(1), q->getVertex(2),
@@ -985,7 +1102,7 @@ static MQuadrangle *setHighOrder(MQuadrangle *q, GFace *gf,
     }
   }
   else {
-    getFaceVertices(gf, q, v, faceVertices, linear, nPts);
+    getFaceVertices(gf, q, v, faceVertices, linear, nPts, points);
     if(nPts == 1) {
       return new MQuadrangle9(q->getVertex(0), q->getVertex(1), q->getVertex(2),
                               q->getVertex(3), v[0], v[1], v[2], v[3], v[4], 0,
@@ -1003,21 +1120,72 @@ static void setHighOrder(GFace *gf, edgeContainer &edgeVertices,
                          faceContainer &faceVertices, bool linear,
                          bool incomplete, int nPts = 1)
 {
+  const std::size_t nTri = gf->triangles.size();
+  const std::size_t nQua = gf->quadrangles.size();
+  std::vector<MElement *> elements(nTri + nQua);
+  for(std::size_t i = 0; i < nTri; i++) elements[i] = gf->triangles[i];
+  for(std::size_t i = 0; i < nQua; i++) elements[nTri + i] = gf->quadrangles[i];
+  const bool onGeo = !linear && gf->haveParametrization();
+
+  // compute the positions of the new vertices of the mesh edges that are not
+  // on the curves in parallel, in the order in which they are created
+  edgePoints points;
+  if(onGeo) {
+    std::vector<std::pair<MVertex *, MVertex *> > edges;
+    std::set<std::pair<MVertex *, MVertex *> > done;
+    for(std::size_t i = 0; i < elements.size(); i++) {
+      for(int j = 0; j < elements[i]->getNumEdges(); j++) {
+        std::vector<MVertex *> veOld;
+        elements[i]->getEdgeVertices(j, veOld);
+        MVertex *vMin, *vMax;
+        getMinMaxVert(veOld[0], veOld[1], vMin, vMax);
+        std::pair<MVertex *, MVertex *> p(vMin, vMax);
+        if(!edgeVertices.count(p) && done.insert(p).second)
+          edges.push_back(std::make_pair(veOld[0], veOld[1]));
+      }
+    }
+    computeEdgePoints(gf, edges, nPts, points);
+  }
+
+  // create the edge vertices
+  std::vector<std::vector<MVertex *> > v(elements.size());
+  for(std::size_t i = 0; i < elements.size(); i++)
+    getEdgeVertices(gf, elements[i], v[i], edgeVertices, linear, nPts,
+                    &points);
+
+  // compute the positions of the interior vertices in parallel
+  std::vector<std::vector<double> > facePoints(elements.size());
+  if(onGeo) {
+    // initialize the placement matrices before working in parallel
+    getInnerVertexPlacement(TYPE_TRI, nPts + 1);
+    getInnerVertexPlacement(TYPE_QUA, nPts + 1);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(long int i = 0; i < (long int)elements.size(); i++) {
+      // (second order triangles have no interior vertices)
+      bool tri = (i < (long int)nTri);
+      if(!incomplete && (!tri || nPts > 1))
+        getFacePointsOnGeo(gf, elements[i], v[i], nPts, facePoints[i]);
+    }
+  }
+
+  // create the interior vertices and the elements
   std::vector<MTriangle *> triangles2;
-  for(std::size_t i = 0; i < gf->triangles.size(); i++) {
+  for(std::size_t i = 0; i < nTri; i++) {
     MTriangle *t = gf->triangles[i];
-    MTriangle *tNew =
-      setHighOrder(t, gf, edgeVertices, faceVertices, linear, incomplete, nPts);
+    MTriangle *tNew = setHighOrder(t, gf, v[i], faceVertices, linear,
+                                   incomplete, nPts, &facePoints[i]);
     triangles2.push_back(tNew);
     delete t;
   }
   gf->triangles = triangles2;
 
   std::vector<MQuadrangle *> quadrangles2;
-  for(std::size_t i = 0; i < gf->quadrangles.size(); i++) {
+  for(std::size_t i = 0; i < nQua; i++) {
     MQuadrangle *q = gf->quadrangles[i];
-    MQuadrangle *qNew =
-      setHighOrder(q, gf, edgeVertices, faceVertices, linear, incomplete, nPts);
+    MQuadrangle *qNew = setHighOrder(q, gf, v[nTri + i], faceVertices, linear,
+                                     incomplete, nPts, &facePoints[nTri + i]);
     quadrangles2.push_back(qNew);
     delete q;
   }
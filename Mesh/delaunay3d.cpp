@@ -1303,7 +1303,12 @@ void delaunayTriangulation(const int numThreads, const int nptsatonce,
     _temp[v->getNum()] = mv;
   }
 
-  robustPredicates::exactinit(1, maxx, maxy, maxz);
+  // when volumes are meshed concurrently, the filters have been computed for
+  // all the nodes of the model beforehand (see MeshDelaunayVolumesInParallel)
+#if defined(_OPENMP)
+  if(!omp_in_parallel())
+#endif
+    robustPredicates::exactinit(1, maxx, maxy, maxz);
 
   Vert *box[8];
   delaunayTriangulation(numThreads, nptsatonce, _vertices, box, allocator);
@@ -2865,6 +2865,8 @@ void deMeshGFace::operator()(GFace *gf)
   gf->deleteMesh();
   gf->meshStatistics.status = GFace::PENDING;
   gf->meshStatistics.nbTriangle = gf->meshStatistics.nbEdge = 0;
+  gf->meshStatistics.nbInsertion = gf->meshStatistics.nbPointSearch = 0;
+  gf->meshStatistics.nbWalkFailure = gf->meshStatistics.nbLinearScan = 0;
 }
 
 static double TRIANGLE_VALIDITY(GFace *gf, MTriangle *t)
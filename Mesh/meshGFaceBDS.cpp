@@ -168,8 +168,8 @@ static int edgeSwapTest(GFace *gf, BDS_Edge *e)
 static bool neighboringModified(BDS_Point *p)
 {
   if(p->config_modified) return true;
-  std::vector<BDS_Edge *>::iterator it = p->edges.begin();
-  std::vector<BDS_Edge *>::iterator ite = p->edges.end();
+  BDS_Point::edgeContainer::iterator it = p->edges.begin();
+  BDS_Point::edgeContainer::iterator ite = p->edges.end();
   while(it != ite) {
     BDS_Point *o = (*it)->othervertex(p);
     if(o->config_modified) return true;
@@ -510,7 +510,7 @@ double getMaxLcWhenCollapsingEdge(GFace *gf, BDS_Mesh &m, BDS_Edge *e,
   BDS_Point *o = e->othervertex(p);
 
   double maxLc = 0.0;
-  std::vector<BDS_Edge *> edges(p->edges);
+  std::vector<BDS_Edge *> edges(p->edges.begin(), p->edges.end());
   std::vector<BDS_Edge *>::iterator eit = edges.begin();
   while(eit != edges.end()) {
     BDS_Point *newP1 = 0, *newP2 = 0;
@@ -613,8 +613,8 @@ computeNodalSizes(GFace *gf, BDS_Mesh &m,
 {
   std::set<BDS_Point *, PointLessThan>::iterator itp = m.points.begin();
   while(itp != m.points.end()) {
-    std::vector<BDS_Edge *>::iterator it = (*itp)->edges.begin();
-    std::vector<BDS_Edge *>::iterator ite = (*itp)->edges.end();
+    BDS_Point::edgeContainer::iterator it = (*itp)->edges.begin();
+    BDS_Point::edgeContainer::iterator ite = (*itp)->edges.end();
     double L = 0;
     int ne = 0;
     while(it != ite) {
@@ -677,8 +677,8 @@ computeNodalSizes(GFace *gf, BDS_Mesh &m,
     while(1) {
       bool allTouched = true;
       for(size_t i = 0; i < pts.size(); i++) {
-        std::vector<BDS_Edge *>::const_iterator it = pts[i]->edges.begin();
-        std::vector<BDS_Edge *>::const_iterator ite = pts[i]->edges.end();
+        BDS_Point::edgeContainer::const_iterator it = pts[i]->edges.begin();
+        BDS_Point::edgeContainer::const_iterator ite = pts[i]->edges.end();
         while(it != ite) {
           BDS_Point *p = (*it)->othervertex(pts[i]);
           if(p->lc() != MAX_LC) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <algorithm>
 #include <numeric>
+#include <new>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "OS.h"
@@ -393,7 +394,7 @@ int inCircumCircleAniso(GFace *gf, MTriangle *base, const double *uv,
 
 MTri3::MTri3(MTriangle *t, double lc, SMetric3 *metric, bidimMeshData *data,
              GFace *gf)
-  : deleted(false), base(t)
+  : deleted(false), base(t), heapIndex(-1)
 {
   neigh[0] = neigh[1] = neigh[2] = 0;
   double center[3];
@@ -535,12 +536,113 @@ void connectTriangles(std::vector<MTri3 *> &l)
   connectTris(l.begin(), l.end(), conn);
 }
 
-void connectTriangles(std::set<MTri3 *, compareTri3Ptr> &l)
+void connectTriangles(MTri3Pool &AllTris)
 {
+  std::vector<MTri3 *> l;
+  AllTris.getTriangles(l);
   std::vector<edgeXface> conn;
   connectTris(l.begin(), l.end(), conn);
 }
 
+MTri3 *MTri3Pool::create(MTriangle *t, double lc, SMetric3 *m,
+                         bidimMeshData *data, GFace *gf)
+{
+  MTri3 *slot;
+  if(_free.size()) {
+    slot = _free.back();
+    _free.pop_back();
+  }
+  else {
+    if(_numSlots == _blocks.size() * _blockSize)
+      _blocks.push_back(
+        static_cast<MTri3 *>(::operator new(_blockSize * sizeof(MTri3))));
+    slot = _blocks[_numSlots / _blockSize] + _numSlots % _blockSize;
+    _numSlots++;
+  }
+  return new(slot) MTri3(t, lc, m, data, gf);
+}
+
+void MTri3Pool::clear()
+{
+  for(std::size_t i = 0; i < _blocks.size(); i++) ::operator delete(_blocks[i]);
+  _blocks.clear();
+  _free.clear();
+  _numSlots = 0;
+}
+
+void MTri3Pool::getTriangles(std::vector<MTri3 *> &tris, bool sorted,
+                             bool withDeleted) const
+{
+  tris.clear();
+  tris.reserve(size());
+  for(std::size_t i = 0; i < _numSlots; i++) {
+    MTri3 *t = getSlot(i);
+    if(t && (withDeleted || !t->isDeleted())) tris.push_back(t);
+  }
+  if(sorted) std::sort(tris.begin(), tris.end(), compareTri3Ptr());
+}
+
+void MTri3Heap::_up(std::size_t i)
+{
+  MTri3 *t = _heap[i];
+  while(i) {
+    std::size_t parent = (i - 1) / 2;
+    if(!_before(t, _heap[parent])) break;
+    _set(i, _heap[parent]);
+    i = parent;
+  }
+  _set(i, t);
+}
+
+void MTri3Heap::_down(std::size_t i)
+{
+  MTri3 *t = _heap[i];
+  std::size_t n = _heap.size();
+  while(2 * i + 1 < n) {
+    std::size_t child = 2 * i + 1;
+    if(child + 1 < n && _before(_heap[child + 1], _heap[child])) child++;
+    if(!_before(_heap[child], t)) break;
+    _set(i, _heap[child]);
+    i = child;
+  }
+  _set(i, t);
+}
+
+void MTri3Heap::push(MTri3 *t)
+{
+  if(contains(t)) return;
+  _heap.push_back(t);
+  _up(_heap.size() - 1);
+}
+
+void MTri3Heap::erase(MTri3 *t)
+{
+  if(!contains(t)) return;
+  std::size_t i = t->heapIndex;
+  t->heapIndex = -1;
+  MTri3 *last = _heap.back();
+  _heap.pop_back();
+  if(i == _heap.size()) return;
+  _set(i, last);
+  update(last);
+}
+
+void MTri3Heap::update(MTri3 *t)
+{
+  if(!contains(t)) return;
+  std::size_t i = t->heapIndex;
+  if(i && _before(t, _heap[(i - 1) / 2]))
+    _up(i);
+  else
+    _down(i);
+}
+
+void MTri3Heap::clear()
+{
+  for(std::size_t i = 0; i < _heap.size(); i++) _heap[i]->heapIndex = -1;
+  _heap.clear();
+}
+
 static int inCircumCircleXY(MTriangle *t, MVertex *v)
 {
   MVertex *v1 = t->getVertex(0);
@@ -668,9 +770,9 @@ inline double getSurfUV(MTriangle *t, bidimMeshData &data)
 static int insertVertexB(std::list<edgeXface> &shell,
                          std::list<MTri3 *> &cavity, bool force, GFace *gf,
                          MVertex *v, double *param, MTri3 *t,
-                         std::set<MTri3 *, compareTri3Ptr> &allTets,
-                         std::set<MTri3 *, compareTri3Ptr> *activeTets,
-                         bidimMeshData &data, double *metric,
+                         MTri3Pool &allTets, MTri3Heap *worstTets,
+                         MTri3Heap *activeTets, bidimMeshData &data,
+                         double *metric,
                          MTri3 **oneNewTriangle,
                          bool verifyStarShapeness = true)
 {
@@ -721,8 +823,8 @@ static int insertVertexB(std::list<edgeXface> &shell,
                    data.vSizesBGM[index2]);
     double LL = std::min(lc, lcBGM);
 
-    MTri3 *t4 =
-      new MTri3(t, Extend1dMeshIn2dSurfaces(gf) ? LL : lcBGM, 0, &data, gf);
+    MTri3 *t4 = allTets.create(t, Extend1dMeshIn2dSurfaces(gf) ? LL : lcBGM,
+                               0, &data, gf);
 
     if(oneNewTriangle) {
       force = true;
@@ -771,16 +873,15 @@ static int insertVertexB(std::list<edgeXface> &shell,
   // of the point, and that the point is not too close to an edge
   if(std::abs(oldVolume - newVolume) < EPS * oldVolume && !onePointIsTooClose) {
     connectTris(new_cavity.begin(), new_cavity.end(), conn);
-    // 30 % of the time is spent here!
-    allTets.insert(newTris, newTris + shell.size());
+    if(worstTets) {
+      for(std::size_t i = 0; i < shell.size(); i++) worstTets->push(newTris[i]);
+    }
     if(activeTets) {
       for(std::vector<MTri3 *>::iterator i = new_cavity.begin();
           i != new_cavity.end(); ++i) {
         int active_edge;
-        if(isActive(*i, LIMIT_, active_edge) && (*i)->getRadius() > LIMIT_) {
-          if((*activeTets).find(*i) == (*activeTets).end())
-            (*activeTets).insert(*i);
-        }
+        if(isActive(*i, LIMIT_, active_edge) && (*i)->getRadius() > LIMIT_)
+          activeTets->push(*i);
       }
     }
     delete[] newTris;
@@ -797,7 +898,7 @@ static int insertVertexB(std::list<edgeXface> &shell,
     // Us, Vs, false);
     for(std::size_t i = 0; i < shell.size(); i++) {
       delete newTris[i]->tri();
-      delete newTris[i];
+      allTets.release(newTris[i]);
     }
     delete[] newTris;
 
@@ -856,14 +957,129 @@ static MTri3 *search4Triangle(MTri3 *t, MVertex *v, int maxx, int &ITER)
   return 0;
 }
 
-static MTri3 *search4Triangle(MTri3 *t, double pt[2], bidimMeshData &data,
-                              std::set<MTri3 *, compareTri3Ptr> &AllTris,
-                              double uv[2], bool force = false)
+// Point location helper for the insertion algorithms: a uniform grid in the
+// parametric plane storing, in each cell, a recently created triangle whose
+// barycenter lies in the cell. When the walk from the seed triangle fails
+// (e.g. in non-convex parametric domains), the search is restarted from the
+// triangles stored in the cells closest to the point, instead of scanning all
+// the triangles. Triangles must be removed from the grid before being freed.
+// The locator also counts the insertions and the point location failures.
+class triangleLocator {
+private:
+  double _umin, _vmin, _du, _dv;
+  int _nu, _nv;
+  std::vector<MTri3 *> _cells;
+  int _cell(const double pt[2], int &i, int &j) const
+  {
+    i = std::max(0, std::min(_nu - 1, (int)((pt[0] - _umin) / _du)));
+    j = std::max(0, std::min(_nv - 1, (int)((pt[1] - _vmin) / _dv)));
+    return i + _nu * j;
+  }
+  int _cell(MTri3 *t, bidimMeshData &data) const
+  {
+    double c[2] = {0., 0.};
+    for(int k = 0; k < 3; k++) {
+      int index = data.getIndex(t->tri()->getVertex(k));
+      c[0] += data.Us[index] / 3.;
+      c[1] += data.Vs[index] / 3.;
+    }
+    int i, j;
+    return _cell(c, i, j);
+  }
+
+public:
+  std::size_t numInsertions, numAttempts, numSearches, numWalkFailures,
+    numGridHits, numLinearScans;
+  triangleLocator()
+    : _umin(0.), _vmin(0.), _du(1.), _dv(1.), _nu(0), _nv(0), numInsertions(0),
+      numAttempts(0), numSearches(0), numWalkFailures(0), numGridHits(0),
+      numLinearScans(0)
+  {
+  }
+  // create the grid for about numPoints points, and store the triangles
+  void initialize(MTri3Pool &AllTris, bidimMeshData &data,
+                  std::size_t numPoints)
+  {
+    if(data.Us.empty()) return;
+    double umax = data.Us[0], vmax = data.Vs[0];
+    _umin = umax;
+    _vmin = vmax;
+    for(std::size_t i = 1; i < data.Us.size(); i++) {
+      _umin = std::min(_umin, data.Us[i]);
+      _vmin = std::min(_vmin, data.Vs[i]);
+      umax = std::max(umax, data.Us[i]);
+      vmax = std::max(vmax, data.Vs[i]);
+    }
+    double lu = std::max(umax - _umin, 1.e-12 * (vmax - _vmin));
+    double lv = std::max(vmax - _vmin, 1.e-12 * (umax - _umin));
+    if(lu <= 0. || lv <= 0.) return;
+    // about 2 points per cell, with (almost) square cells
+    double n = std::max(1., std::min(0.5 * numPoints, 1.e7));
+    double h = std::sqrt(lu * lv / n);
+    _nu = std::max(1, std::min((int)(lu / h) + 1, (int)n));
+    _nv = std::max(1, std::min((int)(lv / h) + 1, (int)n));
+    _du = lu / _nu;
+    _dv = lv / _nv;
+    _cells.assign(_nu * _nv, (MTri3 *)0);
+    for(std::size_t i = 0; i < AllTris.getNumSlots(); i++) {
+      MTri3 *t = AllTris.getSlot(i);
+      if(t && !t->isDeleted()) add(t, data);
+    }
+  }
+  bool empty() const { return _cells.empty(); }
+  void add(MTri3 *t, bidimMeshData &data)
+  {
+    if(!_cells.empty()) _cells[_cell(t, data)] = t;
+  }
+  void remove(MTri3 *t, bidimMeshData &data)
+  {
+    if(_cells.empty()) return;
+    int c = _cell(t, data);
+    if(_cells[c] == t) _cells[c] = 0;
+  }
+  // get the (non-deleted) triangles in the cells around the point, by
+  // increasing distance, up to maxNum triangles
+  void seeds(const double pt[2], std::size_t maxNum,
+             std::vector<MTri3 *> &s) const
+  {
+    s.clear();
+    if(_cells.empty()) return;
+    int i0, j0;
+    _cell(pt, i0, j0);
+    int maxRing = std::max(_nu, _nv);
+    for(int r = 0; r < maxRing && s.size() < maxNum; r++) {
+      for(int j = j0 - r; j <= j0 + r; j++) {
+        if(j < 0 || j >= _nv) continue;
+        int step = (j == j0 - r || j == j0 + r) ? 1 : 2 * r;
+        for(int i = i0 - r; i <= i0 + r; i += std::max(1, step)) {
+          if(i < 0 || i >= _nu) continue;
+          MTri3 *t = _cells[i + _nu * j];
+          if(t && !t->isDeleted()) s.push_back(t);
+        }
+      }
+    }
+  }
+  void report(GFace *gf) const
+  {
+    gf->meshStatistics.nbInsertion = numInsertions;
+    gf->meshStatistics.nbPointSearch = numSearches;
+    gf->meshStatistics.nbWalkFailure = numWalkFailures;
+    gf->meshStatistics.nbLinearScan = numLinearScans;
+    Msg::Debug("Surface %d: %lu points inserted (%lu attempts), %lu point "
+               "searches, %lu walk failures (%g%%), %lu resolved with the grid, "
+               "%lu linear scans",
+               gf->tag(), numInsertions, numAttempts, numSearches,
+               numWalkFailures,
+               numSearches ? 100. * numWalkFailures / numSearches : 0.,
+               numGridHits, numLinearScans);
+  }
+};
+
+// walk from triangle t towards the point pt, for at most maxIter steps
+static MTri3 *walk4Triangle(MTri3 *t, double pt[2], bidimMeshData &data,
+                            double uv[2], int maxIter)
 {
-  // bool inside = t->inCircumCircle(pt);
-  bool inside = invMapUV(t->tri(), pt, data, uv, 1.e-8);
-
-  if(inside) return t;
+  if(invMapUV(t->tri(), pt, data, uv, 1.e-8)) return t;
   SPoint3 q1(pt[0], pt[1], 0);
   int ITER = 0;
   while(1) {
@@ -880,48 +1096,62 @@ static MTri3 *search4Triangle(MTri3 *t, double pt[2], bidimMeshData &data,
       SPoint3 p2(data.Us[i2], data.Vs[i2], 0);
       if(intersection_segments_2(p1, p2, q1, q2)) break;
     }
-    if(i >= 3) {
-      printf("impossible\n");
-      break;
-    }
+    if(i >= 3) break;
     t = t->getNeigh(i);
     if(!t) break;
-    bool inside = invMapUV(t->tri(), pt, data, uv, 1.e-8);
-    if(inside) return t;
-    if(ITER++ > (int)AllTris.size()) break;
+    if(invMapUV(t->tri(), pt, data, uv, 1.e-8)) return t;
+    if(ITER++ > maxIter) break;
   }
+  return 0;
+}
+
+static MTri3 *search4Triangle(MTri3 *t, double pt[2], bidimMeshData &data,
+                              MTri3Pool &AllTris, double uv[2],
+                              bool force = false,
+                              triangleLocator *locator = 0)
+{
+  if(locator) locator->numSearches++;
+  MTri3 *found = walk4Triangle(t, pt, data, uv, (int)AllTris.size());
+  if(found) return found;
+  if(locator) locator->numWalkFailures++;
 
   if(!force) return 0; // FIXME: removing this leads to horrible performance
 
-  for(std::set<MTri3 *, compareTri3Ptr>::iterator itx = AllTris.begin();
-      itx != AllTris.end(); ++itx) {
-    if(!(*itx)->isDeleted()) {
-      inside = invMapUV((*itx)->tri(), pt, data, uv, 1.e-8);
-      if(inside) { return *itx; }
+  // restart the walk from the triangles stored in the grid around the point
+  if(locator && !locator->empty()) {
+    std::vector<MTri3 *> seeds;
+    locator->seeds(pt, 16, seeds);
+    for(std::size_t i = 0; i < seeds.size(); i++) {
+      found = walk4Triangle(seeds[i], pt, data, uv, 100);
+      if(found) {
+        locator->numGridHits++;
+        return found;
+      }
+    }
+  }
+
+  if(locator) locator->numLinearScans++;
+  for(std::size_t i = 0; i < AllTris.getNumSlots(); i++) {
+    MTri3 *tx = AllTris.getSlot(i);
+    if(tx && !tx->isDeleted()) {
+      if(invMapUV(tx->tri(), pt, data, uv, 1.e-8)) { return tx; }
     }
   }
   printf("argh %g %g!!!!\n", pt[0], pt[1]);
   return 0;
 }
 
-static bool insertAPoint(GFace *gf,
-                         std::set<MTri3 *, compareTri3Ptr>::iterator it,
-                         double center[2], double metric[3],
-                         bidimMeshData &data,
-                         std::set<MTri3 *, compareTri3Ptr> &AllTris,
-                         std::set<MTri3 *, compareTri3Ptr> *ActiveTris = 0,
-                         MTri3 *worst = 0, MTri3 **oneNewTriangle = 0,
-                         bool testStarShapeness = false)
+// insert a point in the cavity of the triangle "worst" (or in the cavity of
+// the triangle containing it); the new triangles are added to WorstTris, and
+// the active ones to ActiveTris
+static bool insertAPoint(GFace *gf, MTri3 *worst, double center[2],
+                         double metric[3], bidimMeshData &data,
+                         MTri3Pool &AllTris, MTri3Heap *WorstTris,
+                         MTri3Heap *ActiveTris = 0, MTri3 **oneNewTriangle = 0,
+                         bool testStarShapeness = false,
+                         triangleLocator *locator = 0)
 {
-  if(worst) {
-    it = AllTris.find(worst);
-    if(worst != *it) {
-      Msg::Error("Could not insert point");
-      return false;
-    }
-  }
-  else
-    worst = *it;
+  if(locator) locator->numAttempts++;
 
   MTri3 *ptin = 0;
   std::list<edgeXface> shell;
@@ -941,7 +1171,7 @@ static bool insertAPoint(GFace *gf,
   }
   else {
     ptin = search4Triangle(worst, center, data, AllTris, uv,
-                           oneNewTriangle ? true : false);
+                           oneNewTriangle ? true : false, locator);
     if(ptin) {
       recurFindCavityAniso(gf, shell, cavity, metric, center, ptin, data);
     }
@@ -969,9 +1199,10 @@ static bool insertAPoint(GFace *gf,
 
     int result = -9;
     if(p.succeeded()) {
-      result = insertVertexB(shell, cavity, false, gf, v, center, ptin, AllTris,
-                             ActiveTris, data, metric, oneNewTriangle,
-                             testStarShapeness);
+      result =
+        insertVertexB(shell, cavity, false, gf, v, center, ptin, AllTris,
+                      WorstTris, ActiveTris, data, metric, oneNewTriangle,
+                      testStarShapeness);
     }
     if(result != 1) {
       if(result == -1)
@@ -994,9 +1225,9 @@ static bool insertAPoint(GFace *gf,
                    "parametric domain)",
                    center[0], center[1]);
 
-      AllTris.erase(it);
       worst->forceRadius(-1);
-      AllTris.insert(worst);
+      if(WorstTris) WorstTris->update(worst);
+      if(ActiveTris) ActiveTris->update(worst);
       delete v;
       for(std::list<MTri3 *>::iterator itc = cavity.begin();
           itc != cavity.end(); ++itc)
@@ -1005,6 +1236,11 @@ static bool insertAPoint(GFace *gf,
     }
     else {
       gf->mesh_vertices.push_back(v);
+      if(locator) {
+        locator->numInsertions++;
+        if(oneNewTriangle && *oneNewTriangle)
+          locator->add(*oneNewTriangle, data);
+      }
       return true;
     }
   }
@@ -1012,9 +1248,9 @@ static bool insertAPoint(GFace *gf,
     for(std::list<MTri3 *>::iterator itc = cavity.begin(); itc != cavity.end();
         ++itc)
       (*itc)->setDeleted(false);
-    AllTris.erase(it);
     worst->forceRadius(0);
-    AllTris.insert(worst);
+    if(WorstTris) WorstTris->update(worst);
+    if(ActiveTris) ActiveTris->update(worst);
     return false;
   }
 }
@@ -1023,7 +1259,7 @@ void bowyerWatson(GFace *gf, int MAXPNT,
                   std::map<MVertex *, MVertex *> *equivalence,
                   std::map<MVertex *, SPoint2> *parametricCoordinates)
 {
-  std::set<MTri3 *, compareTri3Ptr> AllTris;
+  MTri3Pool AllTris;
   bidimMeshData DATA(equivalence, parametricCoordinates);
 
   if(!buildMeshGenerationDataStructures(gf, AllTris, DATA)) {
@@ -1036,14 +1272,21 @@ void bowyerWatson(GFace *gf, int MAXPNT,
     return;
   }
 
+  // all the triangles, worst (largest radius) first
+  MTri3Heap WorstTris;
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris);
+  for(std::size_t i = 0; i < tris.size(); i++) WorstTris.push(tris[i]);
+
+  triangleLocator locator;
   int ITER = 0;
   int NBDELETED = 0;
-  while(1) {
-    MTri3 *worst = *AllTris.begin();
+  while(!WorstTris.empty()) {
+    MTri3 *worst = WorstTris.top();
     if(worst->isDeleted()) {
+      WorstTris.pop();
       delete worst->tri();
-      delete worst;
-      AllTris.erase(AllTris.begin());
+      AllTris.release(worst);
       NBDELETED++;
     }
     else {
@@ -1069,9 +1312,11 @@ void bowyerWatson(GFace *gf, int MAXPNT,
 
       buildMetric(gf, pa, metric);
       circumCenterMetric(worst->tri(), metric, DATA, center, r2);
-      insertAPoint(gf, AllTris.begin(), center, metric, DATA, AllTris);
+      insertAPoint(gf, worst, center, metric, DATA, AllTris, &WorstTris, 0, 0,
+                   false, &locator);
     }
   }
+  locator.report(gf);
   splitElementsInBoundaryLayerIfNeeded(gf);
   transferDataStructure(gf, AllTris, DATA);
 }
@@ -1279,8 +1524,8 @@ void bowyerWatsonFrontal(GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
                          std::map<MVertex *, SPoint2> *parametricCoordinates,
                          std::vector<SPoint2> *true_boundary)
 {
-  std::set<MTri3 *, compareTri3Ptr> AllTris;
-  std::set<MTri3 *, compareTri3Ptr> ActiveTris;
+  MTri3Pool AllTris;
+  MTri3Heap ActiveTris;
   bidimMeshData DATA(equivalence, parametricCoordinates);
   bool testStarShapeness = true;
   SPoint3 c;
@@ -1294,11 +1539,12 @@ void bowyerWatsonFrontal(GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
 
   int ITER = 0, active_edge;
   // compute active triangle
-  std::set<MTri3 *, compareTri3Ptr>::iterator it = AllTris.begin();
-  for(; it != AllTris.end(); ++it) {
-    if(isActive(*it, LIMIT_, active_edge))
-      ActiveTris.insert(*it);
-    else if((*it)->getRadius() < LIMIT_)
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris, true);
+  for(std::size_t i = 0; i < tris.size(); i++) {
+    if(isActive(tris[i], LIMIT_, active_edge))
+      ActiveTris.push(tris[i]);
+    else if(tris[i]->getRadius() < LIMIT_)
       break;
   }
 
@@ -1307,6 +1553,7 @@ void bowyerWatsonFrontal(GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
   SPoint2 FAR(2 * RU.high(), 2 * RV.high());
 
   // insert points
+  triangleLocator locator;
   int ITERATION = 0;
   while(1) {
     ++ITERATION;
@@ -1322,8 +1569,8 @@ void bowyerWatsonFrontal(GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
 
     // printf("%d active tris \n",ActiveTris.size());
     if(!ActiveTris.size()) break;
-    MTri3 *worst = (*ActiveTris.begin());
-    ActiveTris.erase(ActiveTris.begin());
+    MTri3 *worst = ActiveTris.top();
+    ActiveTris.pop();
 
     if(!worst->isDeleted() && isActive(worst, LIMIT_, active_edge) &&
        worst->getRadius() > LIMIT_) {
@@ -1337,12 +1584,13 @@ void bowyerWatsonFrontal(GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
         int nnnn;
         if(!true_boundary ||
            pointInsideParametricDomain(*true_boundary, NP, FAR, nnnn))
-          insertAPoint(gf, AllTris.end(), newPoint, metric, DATA, AllTris,
-                       &ActiveTris, worst, NULL, testStarShapeness);
+          insertAPoint(gf, worst, newPoint, metric, DATA, AllTris, 0,
+                       &ActiveTris, NULL, testStarShapeness, &locator);
       }
     }
   }
 
+  locator.report(gf);
   transferDataStructure(gf, AllTris, DATA);
 
   splitElementsInBoundaryLayerIfNeeded(gf);
@@ -1482,8 +1730,8 @@ void bowyerWatsonFrontalLayers(
   GFace *gf, bool quad, std::map<MVertex *, MVertex *> *equivalence,
   std::map<MVertex *, SPoint2> *parametricCoordinates)
 {
-  std::set<MTri3 *, compareTri3Ptr> AllTris;
-  std::set<MTri3 *, compareTri3Ptr> ActiveTris;
+  MTri3Pool AllTris;
+  MTri3Heap ActiveTris;
   bidimMeshData DATA(equivalence, parametricCoordinates);
 
   if(quad) {
@@ -1499,18 +1747,20 @@ void bowyerWatsonFrontalLayers(
 
   int ITER = 0, active_edge;
   // compute active triangle
-  std::set<MTri3 *, compareTri3Ptr>::iterator it = AllTris.begin();
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris, true);
   std::set<MEdge, MEdgeLessThan> _front;
-  for(; it != AllTris.end(); ++it) {
-    if(isActive(*it, LIMIT_, active_edge)) {
-      ActiveTris.insert(*it);
-      updateActiveEdges(*it, LIMIT_, _front);
+  for(std::size_t i = 0; i < tris.size(); i++) {
+    if(isActive(tris[i], LIMIT_, active_edge)) {
+      ActiveTris.push(tris[i]);
+      updateActiveEdges(tris[i], LIMIT_, _front);
     }
-    else if((*it)->getRadius() < LIMIT_)
+    else if(tris[i]->getRadius() < LIMIT_)
       break;
   }
 
   // insert points
+  triangleLocator locator;
   int ITERATION = 1;
   int max_layers = quad ? 10000 : 4;
   while(1) {
@@ -1523,7 +1773,7 @@ void bowyerWatsonFrontalLayers(
     //   _printTris (name, ActiveTris.begin(),  ActiveTris.end(),DATA,true);
     // }
 
-    std::set<MTri3 *, compareTri3Ptr> ActiveTrisNotInFront;
+    std::vector<MTri3 *> ActiveTrisNotInFront;
 
     // printf("%d active triangles\n",ActiveTris.size());
 
@@ -1536,11 +1786,8 @@ void bowyerWatsonFrontalLayers(
            _printTris (name, AllTris, Us,Vs,true);
          }
       */
-      std::set<MTri3 *, compareTri3Ptr>::iterator WORST_ITER =
-        ActiveTris.begin();
-
-      MTri3 *worst = (*WORST_ITER);
-      ActiveTris.erase(WORST_ITER);
+      MTri3 *worst = ActiveTris.top();
+      ActiveTris.pop();
       if(!worst->isDeleted() &&
          (ITERATION > max_layers ?
             isActive(worst, LIMIT_, active_edge) :
@@ -1563,8 +1810,8 @@ void bowyerWatsonFrontalLayers(
         else
           optimalPointFrontalB(gf, worst, active_edge, DATA, newPoint, metric);
 
-        insertAPoint(gf, AllTris.end(), newPoint, 0, DATA, AllTris, &ActiveTris,
-                     worst);
+        insertAPoint(gf, worst, newPoint, 0, DATA, AllTris, 0, &ActiveTris, 0,
+                     false, &locator);
         // else if (!worst->isDeleted() && worst->getRadius() > LIMIT_){
         //   ActiveTrisNotInFront.insert(worst);
         // }
@@ -1578,15 +1825,15 @@ void bowyerWatsonFrontalLayers(
          */
       }
       else if(!worst->isDeleted() && worst->getRadius() > LIMIT_) {
-        ActiveTrisNotInFront.insert(worst);
+        ActiveTrisNotInFront.push_back(worst);
       }
     }
     _front.clear();
-    it = ActiveTrisNotInFront.begin();
-    for(; it != ActiveTrisNotInFront.end(); ++it) {
-      if((*it)->getRadius() > LIMIT_ && isActive(*it, LIMIT_, active_edge)) {
-        ActiveTris.insert(*it);
-        updateActiveEdges(*it, LIMIT_, _front);
+    for(std::size_t i = 0; i < ActiveTrisNotInFront.size(); i++) {
+      MTri3 *t = ActiveTrisNotInFront[i];
+      if(t->getRadius() > LIMIT_ && isActive(t, LIMIT_, active_edge)) {
+        ActiveTris.push(t);
+        updateActiveEdges(t, LIMIT_, _front);
       }
     }
     // Msg::Info("%d active tris %d front edges %d not in front",
@@ -1594,6 +1841,7 @@ void bowyerWatsonFrontalLayers(
     if(!ActiveTris.size()) break;
   }
 
+  locator.report(gf);
   transferDataStructure(gf, AllTris, DATA);
   MTri3::radiusNorm = 2;
   LIMIT_ = 0.5 * std::sqrt(2.0) * 1;
@@ -1603,11 +1851,42 @@ void bowyerWatsonFrontalLayers(
   splitElementsInBoundaryLayerIfNeeded(gf);
 }
 
+// triangle with the largest radius that is not deleted; the deleted triangles
+// found on top of the heap are released
+static MTri3 *worstTriangle(MTri3Pool &AllTris, MTri3Heap &WorstTris,
+                            bidimMeshData &DATA, triangleLocator &locator)
+{
+  while(!WorstTris.empty()) {
+    MTri3 *t = WorstTris.top();
+    if(!t->isDeleted()) return t;
+    WorstTris.pop();
+    locator.remove(t, DATA);
+    delete t->tri();
+    AllTris.release(t);
+  }
+  return 0;
+}
+
+static void releaseDeletedTriangles(MTri3Pool &AllTris, MTri3Heap &WorstTris,
+                                    bidimMeshData &DATA,
+                                    triangleLocator &locator)
+{
+  for(std::size_t i = 0; i < AllTris.getNumSlots(); i++) {
+    MTri3 *t = AllTris.getSlot(i);
+    if(t && t->isDeleted()) {
+      WorstTris.erase(t);
+      locator.remove(t, DATA);
+      delete t->tri();
+      AllTris.release(t);
+    }
+  }
+}
+
 void bowyerWatsonParallelograms(
   GFace *gf, std::map<MVertex *, MVertex *> *equivalence,
   std::map<MVertex *, SPoint2> *parametricCoordinates)
 {
-  std::set<MTri3 *, compareTri3Ptr> AllTris;
+  MTri3Pool AllTris;
   bidimMeshData DATA(equivalence, parametricCoordinates);
   std::vector<MVertex *> packed;
   std::vector<SMetric3> metrics;
@@ -1631,41 +1910,39 @@ void bowyerWatsonParallelograms(
   // std::sort(packed.begin(), packed.end(), MVertexPtrLessThanLexicographic());
   SortHilbert(packed);
 
-  MTri3 *oneNewTriangle = 0;
-  for(std::size_t i = 0; i < packed.size();) {
-    MTri3 *worst = *AllTris.begin();
-    if(worst->isDeleted()) {
-      delete worst->tri();
-      delete worst;
-      AllTris.erase(AllTris.begin());
-    }
-    else {
-      double newPoint[2];
-      packed[i]->getParameter(0, newPoint[0]);
-      packed[i]->getParameter(1, newPoint[1]);
-      delete packed[i];
-      double metric[3];
-      buildMetric(gf, newPoint, metric);
-
-      bool success = insertAPoint(gf, AllTris.begin(), newPoint, metric, DATA,
-                                  AllTris, 0, oneNewTriangle, &oneNewTriangle);
-      if(!success) oneNewTriangle = 0;
-      i++;
-    }
-
-    if(1.0 * AllTris.size() > 2.5 * DATA.vSizes.size()) {
-      std::set<MTri3 *, compareTri3Ptr>::iterator itd = AllTris.begin();
-      while(itd != AllTris.end()) {
-        if((*itd)->isDeleted()) {
-          delete *itd;
-          AllTris.erase(itd++);
-        }
-        else
-          itd++;
-      }
-    }
-  }
+  // the seed triangle is the last one created or, when the previous insertion
+  // failed, the one with the largest radius, which are not always close to the
+  // new point: use the grid of the locator when the walk fails
+  triangleLocator locator;
+  locator.initialize(AllTris, DATA, DATA.Us.size() + packed.size());
+  MTri3Heap WorstTris;
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris);
+  for(std::size_t i = 0; i < tris.size(); i++) WorstTris.push(tris[i]);
 
+  MTri3 *oneNewTriangle = 0;
+  for(std::size_t i = 0; i < packed.size(); i++) {
+    double newPoint[2];
+    packed[i]->getParameter(0, newPoint[0]);
+    packed[i]->getParameter(1, newPoint[1]);
+    delete packed[i];
+    double metric[3];
+    buildMetric(gf, newPoint, metric);
+
+    MTri3 *seed = oneNewTriangle ? oneNewTriangle :
+                                   worstTriangle(AllTris, WorstTris, DATA,
+                                                 locator);
+    if(!seed) break;
+    bool success =
+      insertAPoint(gf, seed, newPoint, metric, DATA, AllTris, &WorstTris, 0,
+                   &oneNewTriangle, false, &locator);
+    if(!success) oneNewTriangle = 0;
+
+    if(1.0 * AllTris.size() > 2.5 * DATA.vSizes.size())
+      releaseDeletedTriangles(AllTris, WorstTris, DATA, locator);
+  }
+
+  locator.report(gf);
   transferDataStructure(gf, AllTris, DATA);
   backgroundMesh::unset();
 
@@ -1677,7 +1954,7 @@ void bowyerWatsonParallelogramsConstrained(
   std::map<MVertex *, MVertex *> *equivalence,
   std::map<MVertex *, SPoint2> *parametricCoordinates)
 {
-  std::set<MTri3 *, compareTri3Ptr> AllTris;
+  MTri3Pool AllTris;
   bidimMeshData DATA(equivalence, parametricCoordinates);
   std::vector<MVertex *> packed;
   std::vector<SMetric3> metrics;
@@ -1695,41 +1972,39 @@ void bowyerWatsonParallelogramsConstrained(
 
   std::sort(packed.begin(), packed.end(), MVertexPtrLessThanLexicographic());
 
-  MTri3 *oneNewTriangle = 0;
-  for(std::size_t i = 0; i < packed.size();) {
-    MTri3 *worst = *AllTris.begin();
-    if(worst->isDeleted()) {
-      delete worst->tri();
-      delete worst;
-      AllTris.erase(AllTris.begin());
-    }
-    else {
-      double newPoint[2];
-      packed[i]->getParameter(0, newPoint[0]);
-      packed[i]->getParameter(1, newPoint[1]);
-      delete packed[i];
-      double metric[3];
-      buildMetric(gf, newPoint, metric);
-
-      bool success = insertAPoint(gf, AllTris.begin(), newPoint, metric, DATA,
-                                  AllTris, 0, oneNewTriangle, &oneNewTriangle);
-      if(!success) oneNewTriangle = 0;
-      i++;
-    }
-
-    if(1.0 * AllTris.size() > 2.5 * DATA.vSizes.size()) {
-      std::set<MTri3 *, compareTri3Ptr>::iterator itd = AllTris.begin();
-      while(itd != AllTris.end()) {
-        if((*itd)->isDeleted()) {
-          delete *itd;
-          AllTris.erase(itd++);
-        }
-        else
-          itd++;
-      }
-    }
-  }
+  // the seed triangle is the last one created or, when the previous insertion
+  // failed, the one with the largest radius, which are not always close to the
+  // new point: use the grid of the locator when the walk fails
+  triangleLocator locator;
+  locator.initialize(AllTris, DATA, DATA.Us.size() + packed.size());
+  MTri3Heap WorstTris;
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris);
+  for(std::size_t i = 0; i < tris.size(); i++) WorstTris.push(tris[i]);
 
+  MTri3 *oneNewTriangle = 0;
+  for(std::size_t i = 0; i < packed.size(); i++) {
+    double newPoint[2];
+    packed[i]->getParameter(0, newPoint[0]);
+    packed[i]->getParameter(1, newPoint[1]);
+    delete packed[i];
+    double metric[3];
+    buildMetric(gf, newPoint, metric);
+
+    MTri3 *seed = oneNewTriangle ? oneNewTriangle :
+                                   worstTriangle(AllTris, WorstTris, DATA,
+                                                 locator);
+    if(!seed) break;
+    bool success =
+      insertAPoint(gf, seed, newPoint, metric, DATA, AllTris, &WorstTris, 0,
+                   &oneNewTriangle, false, &locator);
+    if(!success) oneNewTriangle = 0;
+
+    if(1.0 * AllTris.size() > 2.5 * DATA.vSizes.size())
+      releaseDeletedTriangles(AllTris, WorstTris, DATA, locator);
+  }
+
+  locator.report(gf);
   transferDataStructure(gf, AllTris, DATA);
   for(std::size_t i = 0; i < gf->getNumMeshVertices(); i++) {
     MVertex *vtest = gf->getMeshVertex(i);
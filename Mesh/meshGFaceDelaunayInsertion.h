@@ -14,6 +14,7 @@
 #include <list>
 #include <set>
 #include <map>
+#include <vector>
 
 class GModel;
 class GFace;
@@ -77,11 +78,15 @@ int inCircumCircleAniso(GFace *gf, MTriangle *base, const double *uv,
                         const double *metric, bidimMeshData &data);
 
 class MTri3 {
+  friend class MTri3Heap;
+
 protected:
   bool deleted;
   double circum_radius;
   MTriangle *base;
   MTri3 *neigh[3];
+  // position in the MTri3Heap containing the triangle, -1 if none
+  int heapIndex;
 
 public:
   /// 2 is euclidian norm, -1 is infinite norm  , 3 quality
@@ -144,9 +149,81 @@ public:
   }
 };
 
+// Block allocator for the MTri3 of the 2D Delaunay algorithms. Released MTri3
+// are recycled, and all the memory is freed when the pool is destroyed; the
+// MTriangles are not owned by the pool.
+class MTri3Pool {
+private:
+  std::vector<MTri3 *> _blocks;
+  std::vector<MTri3 *> _free;
+  std::size_t _numSlots;
+  static const std::size_t _blockSize = 4096;
+
+public:
+  MTri3Pool() : _numSlots(0) {}
+  ~MTri3Pool() { clear(); }
+  MTri3 *create(MTriangle *t, double lc, SMetric3 *m = 0,
+                bidimMeshData *data = 0, GFace *gf = 0);
+  void release(MTri3 *t)
+  {
+    t->setTri(0);
+    _free.push_back(t);
+  }
+  void clear();
+  // number of MTri3 in the pool (deleted or not)
+  std::size_t size() const { return _numSlots - _free.size(); }
+  bool empty() const { return size() == 0; }
+  // the MTri3 in slot i, for 0 <= i < getNumSlots(), or 0 if the slot is free
+  std::size_t getNumSlots() const { return _numSlots; }
+  MTri3 *getSlot(std::size_t i) const
+  {
+    MTri3 *t = _blocks[i / _blockSize] + i % _blockSize;
+    return t->tri() ? t : 0;
+  }
+  // get the MTri3 in the pool, ordered as with compareTri3Ptr if sorted is
+  // set; deleted MTri3 are only returned if withDeleted is set
+  void getTriangles(std::vector<MTri3 *> &tris, bool sorted = false,
+                    bool withDeleted = false) const;
+};
+
+// Indexed binary heap of MTri3, ordered as with compareTri3Ptr (i.e. with the
+// largest circumradius first). Each MTri3 stores its position in the heap, so
+// that it can be in at most one heap at a time, and can be removed or moved
+// after a change of its radius in O(log n).
+class MTri3Heap {
+private:
+  std::vector<MTri3 *> _heap;
+  compareTri3Ptr _before;
+  void _set(std::size_t i, MTri3 *t)
+  {
+    _heap[i] = t;
+    t->heapIndex = (int)i;
+  }
+  void _up(std::size_t i);
+  void _down(std::size_t i);
+
+public:
+  bool empty() const { return _heap.empty(); }
+  std::size_t size() const { return _heap.size(); }
+  MTri3 *top() const { return _heap.front(); }
+  bool contains(const MTri3 *t) const
+  {
+    return t->heapIndex >= 0 && t->heapIndex < (int)_heap.size() &&
+           _heap[t->heapIndex] == t;
+  }
+  // insert t, if it is not already in the heap
+  void push(MTri3 *t);
+  void pop() { erase(_heap.front()); }
+  // remove t, if it is in the heap
+  void erase(MTri3 *t);
+  // restore the order after a change of the radius of t
+  void update(MTri3 *t);
+  void clear();
+};
+
 void connectTriangles(std::list<MTri3 *> &);
 void connectTriangles(std::vector<MTri3 *> &);
-void connectTriangles(std::set<MTri3 *, compareTri3Ptr> &AllTris);
+void connectTriangles(MTri3Pool &AllTris);
 void bowyerWatson(GFace *gf, int MAXPNT = 1000000000,
                   std::map<MVertex *, MVertex *> *equivalence = 0,
                   std::map<MVertex *, SPoint2> *parametricCoordinates = 0);
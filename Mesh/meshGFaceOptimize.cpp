@@ -105,8 +105,8 @@ static void setLcs(MTriangle *t, std::map<MVertex *, double> &vSizes,
   }
 }
 
-bool buildMeshGenerationDataStructures(
-  GFace *gf, std::set<MTri3 *, compareTri3Ptr> &AllTris, bidimMeshData &data)
+bool buildMeshGenerationDataStructures(GFace *gf, MTri3Pool &AllTris,
+                                       bidimMeshData &data)
 {
   std::map<MVertex *, double> vSizesMap;
 
@@ -193,7 +193,7 @@ bool buildMeshGenerationDataStructures(
                     data.vSizesBGM[data.getIndex(gf->triangles[i]->getVertex(2))]);
 
     double LL = Extend1dMeshIn2dSurfaces(gf) ? std::min(lc, lcBGM) : lcBGM;
-    AllTris.insert(new MTri3(gf->triangles[i], LL, 0, &data, gf));
+    AllTris.create(gf->triangles[i], LL, 0, &data, gf);
   }
   gf->triangles.clear();
   connectTriangles(AllTris);
@@ -282,20 +282,18 @@ void splitEquivalentTriangles(GFace *gf, bidimMeshData &data)
   computeEquivalentTriangles(gf, data.equivalence);
 }
 
-void transferDataStructure(GFace *gf,
-                           std::set<MTri3 *, compareTri3Ptr> &AllTris,
-                           bidimMeshData &data)
+void transferDataStructure(GFace *gf, MTri3Pool &AllTris, bidimMeshData &data)
 {
-  while(1) {
-    if(AllTris.begin() == AllTris.end()) break;
-    MTri3 *worst = *AllTris.begin();
-    if(worst->isDeleted())
-      delete worst->tri();
+  // keep the triangles ordered by decreasing radius
+  std::vector<MTri3 *> tris;
+  AllTris.getTriangles(tris, true, true);
+  for(std::size_t i = 0; i < tris.size(); i++) {
+    if(tris[i]->isDeleted())
+      delete tris[i]->tri();
     else
-      gf->triangles.push_back(worst->tri());
-    delete worst;
-    AllTris.erase(AllTris.begin());
+      gf->triangles.push_back(tris[i]->tri());
   }
+  AllTris.clear();
 
   // make sure all the triangles are oriented in the same way in
   // parameter space (it would be nicer to change the actual algorithm
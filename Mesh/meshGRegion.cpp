@@ -150,8 +150,15 @@ void MeshDelaunayVolume(std::vector<GRegion *> &regions)
   std::vector<GVertex *> oldEmbVertices = gr->embeddedVertices();
   gr->embeddedVertices() = allEmbVertices;
 
+  // boundary recovery relies on global state (in the tetgen code, and for the
+  // random perturbation of the nodes): when volumes are meshed concurrently,
+  // recover their boundaries one at a time
   splitQuadRecovery sqr;
-  bool success = meshGRegionBoundaryRecovery(gr, &sqr);
+  bool success;
+#if defined(_OPENMP)
+#pragma omp critical(meshGRegionBoundaryRecovery)
+#endif
+  success = meshGRegionBoundaryRecovery(gr, &sqr);
 
   // sort triangles in all model faces in order to be able to search in vectors
   std::vector<GFace *>::iterator itf = allFaces.begin();
@@ -26,6 +26,11 @@
 #include "MTetrahedron.h"
 #include "Context.h"
 #include "OS.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #if !defined(HAVE_NO_STDINT_H)
 #include <stdint.h>
 #elif defined(HAVE_NO_INTPTR_T)
@@ -224,7 +229,18 @@ namespace tetgenBR {
 
     std::vector<MTetrahedron *> tets;
 
+    // when volumes are meshed concurrently (which is only done if no error
+    // has been raised before), ignore the errors raised by the other threads
+#if defined(_OPENMP)
+    int numErrors = Msg::GetThreadErrorCount();
+#endif
     delaunayMeshIn3D(_vertices, tets); // will add 8 MVertices at the end of _vertices
+#if defined(_OPENMP)
+    if(omp_in_parallel()) {
+      if(Msg::GetThreadErrorCount() > numErrors) return false;
+    }
+    else
+#endif
     if(Msg::GetErrorCount()) return false;
 
     Msg::Debug("Points have been tetrahedralized");
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -50,17 +51,31 @@ static HXTStatus nodalSizesCallBack(double *pts, uint32_t* volume,
   HXT_INFO("Mesh size callback %suse interpolated size", useInterpolatedSize ?
            "" : "does not ");
 
-  for(size_t i = 0; i < numPts; i++) {
-    GRegion *gr = (*allGR)[volume[i]];
-    double lc = std::min(lcGlob,
-                         BGM_MeshSizeWithoutScaling(gr, 0, 0,
-                                                    pts[4 * i + 0],
-                                                    pts[4 * i + 1],
-                                                    pts[4 * i + 2]));
-    if(useInterpolatedSize && pts[4 * i + 3] > 0.0)
-      pts[4 * i + 3] = std::min(pts[4 * i + 3], lc);
-    else
-      pts[4 * i + 3] = lc;
+  // sort the points by volume, so that the mesh size can be evaluated in
+  // batch in each volume
+  std::vector<std::vector<size_t> > pointsInVolume(allGR->size());
+  for(size_t i = 0; i < numPts; i++) pointsInVolume[volume[i]].push_back(i);
+
+  std::vector<double> xyz, lc;
+  for(size_t r = 0; r < allGR->size(); r++) {
+    const std::vector<size_t> &p = pointsInVolume[r];
+    if(p.empty()) continue;
+    xyz.resize(3 * p.size());
+    lc.resize(p.size());
+    for(size_t j = 0; j < p.size(); j++) {
+      xyz[3 * j + 0] = pts[4 * p[j] + 0];
+      xyz[3 * j + 1] = pts[4 * p[j] + 1];
+      xyz[3 * j + 2] = pts[4 * p[j] + 2];
+    }
+    BGM_MeshSizeWithoutScaling((*allGR)[r], p.size(), &xyz[0], &lc[0]);
+    for(size_t j = 0; j < p.size(); j++) {
+      size_t i = p[j];
+      double l = std::min(lcGlob, lc[j]);
+      if(useInterpolatedSize && pts[4 * i + 3] > 0.0)
+        pts[4 * i + 3] = std::min(pts[4 * i + 3], l);
+      else
+        pts[4 * i + 3] = l;
+    }
   }
 
   return HXT_STATUS_OK;
@@ -436,10 +451,17 @@ static HXTStatus _meshGRegionHxt(std::vector<GRegion *> &regions)
   std::vector<MVertex *> c2v;
   Gmsh2Hxt(regions, mesh, v2c, c2v);
 
+  // when several groups of volumes are meshed concurrently (see Mesh3D), each
+  // group is meshed sequentially
+  int numThreads = 0;
+#if defined(_OPENMP)
+  if(omp_in_parallel()) numThreads = 1;
+#endif
+
   HXTTetMeshOptions options = {
-    0, // int defaultThreads;
-    0, // int delaunayThreads;
-    0, // int improveThreads;
+    numThreads, // int defaultThreads;
+    numThreads, // int delaunayThreads;
+    numThreads, // int improveThreads;
     1, // int reproducible;
     (Msg::GetVerbosity() > 5) ? 2 : 1, // int verbosity;
     1, // int stat;
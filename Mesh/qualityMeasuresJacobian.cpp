@@ -4,6 +4,8 @@
 // bugs and problems to the public mailing list <gmsh@geuz.org>.
 
 #include <limits>
+#include <map>
+#include <atomic>
 #include "qualityMeasuresJacobian.h"
 #include "FuncSpaceData.h"
 #include "MElement.h"
@@ -241,6 +243,30 @@ static bool _getQualityFunctionSpace(MElement *el, FuncSpaceData &fsGrad,
 
 namespace jacobianBasedQuality {
 
+  // Bounds of the Jacobian determinant given its Lagrange coefficients, using
+  // the pool 0 of Bezier coefficients
+  static void _minMaxJacobianDeterminant(const JacobianBasis *jfs,
+                                         const fullVector<double> &coeffLag,
+                                         double &min, double &max, bool debug)
+  {
+    // Convert into Bezier coeff
+    bezierCoeff *bez = new bezierCoeff(jfs->getFuncSpaceData(), coeffLag, 0);
+
+    // Refine coefficients
+    std::vector<_coeffData *> domains(1, new _coeffDataJac(bez));
+    _subdivideDomains(domains, true, debug);
+
+    // Get extrema
+    min = std::numeric_limits<double>::max();
+    max = -min;
+    for(std::size_t i = 0; i < domains.size(); ++i) {
+      min = std::min(min, domains[i]->minB());
+      max = std::max(max, domains[i]->maxB());
+      domains[i]->deleteBezierCoeff();
+      delete domains[i];
+    }
+  }
+
   void minMaxJacobianDeterminant(MElement *el, double &min, double &max,
                                  const fullMatrix<double> *normals, bool debug)
   {
@@ -260,22 +286,89 @@ namespace jacobianBasedQuality {
     el->getNodesCoord(nodesXYZ);
     jfs->getSignedJacobian(nodesXYZ, coeffLag, normals);
 
-    // Convert into Bezier coeff
     bezierCoeff::usePools(static_cast<std::size_t>(coeffLag.size()), 0);
-    bezierCoeff *bez = new bezierCoeff(jfs->getFuncSpaceData(), coeffLag, 0);
+    _minMaxJacobianDeterminant(jfs, coeffLag, min, max, debug);
+  }
 
-    // Refine coefficients
-    std::vector<_coeffData *> domains(1, new _coeffDataJac(bez));
-    _subdivideDomains(domains, true, debug);
+  void minMaxJacobianDeterminant(const std::vector<MElement *> &elements,
+                                 std::vector<double> &min,
+                                 std::vector<double> &max,
+                                 const fullMatrix<double> *normals,
+                                 MsgProgressStatus *progress)
+  {
+    min.assign(elements.size(), 99);
+    max.assign(elements.size(), -99);
+
+    // Group elements by type (i.e. by shape and order)
+    std::map<int, std::vector<std::size_t> > groups;
+    for(std::size_t i = 0; i < elements.size(); i++)
+      groups[elements[i]->getTypeForMSH()].push_back(i);
+
+    // Split groups into blocks
+    struct block {
+      const JacobianBasis *jfs;
+      const std::size_t *elements;
+      int num;
+    };
+    const std::size_t blockSize = 128;
+    std::vector<block> blocks;
+    std::map<int, std::vector<std::size_t> >::const_iterator it;
+    for(it = groups.begin(); it != groups.end(); ++it) {
+      const std::vector<std::size_t> &group = it->second;
+      MElement *el = elements[group[0]];
+      const JacobianBasis *jfs = el->getJacobianFuncSpace();
+      if(!jfs) {
+        Msg::Warning("Jacobian function space not implemented for %s",
+                     el->getName().c_str());
+        continue;
+      }
+      // Initialize the Bezier basis before working in parallel
+      BasisFactory::getBezierBasis(jfs->getFuncSpaceData());
+      for(std::size_t j = 0; j < group.size(); j += blockSize) {
+        block b = {jfs, &group[j], (int)std::min(blockSize, group.size() - j)};
+        blocks.push_back(b);
+      }
+    }
 
-    // Get extrema
-    min = std::numeric_limits<double>::max();
-    max = -min;
-    for(std::size_t i = 0; i < domains.size(); ++i) {
-      min = std::min(min, domains[i]->minB());
-      max = std::max(max, domains[i]->maxB());
-      domains[i]->deleteBezierCoeff();
-      delete domains[i];
+    std::atomic<int> numDone(0);
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      fullMatrix<double> nodesX, nodesY, nodesZ, coeffLag;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+      for(long int k = 0; k < (long int)blocks.size(); k++) {
+        const block &b = blocks[k];
+        const int numNodes = b.jfs->getNumMapNodes();
+        const int numPnts = b.jfs->getNumSamplingPnts();
+        nodesX.resize(numNodes, b.num, false);
+        nodesY.resize(numNodes, b.num, false);
+        nodesZ.resize(numNodes, b.num, false);
+        coeffLag.resize(numPnts, b.num, false);
+        for(int e = 0; e < b.num; e++) {
+          MElement *el = elements[b.elements[e]];
+          for(int i = 0; i < numNodes; i++) {
+            const MVertex *v = el->getShapeFunctionNode(i);
+            nodesX(i, e) = v->x();
+            nodesY(i, e) = v->y();
+            nodesZ(i, e) = v->z();
+          }
+        }
+
+        // Sample jacobian determinant of all the elements of the block
+        b.jfs->getSignedJacobian(nodesX, nodesY, nodesZ, coeffLag, normals);
+
+        bezierCoeff::usePools(static_cast<std::size_t>(numPnts), 0);
+        for(int e = 0; e < b.num; e++) {
+          const std::size_t i = b.elements[e];
+          fullVector<double> lag(&coeffLag(0, e), numPnts);
+          _minMaxJacobianDeterminant(b.jfs, lag, min[i], max[i], false);
+        }
+        numDone += b.num;
+        if(progress && Msg::GetThreadNum() == 0) progress->update(numDone);
+      }
     }
   }
 
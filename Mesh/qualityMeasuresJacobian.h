@@ -11,6 +11,7 @@
 
 class bezierCoeff;
 class MElement;
+class MsgProgressStatus;
 template <class scalar> class fullVector;
 template <class scalar> class fullMatrix;
 
@@ -19,6 +20,16 @@ namespace jacobianBasedQuality {
   void minMaxJacobianDeterminant(MElement *el, double &min, double &max,
                                  const fullMatrix<double> *normals = NULL,
                                  bool debug = false);
+  // Same for a set of elements: the elements are grouped by type and order,
+  // the Jacobian determinant of each block of elements of the same type is
+  // sampled with one matrix product, and the blocks are processed in parallel.
+  // Bezier subdivision is only performed for the elements whose bounds are not
+  // sharp enough. If given, the progress is updated by the master thread.
+  void minMaxJacobianDeterminant(const std::vector<MElement *> &elements,
+                                 std::vector<double> &min,
+                                 std::vector<double> &max,
+                                 const fullMatrix<double> *normals = NULL,
+                                 MsgProgressStatus *progress = NULL);
   double minIGEMeasure(MElement *el, bool knownValid = false,
                        bool reversedOk = false,
                        const fullMatrix<double> *normals = NULL,
@@ -12,10 +12,125 @@
 #include "CondNumBasis.h"
 #include "JacobianBasis.h"
 #include <map>
+#include <atomic>
 #include <cstddef>
 
-std::map<int, nodalBasis *> BasisFactory::fs;
-std::map<int, CondNumBasis *> BasisFactory::cs;
+namespace {
+
+  // table of bases indexed by element tag: a basis is published with a
+  // compare-and-swap, so that lookups never lock. Objects with static storage
+  // are zero-initialized, i.e. all entries are initially empty
+  template <class T> class tagTable {
+  private:
+    std::atomic<T *> _bases[MSH_MAX_NUM + 1];
+
+  public:
+    static bool valid(int tag) { return tag >= 0 && tag <= MSH_MAX_NUM; }
+    T *get(int tag) const
+    {
+      return valid(tag) ? _bases[tag].load(std::memory_order_acquire) : 0;
+    }
+    // register b for tag, unless another basis has already been registered:
+    // return the registered basis, and delete b if it is not the one
+    // registered and owned is set
+    T *publish(int tag, T *b, bool owned)
+    {
+      if(!valid(tag)) return b;
+      T *expected = 0;
+      if(_bases[tag].compare_exchange_strong(expected, b,
+                                             std::memory_order_acq_rel))
+        return b;
+      if(owned) delete b;
+      return expected;
+    }
+    void clear(bool owned)
+    {
+      for(int i = 0; i <= MSH_MAX_NUM; i++) {
+        T *b = _bases[i].exchange(0);
+        if(owned) delete b;
+      }
+    }
+  };
+
+  // bases owned by the tables
+  tagTable<nodalBasis> nodalBases;
+  tagTable<CondNumBasis> condNumBases;
+
+  // shortcuts for the default bases of each element tag, owned by the maps
+  tagTable<JacobianBasis> jacobianBases;
+  tagTable<GradientBasis> gradientBases;
+  tagTable<bezierBasis> bezierBases;
+
+  // read-only snapshots of the FuncSpaceData-keyed maps of BasisFactory: a new
+  // snapshot is published each time a basis is inserted in a map (which is
+  // rare), so that lookups never lock. Previous snapshots are kept until
+  // clear(), as other threads can still be reading them. Zero-initialized, as
+  // the tag tables
+  template <class T> class spaceTable {
+  private:
+    struct snapshot {
+      std::map<FuncSpaceData, T *> bases;
+      const snapshot *previous;
+    };
+    std::atomic<const snapshot *> _last;
+
+  public:
+    T *get(const FuncSpaceData &data) const
+    {
+      const snapshot *s = _last.load(std::memory_order_acquire);
+      if(!s) return 0;
+      typename std::map<FuncSpaceData, T *>::const_iterator it =
+        s->bases.find(data);
+      return (it == s->bases.end()) ? 0 : it->second;
+    }
+    // publish a copy of m (not to be called concurrently)
+    void publish(const std::map<FuncSpaceData, T *> &m)
+    {
+      snapshot *s = new snapshot();
+      s->bases = m;
+      s->previous = _last.load(std::memory_order_relaxed);
+      _last.store(s, std::memory_order_release);
+    }
+    void clear()
+    {
+      const snapshot *s = _last.exchange(0);
+      while(s) {
+        const snapshot *previous = s->previous;
+        delete s;
+        s = previous;
+      }
+    }
+  };
+
+  spaceTable<JacobianBasis> jacobianSpaces;
+  spaceTable<GradientBasis> gradientSpaces;
+  spaceTable<bezierBasis> bezierSpaces;
+
+  // find or insert a basis in a map shared by all the threads; lookups use the
+  // snapshot of the map, and the basis is built outside of the critical
+  // section, as building a basis can require other bases
+  template <class T, class Builder>
+  T *findOrInsert(std::map<FuncSpaceData, T *> &m, spaceTable<T> &table,
+                  const FuncSpaceData &data, const Builder &build)
+  {
+    T *b = table.get(data);
+    if(b) return b;
+    T *B = build();
+#if defined(_OPENMP)
+#pragma omp critical(BasisFactoryMap)
+#endif
+    {
+      std::pair<typename std::map<FuncSpaceData, T *>::iterator, bool> ins =
+        m.insert(std::make_pair(data, B));
+      b = ins.first->second;
+      if(ins.second) table.publish(m);
+    }
+    if(b != B) delete B;
+    return b;
+  }
+
+} // namespace
+
 std::map<FuncSpaceData, JacobianBasis *> BasisFactory::js;
 std::map<FuncSpaceData, bezierBasis *> BasisFactory::bs;
 std::map<FuncSpaceData, GradientBasis *> BasisFactory::gs;
@@ -23,11 +138,10 @@ std::map<FuncSpaceData, GradientBasis *> BasisFactory::gs;
 const nodalBasis *BasisFactory::getNodalBasis(int tag)
 {
   // If the Basis has already been built, return it.
-  std::map<int, nodalBasis *>::const_iterator it = fs.find(tag);
-  if(it != fs.end()) { return it->second; }
+  nodalBasis *F = nodalBases.get(tag);
+  if(F) return F;
   // Get the parent type to see which kind of basis
   // we want to create
-  nodalBasis *F = NULL;
   if(tag == MSH_TRI_MINI)
     F = new miniBasisTri();
   else if(tag == MSH_TET_MINI)
@@ -48,31 +162,14 @@ const nodalBasis *BasisFactory::getNodalBasis(int tag)
       return NULL;
     }
   }
-
-  std::pair<std::map<int, nodalBasis *>::const_iterator, bool> inserted;
-
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-  {
-    inserted = fs.insert(std::make_pair(tag, F));
-
-    if(!inserted.second) delete F;
-  }
-
-  return inserted.first->second;
+  return nodalBases.publish(tag, F, true);
 }
 
 const JacobianBasis *BasisFactory::getJacobianBasis(int tag, FuncSpaceData fsd)
 {
   FuncSpaceData data = fsd.getForNonSerendipitySpace();
-
-  std::map<FuncSpaceData, JacobianBasis *>::const_iterator it = js.find(data);
-  if(it != js.end()) return it->second;
-
-  JacobianBasis *J = new JacobianBasis(tag, data);
-  js.insert(std::make_pair(data, J));
-  return J;
+  return findOrInsert(js, jacobianSpaces, data,
+                      [&]() { return new JacobianBasis(tag, data); });
 }
 
 const JacobianBasis *BasisFactory::getJacobianBasis(int tag, int order)
@@ -87,35 +184,30 @@ const JacobianBasis *BasisFactory::getJacobianBasis(int tag, int order)
 
 const JacobianBasis *BasisFactory::getJacobianBasis(int tag)
 {
+  const JacobianBasis *J = jacobianBases.get(tag);
+  if(J) return J;
   const int jacOrder = JacobianBasis::jacobianOrder(tag);
   const int type = ElementType::getParentType(tag);
   if(type != TYPE_PYR)
-    return getJacobianBasis(tag, FuncSpaceData(type, jacOrder, false));
+    J = getJacobianBasis(tag, FuncSpaceData(type, jacOrder, false));
   else
-    return getJacobianBasis(
+    J = getJacobianBasis(
       tag, FuncSpaceData(type, false, jacOrder + 2, jacOrder, false));
+  return jacobianBases.publish(tag, const_cast<JacobianBasis *>(J), false);
 }
 
 const CondNumBasis *BasisFactory::getCondNumBasis(int tag, int cnOrder)
 {
-  std::map<int, CondNumBasis *>::const_iterator it = cs.find(tag);
-  if(it != cs.end()) return it->second;
-
-  CondNumBasis *M = new CondNumBasis(tag, cnOrder);
-  cs.insert(std::make_pair(tag, M));
-  return M;
+  CondNumBasis *M = condNumBases.get(tag);
+  if(M) return M;
+  return condNumBases.publish(tag, new CondNumBasis(tag, cnOrder), true);
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag, FuncSpaceData fsd)
 {
   FuncSpaceData data = fsd.getForNonSerendipitySpace();
-
-  std::map<FuncSpaceData, GradientBasis *>::const_iterator it = gs.find(data);
-  if(it != gs.end()) return it->second;
-
-  GradientBasis *G = new GradientBasis(tag, data);
-  gs.insert(std::make_pair(data, G));
-  return G;
+  return findOrInsert(gs, gradientSpaces, data,
+                      [&]() { return new GradientBasis(tag, data); });
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag, int order)
@@ -126,19 +218,17 @@ const GradientBasis *BasisFactory::getGradientBasis(int tag, int order)
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag)
 {
-  return getGradientBasis(tag, FuncSpaceData(tag));
+  const GradientBasis *G = gradientBases.get(tag);
+  if(G) return G;
+  G = getGradientBasis(tag, FuncSpaceData(tag));
+  return gradientBases.publish(tag, const_cast<GradientBasis *>(G), false);
 }
 
 const bezierBasis *BasisFactory::getBezierBasis(FuncSpaceData fsd)
 {
   FuncSpaceData data = fsd.getForNonSerendipitySpace();
-
-  std::map<FuncSpaceData, bezierBasis *>::const_iterator it = bs.find(data);
-  if(it != bs.end()) return it->second;
-
-  bezierBasis *B = new bezierBasis(data);
-  bs.insert(std::make_pair(data, B));
-  return B;
+  return findOrInsert(bs, bezierSpaces, data,
+                      [&]() { return new bezierBasis(data); });
 }
 
 const bezierBasis *BasisFactory::getBezierBasis(int parentType, int order)
@@ -148,17 +238,22 @@ const bezierBasis *BasisFactory::getBezierBasis(int parentType, int order)
 
 const bezierBasis *BasisFactory::getBezierBasis(int tag)
 {
-  return getBezierBasis(FuncSpaceData(tag));
+  const bezierBasis *B = bezierBases.get(tag);
+  if(B) return B;
+  B = getBezierBasis(FuncSpaceData(tag));
+  return bezierBases.publish(tag, const_cast<bezierBasis *>(B), false);
 }
 
 void BasisFactory::clearAll()
 {
-  std::map<int, nodalBasis *>::iterator itF = fs.begin();
-  while(itF != fs.end()) {
-    delete itF->second;
-    itF++;
-  }
-  fs.clear();
+  nodalBases.clear(true);
+  condNumBases.clear(true);
+  jacobianBases.clear(false);
+  gradientBases.clear(false);
+  bezierBases.clear(false);
+  jacobianSpaces.clear();
+  gradientSpaces.clear();
+  bezierSpaces.clear();
 
   std::map<FuncSpaceData, JacobianBasis *>::iterator itJ = js.begin();
   while(itJ != js.end()) {
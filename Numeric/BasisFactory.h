@@ -14,10 +14,16 @@ class CondNumBasis;
 class JacobianBasis;
 class FuncSpaceData;
 
+// All the functions are thread-safe, except clearAll(). The bases depending
+// only on the element tag are stored in fixed-size tables (one entry per MSH_
+// type) and are looked up without locking. The other ones are stored in maps
+// keyed by FuncSpaceData, which are only modified in a critical section: after
+// each insertion a read-only copy of the map is published atomically, and
+// lookups search the last published copy without locking. A basis requested
+// concurrently by several threads can be built more than once, but only one
+// is registered.
 class BasisFactory {
 private:
-  static std::map<int, nodalBasis *> fs;
-  static std::map<int, CondNumBasis *> cs;
   static std::map<FuncSpaceData, JacobianBasis *> js;
   static std::map<FuncSpaceData, bezierBasis *> bs;
   static std::map<FuncSpaceData, GradientBasis *> gs;
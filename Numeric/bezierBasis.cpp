@@ -191,7 +191,7 @@ bezierBasis::bezierBasis(FuncSpaceData data)
     _construct();
 }
 
-bezierBasis::~bezierBasis() { delete _raiser; }
+bezierBasis::~bezierBasis() { delete _raiser.load(); }
 
 void bezierBasis::_construct()
 {
@@ -274,10 +274,21 @@ void bezierBasis::_constructPyr()
 
 const bezierBasisRaiser *bezierBasis::getRaiser() const
 {
-  if(!_raiser) {
-    const_cast<bezierBasis *>(this)->_raiser = new bezierBasisRaiser(this);
+  // the raiser is created on first use, possibly by concurrent threads: only
+  // its creation is serialized
+  bezierBasisRaiser *raiser = _raiser.load(std::memory_order_acquire);
+  if(raiser) return raiser;
+#if defined(_OPENMP)
+#pragma omp critical(bezierBasisRaiser)
+#endif
+  {
+    raiser = _raiser.load(std::memory_order_relaxed);
+    if(!raiser) {
+      raiser = new bezierBasisRaiser(this);
+      _raiser.store(raiser, std::memory_order_release);
+    }
   }
-  return _raiser;
+  return raiser;
 }
 
 void bezierBasisRaiser::_fillRaiserData()
@@ -601,9 +612,60 @@ void bezierBasisRaiser::computeCoeff(const fullVector<double> &coeffA,
       "or A != B == C");
 }
 
-bezierCoeffMemoryPool *bezierCoeff::_pool0 = NULL;
-bezierCoeffMemoryPool *bezierCoeff::_pool1 = NULL;
-fullMatrix<double> bezierCoeff::_sub = fullMatrix<double>();
+namespace {
+
+  // the memory pools and the subdivision work matrix of a thread
+  struct threadData {
+    bezierCoeffMemoryPool *pool0, *pool1;
+    fullMatrix<double> sub;
+    threadData() : pool0(NULL), pool1(NULL) {}
+  };
+
+  // the data of all the threads, sized from the maximum number of threads
+  // and grown when a thread with a higher number shows up. Entries are never
+  // moved: a larger table is published (after the entries), and the previous
+  // tables are kept until releasePools(), so that lookups never lock
+  std::atomic<threadData **> threadTable(NULL);
+  std::atomic<int> threadTableSize(0);
+  std::vector<threadData **> retiredThreadTables;
+
+  threadData &getThreadData()
+  {
+    const int t = Msg::GetThreadNum();
+    if(t < threadTableSize.load(std::memory_order_acquire))
+      return *threadTable.load(std::memory_order_acquire)[t];
+    threadData *d = NULL;
+#if defined(_OPENMP)
+#pragma omp critical(bezierCoeffThreadData)
+#endif
+    {
+      int size = threadTableSize.load(std::memory_order_relaxed);
+      threadData **table = threadTable.load(std::memory_order_relaxed);
+      if(t >= size) {
+        const int newSize = std::max(t + 1, Msg::GetMaxThreads());
+        threadData **newTable = new threadData *[newSize];
+        for(int i = 0; i < newSize; i++)
+          newTable[i] = (i < size) ? table[i] : new threadData();
+        threadTable.store(newTable, std::memory_order_release);
+        threadTableSize.store(newSize, std::memory_order_release);
+        if(table) retiredThreadTables.push_back(table);
+        table = newTable;
+      }
+      d = table[t];
+    }
+    return *d;
+  }
+
+} // namespace
+
+bezierCoeffMemoryPool *bezierCoeff::_getPool(int num)
+{
+  if(num == 0) return getThreadData().pool0;
+  if(num == 1) return getThreadData().pool1;
+  return NULL;
+}
+
+fullMatrix<double> &bezierCoeff::_getSub() { return getThreadData().sub; }
 
 bezierCoeff::bezierCoeff(FuncSpaceData data, const fullMatrix<double> &lagCoeff,
                          int num)
@@ -613,10 +675,9 @@ bezierCoeff::bezierCoeff(FuncSpaceData data, const fullMatrix<double> &lagCoeff,
   _r = lagCoeff.size1();
   _c = lagCoeff.size2();
   _ownData = false;
-  if(num == 0 && _pool0)
-    _data = _pool0->giveBlock(this);
-  else if(num == 1 && _pool1)
-    _data = _pool1->giveBlock(this);
+  bezierCoeffMemoryPool *pool = _getPool(num);
+  if(pool)
+    _data = pool->giveBlock(this);
   else {
     _ownData = true;
     _data = new double[_r * _c];
@@ -633,10 +694,9 @@ bezierCoeff::bezierCoeff(FuncSpaceData data, const fullVector<double> &lagCoeff,
   _r = lagCoeff.size();
   _c = 1;
   _ownData = false;
-  if(num == 0 && _pool0)
-    _data = _pool0->giveBlock(this);
-  else if(num == 1 && _pool1)
-    _data = _pool1->giveBlock(this);
+  bezierCoeffMemoryPool *pool = _getPool(num);
+  if(pool)
+    _data = pool->giveBlock(this);
   else {
     _ownData = true;
     _data = new double[_r * _c];
@@ -660,10 +720,9 @@ bezierCoeff::bezierCoeff(const bezierCoeff &other, bool swap)
   }
   else {
     _ownData = false;
-    if(_numPool == 0 && _pool0)
-      _data = _pool0->giveBlock(this);
-    else if(_numPool == 1 && _pool1)
-      _data = _pool1->giveBlock(this);
+    bezierCoeffMemoryPool *pool = _getPool(_numPool);
+    if(pool)
+      _data = pool->giveBlock(this);
     else {
       _ownData = true;
       _data = new double[_r * _c];
@@ -677,10 +736,9 @@ bezierCoeff::~bezierCoeff()
     delete[] _data;
   else {
     if(_numPool == -1) return;
-    if(_numPool == 0 && _pool0)
-      _pool0->releaseBlock(_data, this);
-    else if(_numPool == 1 && _pool1)
-      _pool1->releaseBlock(_data, this);
+    bezierCoeffMemoryPool *pool = _getPool(_numPool);
+    if(pool)
+      pool->releaseBlock(_data, this);
     else
       Msg::Error("Not supposed to be here. destructor bezierCoeff");
   }
@@ -768,22 +826,29 @@ void bezierCoeff::_computeCoefficients(const double *lagCoeffDataConst)
 
 void bezierCoeff::usePools(std::size_t size0, std::size_t size1)
 {
+  threadData &d = getThreadData();
   if(size0) {
-    if(!_pool0) _pool0 = new bezierCoeffMemoryPool();
-    _pool0->setSizeBlocks(size0);
+    if(!d.pool0) d.pool0 = new bezierCoeffMemoryPool();
+    d.pool0->setSizeBlocks(size0);
   }
   if(size1) {
-    if(!_pool1) _pool1 = new bezierCoeffMemoryPool();
-    _pool1->setSizeBlocks(size1);
+    if(!d.pool1) d.pool1 = new bezierCoeffMemoryPool();
+    d.pool1->setSizeBlocks(size1);
   }
 }
 
 void bezierCoeff::releasePools()
 {
-  delete _pool0;
-  delete _pool1;
-  _pool0 = NULL;
-  _pool1 = NULL;
+  threadData **table = threadTable.load();
+  for(int t = 0; t < threadTableSize.load(); t++) {
+    delete table[t]->pool0;
+    delete table[t]->pool1;
+    table[t]->pool0 = NULL;
+    table[t]->pool1 = NULL;
+  }
+  for(std::size_t i = 0; i < retiredThreadTables.size(); i++)
+    delete[] retiredThreadTables[i];
+  retiredThreadTables.clear();
 }
 
 void bezierCoeff::updateDataPtr(long diff)
@@ -1200,80 +1265,83 @@ void bezierCoeff::_subdivideTetrahedron(const bezierCoeff &coeff,
 void bezierCoeff::_subdivideQuadrangle(const bezierCoeff &coeff,
                                        std::vector<bezierCoeff *> &subCoeff)
 {
+  fullMatrix<double> &sub = _getSub();
   const int n = coeff.getPolynomialOrder() + 1;
   const int N = 2 * n - 1;
   const int dim = coeff._c;
-  _sub.resize(N * N, dim, false);
+  sub.resize(N * N, dim, false);
   for(int i = 0; i < n; ++i) {
     for(int j = 0; j < n; ++j) {
       const int I1 = i + j * n;
       const int I2 = (2 * i) + (2 * j) * N;
-      for(int k = 0; k < dim; ++k) { _sub(I2, k) = coeff(I1, k); }
+      for(int k = 0; k < dim; ++k) { sub(I2, k) = coeff(I1, k); }
     }
   }
-  for(int i = 0; i < N; i += 2) { _subdivide(_sub, n, i, N); }
-  for(int j = 0; j < N; ++j) { _subdivide(_sub, n, j * N); }
-  _copyQuad(_sub, n, 0, 0, *subCoeff[0]);
-  _copyQuad(_sub, n, n - 1, 0, *subCoeff[1]);
-  _copyQuad(_sub, n, 0, n - 1, *subCoeff[2]);
-  _copyQuad(_sub, n, n - 1, n - 1, *subCoeff[3]);
+  for(int i = 0; i < N; i += 2) { _subdivide(sub, n, i, N); }
+  for(int j = 0; j < N; ++j) { _subdivide(sub, n, j * N); }
+  _copyQuad(sub, n, 0, 0, *subCoeff[0]);
+  _copyQuad(sub, n, n - 1, 0, *subCoeff[1]);
+  _copyQuad(sub, n, 0, n - 1, *subCoeff[2]);
+  _copyQuad(sub, n, n - 1, n - 1, *subCoeff[3]);
   return;
 }
 
 void bezierCoeff::_subdivideHexahedron(const bezierCoeff &coeff,
                                        std::vector<bezierCoeff *> &subCoeff)
 {
+  fullMatrix<double> &sub = _getSub();
   const int n = coeff.getPolynomialOrder() + 1;
   const int N = 2 * n - 1;
   const int dim = coeff._c;
-  _sub.resize(N * N * N, dim, false);
+  sub.resize(N * N * N, dim, false);
   for(int i = 0; i < n; ++i) {
     for(int j = 0; j < n; ++j) {
       for(int k = 0; k < n; ++k) {
         const int I1 = i + j * n + k * n * n;
         const int I2 = (2 * i) + (2 * j) * N + (2 * k) * N * N;
-        for(int k = 0; k < dim; ++k) { _sub(I2, k) = coeff(I1, k); }
+        for(int k = 0; k < dim; ++k) { sub(I2, k) = coeff(I1, k); }
       }
     }
   }
   for(int i = 0; i < N; i += 2) {
-    for(int j = 0; j < N; j += 2) { _subdivide(_sub, n, i + j * N, N * N); }
+    for(int j = 0; j < N; j += 2) { _subdivide(sub, n, i + j * N, N * N); }
   }
   for(int i = 0; i < N; i += 2) {
-    for(int k = 0; k < N; ++k) { _subdivide(_sub, n, i + k * N * N, N); }
+    for(int k = 0; k < N; ++k) { _subdivide(sub, n, i + k * N * N, N); }
   }
   for(int j = 0; j < N; ++j) {
-    for(int k = 0; k < N; ++k) { _subdivide(_sub, n, j * N + k * N * N); }
-  }
-  _copyHex(_sub, n, 0, 0, 0, *subCoeff[0]);
-  _copyHex(_sub, n, n - 1, 0, 0, *subCoeff[1]);
-  _copyHex(_sub, n, 0, n - 1, 0, *subCoeff[2]);
-  _copyHex(_sub, n, n - 1, n - 1, 0, *subCoeff[3]);
-  _copyHex(_sub, n, 0, 0, n - 1, *subCoeff[4]);
-  _copyHex(_sub, n, n - 1, 0, n - 1, *subCoeff[5]);
-  _copyHex(_sub, n, 0, n - 1, n - 1, *subCoeff[6]);
-  _copyHex(_sub, n, n - 1, n - 1, n - 1, *subCoeff[7]);
+    for(int k = 0; k < N; ++k) { _subdivide(sub, n, j * N + k * N * N); }
+  }
+  _copyHex(sub, n, 0, 0, 0, *subCoeff[0]);
+  _copyHex(sub, n, n - 1, 0, 0, *subCoeff[1]);
+  _copyHex(sub, n, 0, n - 1, 0, *subCoeff[2]);
+  _copyHex(sub, n, n - 1, n - 1, 0, *subCoeff[3]);
+  _copyHex(sub, n, 0, 0, n - 1, *subCoeff[4]);
+  _copyHex(sub, n, n - 1, 0, n - 1, *subCoeff[5]);
+  _copyHex(sub, n, 0, n - 1, n - 1, *subCoeff[6]);
+  _copyHex(sub, n, n - 1, n - 1, n - 1, *subCoeff[7]);
   return;
 }
 
 void bezierCoeff::_subdividePrism(const bezierCoeff &coeff,
                                   std::vector<bezierCoeff *> &subCoeff)
 {
+  fullMatrix<double> &sub = _getSub();
   const int n = coeff.getPolynomialOrder() + 1;
   const int ntri = (n + 1) * n / 2;
   const int N = 2 * n - 1;
   const int dim = coeff._c;
 
   // First, use De Casteljau algorithm in 3rd direction (=> 2 subdomains):
-  _sub.resize(N * ntri, dim, false);
+  sub.resize(N * ntri, dim, false);
   for(int k = 0; k < n; ++k) {
     for(int i = 0; i < ntri; ++i) {
       const int I1 = i + k * ntri;
       const int I2 = i + (2 * k) * ntri;
-      for(int l = 0; l < dim; ++l) { _sub(I2, l) = coeff(I1, l); }
+      for(int l = 0; l < dim; ++l) { sub(I2, l) = coeff(I1, l); }
     }
   }
-  for(int i = 0; i < ntri; ++i) { _subdivide(_sub, n, i, ntri); }
+  for(int i = 0; i < ntri; ++i) { _subdivide(sub, n, i, ntri); }
 
   // Copy first subdomain into subCoeff[0] and second one into subCoeff2[0]
   std::vector<bezierCoeff *> subCoeff2;
@@ -1281,8 +1349,8 @@ void bezierCoeff::_subdividePrism(const bezierCoeff &coeff,
   subCoeff2.push_back(subCoeff[5]);
   subCoeff2.push_back(subCoeff[6]);
   subCoeff2.push_back(subCoeff[7]);
-  _copyLine(_sub, n * ntri, 0, *subCoeff[0]);
-  _copyLine(_sub, n * ntri, (n - 1) * ntri, *subCoeff2[0]);
+  _copyLine(sub, n * ntri, 0, *subCoeff[0]);
+  _copyLine(sub, n * ntri, (n - 1) * ntri, *subCoeff2[0]);
 
   // Second, subdivide in the triangular space:
   for(int k = 0; k < n; ++k) {
@@ -1295,45 +1363,46 @@ void bezierCoeff::_subdividePrism(const bezierCoeff &coeff,
 void bezierCoeff::_subdividePyramid(const bezierCoeff &coeff,
                                     std::vector<bezierCoeff *> &subCoeff)
 {
+  fullMatrix<double> &sub = _getSub();
   const int nij = coeff._funcSpaceData.getNij();
   const int nk = coeff._funcSpaceData.getNk();
   const int Nij = 2 * nij - 1;
   const int Nk = 2 * nk - 1;
   const int dim = coeff._c;
 
-  _sub.resize(Nij * Nij * Nk, dim, false);
+  sub.resize(Nij * Nij * Nk, dim, false);
   for(int i = 0; i < nij; ++i) {
     for(int j = 0; j < nij; ++j) {
       for(int k = 0; k < nk; ++k) {
         const int I1 = i + j * nij + k * nij * nij;
         const int I2 = (2 * i) + (2 * j) * Nij + (2 * k) * Nij * Nij;
-        for(int k = 0; k < dim; ++k) { _sub(I2, k) = coeff(I1, k); }
+        for(int k = 0; k < dim; ++k) { sub(I2, k) = coeff(I1, k); }
       }
     }
   }
   for(int i = 0; i < Nij; i += 2) {
     for(int j = 0; j < Nij; j += 2) {
-      _subdivide(_sub, nk, i + j * Nij, Nij * Nij);
+      _subdivide(sub, nk, i + j * Nij, Nij * Nij);
     }
   }
   for(int i = 0; i < Nij; i += 2) {
     for(int k = 0; k < Nk; ++k) {
-      _subdivide(_sub, nij, i + k * Nij * Nij, Nij);
+      _subdivide(sub, nij, i + k * Nij * Nij, Nij);
     }
   }
   for(int j = 0; j < Nij; ++j) {
     for(int k = 0; k < Nk; ++k) {
-      _subdivide(_sub, nij, j * Nij + k * Nij * Nij);
+      _subdivide(sub, nij, j * Nij + k * Nij * Nij);
     }
   }
-  _copyPyr(_sub, nij, nk, 0, 0, 0, *subCoeff[0]);
-  _copyPyr(_sub, nij, nk, nij - 1, 0, 0, *subCoeff[1]);
-  _copyPyr(_sub, nij, nk, 0, nij - 1, 0, *subCoeff[2]);
-  _copyPyr(_sub, nij, nk, nij - 1, nij - 1, 0, *subCoeff[3]);
-  _copyPyr(_sub, nij, nk, 0, 0, nk - 1, *subCoeff[4]);
-  _copyPyr(_sub, nij, nk, nij - 1, 0, nk - 1, *subCoeff[5]);
-  _copyPyr(_sub, nij, nk, 0, nij - 1, nk - 1, *subCoeff[6]);
-  _copyPyr(_sub, nij, nk, nij - 1, nij - 1, nk - 1, *subCoeff[7]);
+  _copyPyr(sub, nij, nk, 0, 0, 0, *subCoeff[0]);
+  _copyPyr(sub, nij, nk, nij - 1, 0, 0, *subCoeff[1]);
+  _copyPyr(sub, nij, nk, 0, nij - 1, 0, *subCoeff[2]);
+  _copyPyr(sub, nij, nk, nij - 1, nij - 1, 0, *subCoeff[3]);
+  _copyPyr(sub, nij, nk, 0, 0, nk - 1, *subCoeff[4]);
+  _copyPyr(sub, nij, nk, nij - 1, 0, nk - 1, *subCoeff[5]);
+  _copyPyr(sub, nij, nk, 0, nij - 1, nk - 1, *subCoeff[6]);
+  _copyPyr(sub, nij, nk, nij - 1, nij - 1, nk - 1, *subCoeff[7]);
   return;
 }
 
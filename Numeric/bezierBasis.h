@@ -9,6 +9,7 @@
 #include <set>
 #include <map>
 #include <vector>
+#include <atomic>
 #include "fullMatrix.h"
 #include "FuncSpaceData.h"
 #include "BasisFactory.h"
@@ -23,7 +24,8 @@ private:
   int _numLagCoeff;
   int _dimSimplex;
   const FuncSpaceData _funcSpaceData;
-  bezierBasisRaiser *_raiser;
+  // created on first use, and published atomically (see getRaiser())
+  mutable std::atomic<bezierBasisRaiser *> _raiser;
   fullMatrix<double> _exponents;
   fullMatrix<double> matrixLag2Bez;
   fullVector<double> ordered1dBezPoints;
@@ -126,13 +128,11 @@ private:
   double *_data; // pointer on the first element
   bool _ownData; // to know if data should be freed when object is deleted
 
-  static bezierCoeffMemoryPool *_pool0;
-  static bezierCoeffMemoryPool *_pool1;
-  static fullMatrix<double> _sub;
-  // FIXME: not thread safe. We shoud use one pool and one _sub per thread.
-  //        The best would be to give the pool to the constructor.
-  //        (the pools should be created and deleted e.g. by the plugin
-  //        AnalyseMeshQuality)
+  // memory pools and subdivision work matrix of the calling thread, so that
+  // coefficients can be computed and subdivided concurrently (each thread
+  // should call usePools(..) before using its pools)
+  static bezierCoeffMemoryPool *_getPool(int num);
+  static fullMatrix<double> &_getSub();
 
 public:
   bezierCoeff(){};
@@ -145,7 +145,9 @@ public:
               int numOfPool = -1);
   ~bezierCoeff();
 
+  // set the size of the blocks of the pools of the calling thread
   static void usePools(std::size_t size0, std::size_t size1);
+  // release the pools of all the threads (not to be called concurrently)
   static void releasePools();
   void updateDataPtr(long diff);
 
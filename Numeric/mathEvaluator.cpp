@@ -3,6 +3,7 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
 
+#include <algorithm>
 #include "mathEvaluator.h"
 
 #if defined(HAVE_MATHEX)
@@ -14,6 +15,7 @@ mathEvaluator::mathEvaluator(std::vector<std::string> &expressions,
 
   _expressions.resize(expressions.size());
   _variables.resize(variables.size(), 0.);
+  _stackSize = 1;
   bool error = false;
   for(std::size_t i = 0; i < expressions.size(); i++) {
     _expressions[i] = new smlib::mathex();
@@ -22,6 +24,8 @@ mathEvaluator::mathEvaluator(std::vector<std::string> &expressions,
     try {
       _expressions[i]->expression(expressions[i]);
       _expressions[i]->parse();
+      _stackSize = std::max(_stackSize,
+                            (std::size_t)_expressions[i]->stacksize());
     } catch(smlib::mathex::error &e) {
       if(e.what() + expressions[i] != lastError) {
         lastError = e.what() + expressions[i];
@@ -62,18 +66,36 @@ bool mathEvaluator::eval(const std::vector<double> &values,
     return false;
   }
 
-  for(std::size_t i = 0; i < values.size(); i++) _variables[i] = values[i];
+  const double dummy = 0.;
+  return eval(values.empty() ? &dummy : &values[0], res.empty() ? 0 : &res[0]);
+}
+
+bool mathEvaluator::eval(const double *values, double *res) const
+{
+  // the work arrays are on the stack, unless the expression is huge
+  double stack[256], shifted[32];
+  std::vector<double> stackVec, shiftedVec;
+  double *s = stack;
+  if(_stackSize > 256) {
+    stackVec.resize(_stackSize);
+    s = &stackVec[0];
+  }
 
   for(std::size_t i = 0; i < _expressions.size(); i++) {
     try {
-      res[i] = _expressions[i]->eval();
+      _expressions[i]->eval(values, 1, &res[i], s);
     } catch(smlib::mathex::error &e) {
       Msg::Error(e.what());
+      double *v = shifted;
+      if(_variables.size() > 32) {
+        shiftedVec.resize(_variables.size());
+        v = &shiftedVec[0];
+      }
       double eps = 1.e-20;
-      for(std::size_t j = 0; j < values.size(); j++)
-        _variables[j] = values[j] + eps;
+      for(std::size_t j = 0; j < _variables.size(); j++)
+        v[j] = values[j] + eps;
       try {
-        res[i] = _expressions[i]->eval();
+        _expressions[i]->eval(v, 1, &res[i], s);
       } catch(smlib::mathex::error &e2) {
         Msg::Error(e2.what());
         return false;
@@ -83,4 +105,18 @@ bool mathEvaluator::eval(const std::vector<double> &values,
   return true;
 }
 
+bool mathEvaluator::eval(const double *values, std::size_t n,
+                         double *res) const
+{
+  if(!n) return true;
+  std::vector<double> stack(_stackSize * n);
+  try {
+    for(std::size_t i = 0; i < _expressions.size(); i++)
+      _expressions[i]->eval(values, n, &res[i * n], &stack[0]);
+  } catch(smlib::mathex::error &) {
+    return false;
+  }
+  return true;
+}
+
 #endif
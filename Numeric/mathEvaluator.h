@@ -19,6 +19,7 @@ class mathEvaluator {
 private:
   std::vector<smlib::mathex *> _expressions;
   std::vector<double> _variables;
+  std::size_t _stackSize;
 
 public:
   // initialize one or more expressions depending on zero or more
@@ -30,6 +31,15 @@ public:
   // evaluate the expression(s) using the given values and fill the
   // result vector. Returns true if the evaluation succeeded.
   bool eval(const std::vector<double> &values, std::vector<double> &res);
+  // reentrant versions of eval(), which can be called concurrently. The first
+  // one evaluates the expression(s) at a single point: values[j] is the value
+  // of variable j and res[i] is set to the value of expression i. The second
+  // one evaluates the expression(s) at n points, in batch: values[j * n + k]
+  // is the value of variable j at point k, and res[i * n + k] is set to the
+  // value of expression i at point k; it does not print any error message
+  // (evaluate the points one at a time to locate the failures).
+  bool eval(const double *values, double *res) const;
+  bool eval(const double *values, std::size_t n, double *res) const;
 };
 
 #else
@@ -48,6 +58,11 @@ public:
   {
     return false;
   }
+  bool eval(const double *values, double *res) const { return false; }
+  bool eval(const double *values, std::size_t n, double *res) const
+  {
+    return false;
+  }
 };
 
 #endif
@@ -22,6 +22,9 @@ public:
   virtual bool hasDerivatives() { return _hasDerivatives; };
   virtual scalar operator()(double x, double y, double z) const { return _val; }
   virtual void setElement(MElement *e) const {}
+  // does the function depend on the element given to setElement()? (if so,
+  // the function cannot be shared by threads evaluating different elements)
+  virtual bool dependsOnElement() const { return false; }
   virtual void gradient(double x, double y, double z, scalar &dfdx,
                         scalar &dfdy, scalar &dfdz) const
   {
@@ -47,6 +50,7 @@ public:
   constantPerElement() : _e(0) {}
   void set(MElement *e, scalar v) { _data[e] = v; }
   void setElement(MElement *e) const { _e = e; }
+  bool dependsOnElement() const { return true; }
   virtual scalar operator()(double x, double y, double z) const
   {
     if(!_e) return 0.0;
@@ -66,6 +70,7 @@ public:
   }
   virtual ~simpleFunctionOnElement() {}
   void setElement(MElement *e) const { _e = e; }
+  bool dependsOnElement() const { return true; }
   MElement *getElement(void) const { return _e; }
   MElement *getElement(double x, double y, double z) const
   {
@@ -17,6 +17,7 @@
 #include "bezierBasis.h"
 #include <sstream>
 #include <fstream>
+#include <atomic>
 #if defined(HAVE_OPENGL)
 #include "drawContext.h"
 #endif
@@ -293,17 +294,19 @@ void GMSH_AnalyseMeshQualityPlugin::_computeMinMaxJandValidity(int dim)
 
     MsgProgressStatus progress(num);
 
+    std::vector<MElement *> elements(num);
+    for(unsigned i = 0; i < num; ++i) elements[i] = entity->getMeshElement(i);
+    std::vector<double> min, max;
+    jacobianBasedQuality::minMaxJacobianDeterminant(elements, min, max,
+                                                    normals, &progress);
+
     _data.reserve(_data.size() + num);
     for(unsigned i = 0; i < num; ++i) {
-      MElement *el = entity->getMeshElement(i);
-      double min, max;
-      jacobianBasedQuality::minMaxJacobianDeterminant(el, min, max, normals);
-      _data.push_back(data_elementMinMax(el, min, max));
-      if(min < 0 && max < 0) ++cntInverted;
-      progress.next();
+      _data.push_back(data_elementMinMax(elements[i], min[i], max[i]));
+      if(min[i] < 0 && max[i] < 0) ++cntInverted;
 
 #if defined(HAVE_VISUDEV)
-      _computePointwiseQuantities(el, normals);
+      _computePointwiseQuantities(elements[i], normals);
 #endif
     }
     if(normals) delete normals;
@@ -320,6 +323,10 @@ void GMSH_AnalyseMeshQualityPlugin::_computeMinIGE(int dim)
 {
   if(_computedIGE[dim - 1]) return;
 
+  // the first valid element of each type is computed serially, so that the
+  // bases are initialized before computing the other ones in parallel
+  std::vector<std::size_t> todo;
+  std::set<int> types;
   MsgProgressStatus progress(_data.size());
 
   for(std::size_t i = 0; i < _data.size(); ++i) {
@@ -328,12 +335,29 @@ void GMSH_AnalyseMeshQualityPlugin::_computeMinIGE(int dim)
     if(_data[i].minJ() <= 0 && _data[i].maxJ() >= 0) {
       _data[i].setMinS(0);
     }
-    else {
+    else if(types.insert(el->getTypeForMSH()).second) {
       _data[i].setMinS(jacobianBasedQuality::minIGEMeasure(el, true));
     }
-    progress.next();
+    else {
+      todo.push_back(i);
+    }
   }
 
+  // the progress is counted over all the elements, the ones computed serially
+  // being reported at once
+  std::atomic<int> numDone((int)(_data.size() - todo.size()));
+  progress.update(numDone);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for(long int k = 0; k < (long int)todo.size(); ++k) {
+    data_elementMinMax &data = _data[todo[k]];
+    data.setMinS(jacobianBasedQuality::minIGEMeasure(data.element(), true));
+    numDone++;
+    if(Msg::GetThreadNum() == 0) progress.update(numDone);
+  }
+  bezierCoeff::releasePools();
+
   _computedIGE[dim - 1] = true;
 }
 
@@ -341,6 +365,10 @@ void GMSH_AnalyseMeshQualityPlugin::_computeMinICN(int dim)
 {
   if(_computedICN[dim - 1]) return;
 
+  // the first valid element of each type is computed serially, so that the
+  // bases are initialized before computing the other ones in parallel
+  std::vector<std::size_t> todo;
+  std::set<int> types;
   MsgProgressStatus progress(_data.size());
 
   for(std::size_t i = 0; i < _data.size(); ++i) {
@@ -349,12 +377,29 @@ void GMSH_AnalyseMeshQualityPlugin::_computeMinICN(int dim)
     if(_data[i].minJ() <= 0 && _data[i].maxJ() >= 0) {
       _data[i].setMinI(0);
     }
-    else {
+    else if(types.insert(el->getTypeForMSH()).second) {
       _data[i].setMinI(jacobianBasedQuality::minICNMeasure(el, true));
     }
-    progress.next();
+    else {
+      todo.push_back(i);
+    }
   }
 
+  // the progress is counted over all the elements, the ones computed serially
+  // being reported at once
+  std::atomic<int> numDone((int)(_data.size() - todo.size()));
+  progress.update(numDone);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for(long int k = 0; k < (long int)todo.size(); ++k) {
+    data_elementMinMax &data = _data[todo[k]];
+    data.setMinI(jacobianBasedQuality::minICNMeasure(data.element(), true));
+    numDone++;
+    if(Msg::GetThreadNum() == 0) progress.update(numDone);
+  }
+  bezierCoeff::releasePools();
+
   _computedICN[dim - 1] = true;
 }
 
@@ -11,6 +11,7 @@
 #include "Distance.h"
 #include "Context.h"
 #include "Numeric.h"
+#include "SBoundingBoxTree.h"
 
 #if defined(HAVE_SOLVER)
 #include "dofManager.h"
@@ -22,13 +23,39 @@
 
 template <class scalar> class simpleFunction;
 
+// unsigned distance from a point to a boundary line or triangle
+class ElementDistance {
+private:
+  const std::vector<MElement *> &_elements;
+
+public:
+  ElementDistance(const std::vector<MElement *> &elements)
+    : _elements(elements)
+  {
+  }
+  double operator()(std::size_t i, const double xyz[3]) const
+  {
+    MElement *e = _elements[i];
+    SPoint3 p(xyz), p1(e->getVertex(0)->point()), p2(e->getVertex(1)->point());
+    SPoint3 closePt;
+    double d = 1.e22;
+    if(e->getType() == TYPE_LIN)
+      signedDistancePointLine(p1, p2, p, d, closePt);
+    else
+      signedDistancePointTriangle(p1, p2, e->getVertex(2)->point(), p, d,
+                                  closePt);
+    return std::abs(d);
+  }
+};
+
 StringXNumber DistanceOptions_Number[] = {
   {GMSH_FULLRC, "PhysicalPoint", NULL, 0.},
   {GMSH_FULLRC, "PhysicalLine", NULL, 0.},
   {GMSH_FULLRC, "PhysicalSurface", NULL, 0.},
   {GMSH_FULLRC, "DistanceType", NULL, 0},
   {GMSH_FULLRC, "MinScale", NULL, 0},
-  {GMSH_FULLRC, "MaxScale", NULL, 0}
+  {GMSH_FULLRC, "MaxScale", NULL, 0},
+  {GMSH_FULLRC, "BruteForce", NULL, 0}
 };
 
 extern "C" {
@@ -48,7 +75,9 @@ std::string GMSH_DistancePlugin::getHelp() const
          "distance is computed to all the boundaries. Otherwise the distance "
          "is computed to the given physical group.\n\n"
          "If `DistanceType' is 0, the plugin computes the geometrical Euclidean "
-         "distance using the naive O(N^2) algorithm. If `DistanceType' > 0, "
+         "distance to the closest boundary line or triangle, located with a "
+         "bounding volume hierarchy (or by testing all the boundary elements "
+         "if `BruteForce' is set). If `DistanceType' > 0, "
          "the plugin computes an approximate distance by solving a PDE with "
          "a diffusion constant equal to `DistanceType' time the maximum size "
          "of the bounding box of the mesh as in [Legrand et al. 2006].\n\n"
@@ -133,6 +162,7 @@ PView *GMSH_DistancePlugin::execute(PView *v)
   int id_line = (int)DistanceOptions_Number[1].def;
   int id_face = (int)DistanceOptions_Number[2].def;
   double type = (double)DistanceOptions_Number[3].def;
+  int bruteForce = (int)DistanceOptions_Number[6].def;
 
   GModel *m = GModel::current();
   int totNumNodes = m->getNumMeshVertices();
@@ -168,6 +198,8 @@ PView *GMSH_DistancePlugin::execute(PView *v)
 
   if(type <= 0.0) { // Compute geometrical distance to mesh boundaries
     bool existEntity = false;
+    std::vector<MElement *> boundaryElements;
+    std::vector<SBoundingBox3d> boxes;
     for(std::size_t i = 0; i < entities.size(); i++) {
       GEntity *g2 = entities[i];
       int gDim = g2->dim();
@@ -189,32 +221,58 @@ PView *GMSH_DistancePlugin::execute(PView *v)
       if(computeForEntity) {
         existEntity = true;
         for(std::size_t k = 0; k < g2->getNumMeshElements(); k++) {
-          std::vector<double> iDistances;
-          std::vector<SPoint3> iClosePts;
-          std::vector<double> iDistancesE;
           MElement *e = g2->getMeshElement(k);
-          MVertex *v1 = e->getVertex(0);
-          MVertex *v2 = e->getVertex(1);
-          SPoint3 p1(v1->x(), v1->y(), v1->z());
-          SPoint3 p2(v2->x(), v2->y(), v2->z());
-          if(e->getType() == TYPE_LIN) {
-            signedDistancesPointsLine(iDistances, iClosePts, pts, p1, p2);
-          }
-          else if(e->getType() == TYPE_TRI) {
-            MVertex *v3 = e->getVertex(2);
-            SPoint3 p3(v3->x(), v3->y(), v3->z());
-            signedDistancesPointsTriangle(iDistances, iClosePts, pts, p1, p2, p3);
-          }
-          for(std::size_t kk = 0; kk < pts.size(); kk++) {
-            if(std::abs(iDistances[kk]) < distances[kk]) {
-              distances[kk] = std::abs(iDistances[kk]);
-              MVertex *v = pt2Vertex[kk];
-              distanceMap[v] = distances[kk];
-            }
+          if(e->getType() != TYPE_LIN && e->getType() != TYPE_TRI) continue;
+          SBoundingBox3d bb;
+          for(std::size_t l = 0; l < (e->getType() == TYPE_LIN ? 2 : 3); l++)
+            bb += e->getVertex(l)->point();
+          boundaryElements.push_back(e);
+          boxes.push_back(bb);
+        }
+      }
+    }
+
+    if(bruteForce) {
+      // distance from all the nodes to each boundary element
+      for(std::size_t k = 0; k < boundaryElements.size(); k++) {
+        std::vector<double> iDistances;
+        std::vector<SPoint3> iClosePts;
+        MElement *e = boundaryElements[k];
+        SPoint3 p1(e->getVertex(0)->point()), p2(e->getVertex(1)->point());
+        if(e->getType() == TYPE_LIN)
+          signedDistancesPointsLine(iDistances, iClosePts, pts, p1, p2);
+        else
+          signedDistancesPointsTriangle(iDistances, iClosePts, pts, p1, p2,
+                                        e->getVertex(2)->point());
+        for(std::size_t kk = 0; kk < pts.size(); kk++) {
+          if(std::abs(iDistances[kk]) < distances[kk]) {
+            distances[kk] = std::abs(iDistances[kk]);
+            distanceMap[pt2Vertex[kk]] = distances[kk];
           }
         }
       }
     }
+    else {
+      // closest boundary element of each node, using a bounding volume
+      // hierarchy
+      SBoundingBoxTree tree;
+      tree.build(boxes);
+      ElementDistance distance(boundaryElements);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+      for(long int i = 0; i < (long int)pts.size(); i++) {
+        double xyz[3] = {pts[i].x(), pts[i].y(), pts[i].z()};
+        std::size_t closest;
+        double d;
+        if(tree.nearest(xyz, distance, closest, d)) distances[i] = d;
+      }
+      if(!tree.empty()) {
+        for(std::size_t i = 0; i < pts.size(); i++)
+          distanceMap[pt2Vertex[i]] = distances[i];
+      }
+    }
+
     if(!existEntity) {
       if(id_point) Msg::Warning("Physical Point %d does not exist", id_point);
       if(id_line) Msg::Warning("Physical Line %d does not exist", id_line);
@@ -289,12 +347,10 @@ PView *GMSH_DistancePlugin::execute(PView *v)
       double mu = type * L;
       simpleFunction<double> DIFF(mu * mu), ONE(1.0);
       distanceTerm distance(GModel::current(), 1, &DIFF, &ONE);
-      for(std::vector<MElement *>::iterator it = allElems.begin();
-          it != allElems.end(); it++) {
-        SElement se((*it));
-        distance.addToMatrix(*dofView, &se);
-      }
       groupOfElements gr(allElems);
+      scatterMap<double> scatter;
+      distance.buildScatterMap(*dofView, gr, scatter);
+      distance.addToMatrix(*dofView, scatter);
       distance.addToRightHandSide(*dofView, gr);
       lsys->systemSolve();
       for(std::map<MVertex *, double>::iterator itv = distanceMap.begin();
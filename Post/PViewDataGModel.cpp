@@ -272,7 +272,7 @@ int PViewDataGModel::getNumTimeSteps() { return _steps.size(); }
 int PViewDataGModel::getFirstNonEmptyTimeStep(int start)
 {
   for(std::size_t i = start; i < _steps.size(); i++)
-    if(_steps[i]->getNumData()) return i;
+    if(_steps[i]->hasData()) return i;
   return start;
 }
 
@@ -667,6 +667,8 @@ void PViewDataGModel::getValue(int step, int ent, int ele, int nod, int comp,
 void PViewDataGModel::setValue(int step, int ent, int ele, int nod, int comp,
                                double val)
 {
+  // modified steps cannot be reloaded from disk
+  _steps[step]->keepInMemory();
   MElement *e = _getElement(step, ent, ele);
   switch(_type) {
   case NodeData: {
@@ -815,7 +817,7 @@ bool PViewDataGModel::skipElement(int step, int ent, int ele,
 {
   if(step >= getNumTimeSteps()) return true;
   stepData<double> *sd = _steps[step];
-  if(!_steps[step]->getNumData()) return true;
+  if(!_steps[step]->hasData()) return true;
   MElement *e = _getElement(step, ent, ele);
   if(checkVisibility && !e->getVisibility()) return true;
   if(_type == NodeData) {
@@ -830,7 +832,7 @@ bool PViewDataGModel::skipElement(int step, int ent, int ele,
 
 bool PViewDataGModel::hasTimeStep(int step)
 {
-  if(step >= 0 && step < getNumTimeSteps() && _steps[step]->getNumData())
+  if(step >= 0 && step < getNumTimeSteps() && _steps[step]->hasData())
     return true;
   return false;
 }
@@ -10,6 +10,45 @@
 #include "GModel.h"
 #include "SBoundingBox3d.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include <atomic>
+
+template <class Real> class stepData;
+
+// the location of a block of values of a step in an MSH file, allowing to load
+// the step on demand (the blocks of a step can come from different files, e.g.
+// when merging partitioned results)
+class stepDataBlock {
+public:
+  std::string fileName;
+  long offset;
+  int numEnt;
+  bool binary, swap, multiple;
+};
+
+// the steps of a view which are loaded on demand: at most maxSteps steps are
+// kept in memory, the least recently used ones being unloaded first
+template <class Real> class stepDataCache {
+public:
+  int maxSteps;
+  // incremented on each use of a step (possibly by concurrent readers)
+  std::atomic<std::size_t> clock;
+  std::vector<stepData<Real> *> steps;
+  stepDataCache() : maxSteps(0), clock(0) {}
+};
+
+// read the values of a step from the given file blocks (defined in
+// PViewDataGModelIO.cpp)
+template <class Real>
+bool readStepData(const std::vector<stepDataBlock> &blocks,
+                  stepData<Real> *step);
+template <>
+bool readStepData<double>(const std::vector<stepDataBlock> &blocks,
+                          stepData<double> *step);
+
 template <class Real> class stepData {
 private:
   // a pointer to the underlying model
@@ -27,16 +66,15 @@ private:
   // the number of components in the data (one stepData contains only
   // a single field type)
   int _numComp;
-  // the values, indexed by MVertex or MElement id numbers (If the
-  // numbering is sparse, or if we only have data for high-id
-  // entities, the vector has zero entries and is thus not
-  // optimal. This is the price to pay if we want 1) rapid access to
-  // the data and 2) not to store any additional info in MVertex or
-  // MElement)
-  //
-  // FIXME: we should change this design and store a vector<int> of tags, and do
-  // indirect addressing, even if it's a bit slower...
-  std::vector<Real *> *_data;
+  // the values, stored contiguously in a single buffer
+  std::vector<Real> _values;
+  // the offsets of the values in _values (plus one, zero meaning "no data"),
+  // indexed by MVertex or MElement id numbers. (If the numbering is sparse, or
+  // if we only have data for high-id entities, the vector has zero entries and
+  // is thus not optimal. This is the price to pay if we want 1) rapid access
+  // to the data and 2) not to store any additional info in MVertex or
+  // MElement.)
+  std::vector<std::size_t> *_data;
   // a vector containing the multiplying factor allowing to compute
   // the number of values stored in _data for each index (number of
   // values = getMult() * getNumComponents()). If _mult is empty, a
@@ -47,17 +85,100 @@ private:
   std::vector<std::vector<double> > _gaussPoints;
   // a set of all "partitions" encountered in the data
   std::set<int> _partitions;
+  // if the step is loaded on demand: the blocks of values in _fileName, the
+  // cache of the view and the last time the step was used
+  std::vector<stepDataBlock> _fileBlocks;
+  stepDataCache<Real> *_cache;
+  std::atomic<std::size_t> _lastUse;
+  // set once the values of a step loaded on demand are available (the fast
+  // path of _load() does not take the lock)
+  std::atomic<bool> _loaded;
+  bool _isLoaded() const { return _loaded.load(std::memory_order_acquire); }
+  void _setLoaded(bool l) { _loaded.store(l, std::memory_order_release); }
+  void _unload()
+  {
+    _setLoaded(false);
+    if(_data) {
+      delete _data;
+      _data = 0;
+    }
+    std::vector<Real>().swap(_values);
+    std::vector<int>().swap(_mult);
+  }
+  // unload the least recently used steps, to make room for a new one. Inside a
+  // parallel region any cached step can be in use by another thread: they are
+  // all kept (the cache grows temporarily), and are only evicted by the next
+  // load outside of the region
+  void _makeRoomInCache()
+  {
+#if defined(_OPENMP)
+    if(omp_in_parallel()) return;
+#endif
+    std::vector<stepData<Real> *> &steps = _cache->steps;
+    while(steps.size() && (int)steps.size() >= std::max(2, _cache->maxSteps)) {
+      std::size_t lru = 0;
+      for(std::size_t i = 1; i < steps.size(); i++)
+        if(steps[i]->_lastUse < steps[lru]->_lastUse) lru = i;
+      steps[lru]->_unload();
+      steps.erase(steps.begin() + lru);
+    }
+  }
+  void _load()
+  {
+    if(!_cache) return;
+    if(_isLoaded()) {
+      _lastUse = ++_cache->clock;
+      return;
+    }
+#if defined(_OPENMP)
+#pragma omp critical(stepDataLoad)
+#endif
+    if(!_isLoaded()) {
+      _makeRoomInCache();
+      // read into a temporary step (which is not cached, and thus does not
+      // reenter _load()), and only publish the values once they are complete
+      stepData<Real> tmp(_model, _numComp, _fileName);
+      if(!readStepData(_fileBlocks, &tmp))
+        Msg::Error("Could not load step data from file '%s'",
+                   _fileName.c_str());
+      if(!tmp._data) tmp._data = new std::vector<std::size_t>();
+      _values.swap(tmp._values);
+      _mult.swap(tmp._mult);
+      if(_data) delete _data;
+      _data = tmp._data;
+      tmp._data = 0;
+      _lastUse = ++_cache->clock;
+      _cache->steps.push_back(this);
+      _setLoaded(true);
+    }
+  }
+  void _removeFromCache()
+  {
+    if(!_cache) return;
+    std::vector<stepData<Real> *> &steps = _cache->steps;
+    for(std::size_t i = 0; i < steps.size(); i++) {
+      if(steps[i] == this) {
+        steps.erase(steps.begin() + i);
+        break;
+      }
+    }
+    _cache = 0;
+    _fileBlocks.clear();
+  }
 
 public:
   stepData(GModel *model, int numComp, const std::string &fileName = "",
            int fileIndex = -1, double time = 0., double min = VAL_INF,
            double max = -VAL_INF)
     : _model(model), _fileName(fileName), _fileIndex(fileIndex), _time(time),
-      _min(min), _max(max), _numComp(numComp), _data(0)
+      _min(min), _max(max), _numComp(numComp), _data(0), _cache(0),
+      _lastUse(0), _loaded(false)
   {
   }
-  stepData(stepData<Real> &other) : _data(0)
+  stepData(stepData<Real> &other)
+    : _data(0), _cache(0), _lastUse(0), _loaded(false)
   {
+    other._load();
     _model = other._model;
     _entities = other._entities;
     _bbox = other._bbox;
@@ -68,22 +189,35 @@ public:
     _max = other._max;
     _numComp = other._numComp;
     if(other._data) {
-      std::size_t n = other.getNumData();
-      _data = new std::vector<Real *>(n, (Real *)0);
-      for(std::size_t i = 0; i < n; i++) {
-        Real *d = other.getData(i);
-        if(d) {
-          int m = other.getMult(i) * _numComp;
-          (*_data)[i] = new Real[m];
-          for(int j = 0; j < m; j++) (*_data)[i][j] = d[j];
-        }
-      }
+      _data = new std::vector<std::size_t>(*other._data);
+      _values = other._values;
     }
     _mult = other._mult;
     _gaussPoints = other._gaussPoints;
     _partitions = other._partitions;
   }
   ~stepData() { destroyData(); }
+  // load the step on demand from the given block of the file, using the
+  // cache of the view to limit the number of steps in memory
+  void addFileBlock(const stepDataBlock &block, stepDataCache<Real> *cache)
+  {
+    if(_cache && _cache != cache) return;
+    if(!_cache) {
+      _cache = cache;
+      _makeRoomInCache();
+      _lastUse = ++_cache->clock;
+      _cache->steps.push_back(this);
+      _setLoaded(true);
+    }
+    _fileBlocks.push_back(block);
+  }
+  const std::vector<stepDataBlock> &getFileBlocks() { return _fileBlocks; }
+  // keep the step in memory (e.g. when its values are modified)
+  void keepInMemory()
+  {
+    _load();
+    _removeFromCache();
+  }
   void fillEntities() { _model->getEntities(_entities); }
   void computeBoundingBox() { _bbox = _model->bounds(); }
   GModel *getModel() { return _model; }
@@ -93,6 +227,7 @@ public:
   int getNumComponents() { return _numComp; }
   int getMult(int index)
   {
+    _load();
     if(index < 0 || index >= (int)_mult.size()) return 1;
     return _mult[index];
   }
@@ -108,22 +243,39 @@ public:
   void setMax(double max) { _max = max; }
   std::size_t getNumData()
   {
+    _load();
     if(!_data) return 0;
     return _data->size();
   }
+  // check if the step contains data, without loading it
+  bool hasData()
+  {
+    for(std::size_t i = 0; i < _fileBlocks.size(); i++)
+      if(_fileBlocks[i].numEnt > 0) return true;
+    if(_cache && !_isLoaded()) return false;
+    return _data && _data->size();
+  }
+  // make room for n entries (with a single value per component)
   void resizeData(int n)
   {
-    if(!_data) _data = new std::vector<Real *>(n, (Real *)0);
-    if(n > (int)_data->size()) _data->resize(n, (Real *)0);
+    _load();
+    if(!_data) _data = new std::vector<std::size_t>(n, 0);
+    if(n > (int)_data->size()) _data->resize(n, 0);
+    _values.reserve((std::size_t)n * _numComp);
   }
+  // return the values for the given index; when allocating new values, note
+  // that the pointers previously returned by getData() can be invalidated
   Real *getData(int index, bool allocIfNeeded = false, int mult = 1)
   {
     if(index < 0) return 0;
+    _load();
     if(allocIfNeeded) {
-      if(index >= (int)getNumData()) resizeData(index + 100); // optimize this
+      if(!_data) _data = new std::vector<std::size_t>();
+      if(index >= (int)getNumData())
+        _data->resize(index + 100, 0); // optimize this
       if(!(*_data)[index]) {
-        (*_data)[index] = new Real[_numComp * mult];
-        for(int i = 0; i < _numComp * mult; i++) (*_data)[index][i] = 0.;
+        (*_data)[index] = _values.size() + 1;
+        _values.resize(_values.size() + _numComp * mult, 0.);
       }
       if(mult > 1) {
         if(index >= (int)_mult.size())
@@ -134,16 +286,14 @@ public:
     else {
       if(index >= (int)getNumData()) return 0;
     }
-    return (*_data)[index];
+    std::size_t offset = (*_data)[index];
+    if(!offset) return 0;
+    return &_values[offset - 1];
   }
   void destroyData()
   {
-    if(_data) {
-      for(unsigned int i = 0; i < _data->size(); i++)
-        if((*_data)[i]) delete[](*_data)[i];
-      delete _data;
-      _data = 0;
-    }
+    _removeFromCache();
+    _unload();
   }
   std::vector<double> &getGaussPoints(int msh)
   {
@@ -151,11 +301,13 @@ public:
     return _gaussPoints[msh];
   }
   std::set<int> &getPartitions() { return _partitions; }
+  // the memory currently used by the step (a step which is not loaded does
+  // not use any memory, and is not loaded to answer the query)
   double getMemoryInMb()
   {
-    double b = 0.;
-    for(std::size_t i = 0; i < getNumData(); i++) b += getMult(i);
-    return b * getNumComponents() * sizeof(Real) / 1024. / 1024.;
+    std::size_t numData = _data ? _data->size() : 0;
+    return (_values.size() * sizeof(Real) + numData * sizeof(std::size_t)) /
+           1024. / 1024.;
   }
 };
 
@@ -177,6 +329,8 @@ private:
   double _min, _max;
   // the type of the dataset
   DataType _type;
+  // the steps loaded on demand
+  stepDataCache<double> _cache;
   // cache last element to speed up loops
   MElement *_getElement(int step, int ent, int ele);
   MVertex *_getNode(MElement *e, int nod);
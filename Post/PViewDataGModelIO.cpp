@@ -32,6 +32,7 @@ bool PViewDataGModel::addData(GModel *model,
 
   while(step >= (int)_steps.size())
     _steps.push_back(new stepData<double>(model, numComp));
+  _steps[step]->keepInMemory();
   _steps[step]->fillEntities();
   _steps[step]->computeBoundingBox();
   _steps[step]->setTime(time);
@@ -70,6 +71,7 @@ bool PViewDataGModel::addData(GModel *model, const std::vector<std::size_t> &tag
 
   while(step >= (int)_steps.size())
     _steps.push_back(new stepData<double>(model, numComp));
+  _steps[step]->keepInMemory();
   _steps[step]->fillEntities();
   _steps[step]->computeBoundingBox();
   _steps[step]->setTime(time);
@@ -108,6 +110,7 @@ bool PViewDataGModel::addData(GModel *model, const std::vector<std::size_t> &tag
 
   while(step >= (int)_steps.size())
     _steps.push_back(new stepData<double>(model, numComp));
+  _steps[step]->keepInMemory();
   _steps[step]->fillEntities();
   _steps[step]->computeBoundingBox();
   _steps[step]->setTime(time);
@@ -132,35 +135,13 @@ void PViewDataGModel::destroyData()
   for(std::size_t i = 0; i < _steps.size(); i++) _steps[i]->destroyData();
 }
 
-bool PViewDataGModel::readMSH(const std::string &viewName,
-                              const std::string &fileName, int fileIndex,
-                              FILE *fp, bool binary, bool swap, int step,
-                              double time, int partition, int numComp,
-                              int numEnt,
-                              const std::string &interpolationScheme)
+// read numEnt records (tag, number of values if multiple, values) into the
+// step, and update the min/max
+static bool readMSHRecords(stepData<double> *s, FILE *fp, bool binary,
+                           bool swap, bool multiple, int numEnt, double &min,
+                           double &max)
 {
-  Msg::Debug("Reading view `%s' step %d (time %g) partition %d: %d records",
-             viewName.c_str(), step, time, partition, numEnt);
-
-  while(step >= (int)_steps.size())
-    _steps.push_back(new stepData<double>(GModel::current(), numComp));
-  _steps[step]->fillEntities();
-  _steps[step]->computeBoundingBox();
-  _steps[step]->setFileName(fileName);
-  _steps[step]->setFileIndex(fileIndex);
-  _steps[step]->setTime(time);
-
-  /*
-  // if we already have maxSteps for this view, return
-  int numSteps = 0, maxSteps = 1000000000;
-  for(std::size_t i = 0; i < _steps.size(); i++)
-    numSteps += _steps[i]->getNumData() ? 1 : 0;
-  if(numSteps > maxSteps) return true;
-  */
-
-  _steps[step]->resizeData(numEnt);
-
-  Msg::StartProgressMeter(numEnt);
+  int numComp = s->getNumComponents();
   for(int i = 0; i < numEnt; i++) {
     int num;
     if(binary) {
@@ -172,7 +153,7 @@ bool PViewDataGModel::readMSH(const std::string &viewName,
     }
     if(num < 0) return false;
     int mult = 1;
-    if(_type == ElementNodeData || _type == GaussPointData) {
+    if(multiple) {
       if(binary) {
         if(fread(&mult, sizeof(int), 1, fp) != 1) return false;
         if(swap) SwapBytes((char *)&mult, sizeof(int), 1);
@@ -181,7 +162,7 @@ bool PViewDataGModel::readMSH(const std::string &viewName,
         if(fscanf(fp, "%d", &mult) != 1) return false;
       }
     }
-    double *d = _steps[step]->getData(num, true, mult);
+    double *d = s->getData(num, true, mult);
     if(binary) {
       if((int)fread(d, sizeof(double), numComp * mult, fp) != numComp * mult)
         return false;
@@ -198,16 +179,98 @@ bool PViewDataGModel::readMSH(const std::string &viewName,
     // elements many times)
     for(int j = 0; j < mult; j++) {
       double val = ComputeScalarRep(numComp, &d[numComp * j]);
-      _steps[step]->setMin(std::min(_steps[step]->getMin(), val));
-      _steps[step]->setMax(std::max(_steps[step]->getMax(), val));
-      _min = std::min(_min, val);
-      _max = std::max(_max, val);
+      s->setMin(std::min(s->getMin(), val));
+      s->setMax(std::max(s->getMax(), val));
+      min = std::min(min, val);
+      max = std::max(max, val);
     }
     if(numEnt > 100000) Msg::ProgressMeter(i + 1, true, "Reading data");
   }
+  return true;
+}
+
+template <>
+bool readStepData<double>(const std::vector<stepDataBlock> &blocks,
+                          stepData<double> *step)
+{
+  FILE *fp = 0;
+  std::string fileName;
+  double min = VAL_INF, max = -VAL_INF;
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    const stepDataBlock &b = blocks[i];
+    if(!fp || b.fileName != fileName) {
+      if(fp) fclose(fp);
+      fileName = b.fileName;
+      Msg::Debug("Loading step data from file '%s'", fileName.c_str());
+      fp = Fopen(fileName.c_str(), "rb");
+      if(!fp) {
+        Msg::Error("Unable to open file '%s'", fileName.c_str());
+        return false;
+      }
+    }
+    if(fseek(fp, b.offset, SEEK_SET) ||
+       !readMSHRecords(step, fp, b.binary, b.swap, b.multiple, b.numEnt, min,
+                       max)) {
+      fclose(fp);
+      return false;
+    }
+  }
+  if(fp) fclose(fp);
+  return true;
+}
+
+bool PViewDataGModel::readMSH(const std::string &viewName,
+                              const std::string &fileName, int fileIndex,
+                              FILE *fp, bool binary, bool swap, int step,
+                              double time, int partition, int numComp,
+                              int numEnt,
+                              const std::string &interpolationScheme)
+{
+  Msg::Debug("Reading view `%s' step %d (time %g) partition %d: %d records",
+             viewName.c_str(), step, time, partition, numEnt);
+
+  while(step >= (int)_steps.size())
+    _steps.push_back(new stepData<double>(GModel::current(), numComp));
+  _steps[step]->fillEntities();
+  _steps[step]->computeBoundingBox();
+  _steps[step]->setFileName(fileName);
+  _steps[step]->setFileIndex(fileIndex);
+  _steps[step]->setTime(time);
+
+  /*
+  // if we already have maxSteps for this view, return
+  int numSteps = 0, maxSteps = 1000000000;
+  for(std::size_t i = 0; i < _steps.size(); i++)
+    numSteps += _steps[i]->getNumData() ? 1 : 0;
+  if(numSteps > maxSteps) return true;
+  */
+
+  // if requested, only keep a limited number of steps in memory: the other
+  // ones will be reloaded from the file when needed
+  _cache.maxSteps = CTX::instance()->post.maxStepsInMemory;
+  bool onDemand = (_cache.maxSteps > 0 &&
+                   (_steps[step]->getFileBlocks().size() ||
+                    !_steps[step]->hasData()));
+
+  _steps[step]->resizeData(numEnt);
+
+  stepDataBlock block;
+  block.fileName = fileName;
+  block.offset = ftell(fp);
+  block.numEnt = numEnt;
+  block.binary = binary;
+  block.swap = swap;
+  block.multiple = (_type == ElementNodeData || _type == GaussPointData);
+
+  Msg::StartProgressMeter(numEnt);
+  if(!readMSHRecords(_steps[step], fp, binary, swap, block.multiple, numEnt,
+                     _min, _max))
+    return false;
   Msg::StopProgressMeter();
   if(partition >= 0) _steps[step]->getPartitions().insert(partition);
 
+  if(onDemand && block.offset >= 0) _steps[step]->addFileBlock(block, &_cache);
+
   finalize(false, interpolationScheme);
   return true;
 }
@@ -11,6 +11,45 @@
 
 #include <dofManager.h>
 
+void dofIndex::reserve(std::size_t n)
+{
+  // keep the load factor below 1/2
+  std::size_t capacity = 16;
+  while(capacity < 2 * n) capacity *= 2;
+  if(capacity <= _values.size()) return;
+  std::vector<Dof> keys(capacity, Dof(0, 0));
+  std::vector<int> values(capacity, -1);
+  keys.swap(_keys);
+  values.swap(_values);
+  _size = 0;
+  for(std::size_t i = 0; i < values.size(); i++)
+    if(values[i] >= 0) set(keys[i], values[i]);
+}
+
+void dofIndex::set(const Dof &key, int value)
+{
+  if(2 * (_size + 1) > _values.size()) reserve(2 * (_size + 1));
+  const std::size_t mask = _values.size() - 1;
+  for(std::size_t i = _slot(key);; i = (i + 1) & mask) {
+    if(_values[i] < 0) {
+      _keys[i] = key;
+      _values[i] = value;
+      _size++;
+      return;
+    }
+    if(_keys[i] == key) {
+      _values[i] = value;
+      return;
+    }
+  }
+}
+
+void dofIndex::shift(int offset)
+{
+  for(std::size_t i = 0; i < _values.size(); i++)
+    if(_values[i] >= 0) _values[i] += offset;
+}
+
 template <> void dofManager<double>::scatterSolution()
 {
 #ifdef HAVE_MPI
@@ -67,9 +106,7 @@ void dofManagerBase::_parallelFinalize()
   if(Msg::GetCommRank() != Msg::GetCommSize() - 1)
     MPI_Send(&numTotal, 1, MPI_INT, Msg::GetCommRank() + 1, 0, MPI_COMM_WORLD);
   MPI_Bcast(&numTotal, 1, MPI_INT, Msg::GetCommSize() - 1, MPI_COMM_WORLD);
-  for(std::map<Dof, int>::iterator it = unknown.begin(); it != unknown.end();
-      it++)
-    it->second += numStart;
+  unknown.shift(numStart);
   std::vector<std::list<Dof> > ghostedByProc;
   int *nRequest = new int[Msg::GetCommSize()];
   int *nRequested = new int[Msg::GetCommSize()];
@@ -124,10 +161,9 @@ void dofManagerBase::_parallelFinalize()
     if(status.MPI_TAG == 0) {
       for(int j = 0; j < nRequested[index]; j++) {
         Dof d(recv0[index][j * 2], recv0[index][j * 2 + 1]);
-        std::map<Dof, int>::iterator it = unknown.find(d);
-        if(it == unknown.end())
-          Msg::Error("ghost Dof does not exist on parent process");
-        send1[index][j] = it->second;
+        int n = unknown.find(d);
+        if(n < 0) Msg::Error("ghost Dof does not exist on parent process");
+        send1[index][j] = n;
         parentByProc[index][j] = d;
       }
       MPI_Isend(send1[index], nRequested[index], MPI_INT, index, 1,
@@ -139,7 +175,7 @@ void dofManagerBase::_parallelFinalize()
   for(std::map<Dof, std::pair<int, int> >::iterator it = ghostByDof.begin();
       it != ghostByDof.end(); it++) {
     int proc = it->second.first;
-    unknown[it->first] = recv1[proc][nRequest[proc]++];
+    unknown.set(it->first, recv1[proc][nRequest[proc]++]);
   }
   MPI_Waitall(Msg::GetCommSize(), reqSend0, MPI_STATUS_IGNORE);
   MPI_Waitall(Msg::GetCommSize(), reqSend1, MPI_STATUS_IGNORE);
@@ -81,12 +81,50 @@ public:
   typename dofTraits<T>::VecType shift;
 };
 
+// Flat hash table (open addressing with linear probing) giving the number of
+// each unknown Dof. Lookups are O(1) and do not chase pointers, which matters
+// since they are performed for each entry during assembly.
+class dofIndex {
+private:
+  std::vector<Dof> _keys;
+  std::vector<int> _values; // -1 for empty slots
+  std::size_t _size;
+  inline std::size_t _slot(const Dof &key) const
+  {
+    unsigned long long h =
+      (unsigned long long)key.getEntity() * 11400714819323198485ULL ^
+      (unsigned long long)(unsigned int)key.getType() * 14029467366897019727ULL;
+    return (std::size_t)(h ^ (h >> 29)) & (_values.size() - 1);
+  }
+
+public:
+  dofIndex() : _size(0) {}
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  // make room for n entries
+  void reserve(std::size_t n);
+  // return the number associated with the Dof, or -1 if it is not present
+  inline int find(const Dof &key) const
+  {
+    if(_values.empty()) return -1;
+    const std::size_t mask = _values.size() - 1;
+    for(std::size_t i = _slot(key);; i = (i + 1) & mask) {
+      if(_values[i] < 0) return -1;
+      if(_keys[i] == key) return _values[i];
+    }
+  }
+  // associate a (non-negative) number with the Dof
+  void set(const Dof &key, int value);
+  // add the offset to all the numbers
+  void shift(int offset);
+};
+
 // non template part that can be implemented in the cxx file (and so avoid to
 // include mpi.h in the .h file)
 class dofManagerBase {
 protected:
   // numbering of unknown dof blocks
-  std::map<Dof, int> unknown;
+  dofIndex unknown;
 
   // associatations (not used ?)
   std::map<Dof, Dof> associatedWith;
@@ -152,7 +190,7 @@ public:
   virtual ~dofManager() {}
   virtual inline void fixDof(Dof key, const dataVec &value)
   {
-    if(unknown.find(key) != unknown.end()) return;
+    if(unknown.find(key) >= 0) return;
     fixed[key] = value;
   }
   inline void fixDof(long int ent, int type, const dataVec &value)
@@ -181,8 +219,8 @@ public:
 
   virtual inline bool isAnUnknown(Dof key) const
   {
-    if(ghostValue.find(key) == ghostValue.end()) {
-      if(unknown.find(key) != unknown.end()) return true;
+    if(ghostValue.empty() || ghostValue.find(key) == ghostValue.end()) {
+      if(unknown.find(key) >= 0) return true;
     }
     return false;
   }
@@ -212,19 +250,18 @@ public:
   }
   virtual inline void numberDof(Dof key)
   {
-    if(associatedWith.find(key) != associatedWith.end()) return;
-    if(fixed.find(key) != fixed.end()) return;
-    if(constraints.find(key) != constraints.end()) return;
-    if(ghostByDof.find(key) != ghostByDof.end()) return;
-
-    std::map<Dof, int>::iterator it = unknown.find(key);
-    if(it == unknown.end()) {
-      std::size_t size = unknown.size();
-      unknown[key] = size;
-    }
+    if(unknown.find(key) >= 0) return;
+    if(!associatedWith.empty() && associatedWith.find(key) != associatedWith.end())
+      return;
+    if(!fixed.empty() && fixed.find(key) != fixed.end()) return;
+    if(!constraints.empty() && constraints.find(key) != constraints.end())
+      return;
+    if(!ghostByDof.empty() && ghostByDof.find(key) != ghostByDof.end()) return;
+    unknown.set(key, unknown.size());
   }
   virtual inline void numberDof(const std::vector<Dof> &R)
   {
+    unknown.reserve(unknown.size() + R.size());
     for(std::size_t i = 0; i < R.size(); i++) this->numberDof(R[i]);
   }
   inline void numberDof(long int ent, int type) { numberDof(Dof(ent, type)); }
@@ -235,7 +272,7 @@ public:
   virtual inline void getDofValue(std::vector<Dof> &keys,
                                   std::vector<dataVec> &Vals)
   {
-    for(std::size_t i = 0; i < keys.size(); i++) {
+    for(std::size_t i = 0; i < keys.size() && !associatedWith.empty(); i++) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(keys[i]);
       if (it != associatedWith.end())keys[i] = it->second;
     }
@@ -248,10 +285,10 @@ public:
 
   virtual inline bool getAnUnknown(Dof key, dataVec &val) const
   {
-    if(ghostValue.find(key) == ghostValue.end()) {
-      std::map<Dof, int>::const_iterator it = unknown.find(key);
-      if(it != unknown.end()) {
-        _current->getFromSolution(it->second, val);
+    if(ghostValue.empty() || ghostValue.find(key) == ghostValue.end()) {
+      int n = unknown.find(key);
+      if(n >= 0) {
+        _current->getFromSolution(n, val);
         return true;
       }
     }
@@ -272,19 +309,19 @@ public:
 
   virtual inline void getDofValue(Dof key, dataVec &val) const
   {
-    {      
+    if(!associatedWith.empty()) {
       typename std::map<Dof, Dof>::const_iterator it = associatedWith.find(key);
       if (it != associatedWith.end()){
 	//	  printf("ass to %d\n",it->second.getEntity());
-	std::map<Dof, int>::const_iterator itx = unknown.find(it->second);
-	if(itx != unknown.end()) {
-	  _current->getFromSolution(itx->second, val);
+	int n = unknown.find(it->second);
+	if(n >= 0) {
+	  _current->getFromSolution(n, val);
 	  return;
 	}
 	key = it->second;
       }
     }
-    {
+    if(!ghostValue.empty()) {
       typename std::map<Dof, dataVec>::const_iterator it = ghostValue.find(key);
       if(it != ghostValue.end()) {
         val = it->second;
@@ -292,9 +329,9 @@ public:
       }
     }
     {
-      std::map<Dof, int>::const_iterator it = unknown.find(key);
-      if(it != unknown.end()) {
-        _current->getFromSolution(it->second, val);
+      int n = unknown.find(key);
+      if(n >= 0) {
+        _current->getFromSolution(n, val);
         return;
       }
     }
@@ -335,8 +372,7 @@ public:
   virtual inline void insertInSparsityPatternLinConst(const Dof &R,
                                                       const Dof &C)
   {
-    std::map<Dof, int>::iterator itR = unknown.find(R);
-    if(itR != unknown.end()) {
+    if(unknown.find(R) >= 0) {
       typename std::map<Dof, DofAffineConstraint<dataVec> >::iterator
         itConstraint;
       itConstraint = constraints.find(C);
@@ -362,11 +398,11 @@ public:
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    std::map<Dof, int>::iterator itR = unknown.find(R);
-    if(itR != unknown.end()) {
-      std::map<Dof, int>::iterator itC = unknown.find(C);
-      if(itC != unknown.end()) {
-        _current->insertInSparsityPattern(itR->second, itC->second);
+    int nR = unknown.find(R);
+    if(nR >= 0) {
+      int nC = unknown.find(C);
+      if(nC >= 0) {
+        _current->insertInSparsityPattern(nR, nC);
       }
       else {
         typename std::map<Dof, dataVec>::iterator itFixed = fixed.find(C);
@@ -376,7 +412,7 @@ public:
           insertInSparsityPatternLinConst(R, C);
       }
     }
-    if(itR == unknown.end()) {
+    else {
       insertInSparsityPatternLinConst(R, C);
     }
   }
@@ -390,15 +426,34 @@ public:
     }
   }
 
+  // position of the (R, C) entry in the storage of the current matrix, or -1
+  // if the entry cannot be assembled directly with assembleAt() (e.g. if R or
+  // C is not an unknown, or if the linear system does not support it)
+  inline long int getMatrixPosition(const Dof &R, const Dof &C)
+  {
+    if(_isParallel && !_parallelFinalized) _parallelFinalize();
+    if(!_current->isAllocated()) _current->allocate(sizeOfR());
+    int nR = unknown.find(R);
+    if(nR < 0) return -1;
+    int nC = unknown.find(C);
+    if(nC < 0) return -1;
+    return _current->getMatrixPosition(nR, nC);
+  }
+  inline int getUnknownNumber(const Dof &R) const { return unknown.find(R); }
+  inline void assembleAt(long int position, const dataMat &value)
+  {
+    _current->addToMatrixAt(position, value);
+  }
+
   virtual inline void assemble(const Dof &R, const Dof &C, const dataMat &value)
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    std::map<Dof, int>::iterator itR = unknown.find(R);
-    if(itR != unknown.end()) {
-      std::map<Dof, int>::iterator itC = unknown.find(C);
-      if(itC != unknown.end()) {
-        _current->addToMatrix(itR->second, itC->second, value);
+    int nR = unknown.find(R);
+    if(nR >= 0) {
+      int nC = unknown.find(C);
+      if(nC >= 0) {
+        _current->addToMatrix(nR, nC, value);
       }
       else {
         typename std::map<Dof, dataVec>::iterator itFixed = fixed.find(C);
@@ -406,13 +461,13 @@ public:
           // tmp = -value * itFixed->second
           dataVec tmp(itFixed->second);
           dofTraits<T>::gemm(tmp, value, itFixed->second, -1, 0);
-          _current->addToRightHandSide(itR->second, tmp);
+          _current->addToRightHandSide(nR, tmp);
         }
         else
           assembleLinConst(R, C, value);
       }
     }
-    if(itR == unknown.end()) {
+    else {
       assembleLinConst(R, C, value);
     }
   }
@@ -421,33 +476,19 @@ public:
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    printf("coucou\n");
 
-    for(std::size_t i = 0; i < R.size(); i++) {
+    for(std::size_t i = 0; i < R.size() && !associatedWith.empty(); i++) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(R[i]);
       if (it != associatedWith.end())R[i] = it->second;
     }
-    for(std::size_t i = 0; i < C.size(); i++) {
+    for(std::size_t i = 0; i < C.size() && !associatedWith.empty(); i++) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(C[i]);
       if (it != associatedWith.end())C[i] = it->second;
     }
-    
-    std::vector<int> NR(R.size()), NC(C.size());
 
-    for(std::size_t i = 0; i < R.size(); i++) {
-      std::map<Dof, int>::iterator itR = unknown.find(R[i]);
-      if(itR != unknown.end())
-        NR[i] = itR->second;
-      else
-        NR[i] = -1;
-    }
-    for(std::size_t i = 0; i < C.size(); i++) {
-      std::map<Dof, int>::iterator itC = unknown.find(C[i]);
-      if(itC != unknown.end())
-        NC[i] = itC->second;
-      else
-        NC[i] = -1;
-    }
+    std::vector<int> NR(R.size()), NC(C.size());
+    for(std::size_t i = 0; i < R.size(); i++) NR[i] = unknown.find(R[i]);
+    for(std::size_t i = 0; i < C.size(); i++) NC[i] = unknown.find(C[i]);
     for(std::size_t i = 0; i < R.size(); i++) {
       if(NR[i] != -1) {
         for(std::size_t j = 0; j < C.size(); j++) {
@@ -481,22 +522,14 @@ public:
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    printf("coucou RHS\n");
 
-    for(std::size_t i = 0; i < R.size(); i++) {
+    for(std::size_t i = 0; i < R.size() && !associatedWith.empty(); i++) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(R[i]);
       if (it != associatedWith.end())R[i] = it->second;
     }
 
-
     std::vector<int> NR(R.size());
-    for(std::size_t i = 0; i < R.size(); i++) {
-      std::map<Dof, int>::iterator itR = unknown.find(R[i]);
-      if(itR != unknown.end())
-        NR[i] = itR->second;
-      else
-        NR[i] = -1;
-    }
+    for(std::size_t i = 0; i < R.size(); i++) NR[i] = unknown.find(R[i]);
     for(std::size_t i = 0; i < R.size(); i++) {
       if(NR[i] != -1) {
         _current->addToRightHandSide(NR[i], m(i));
@@ -521,19 +554,13 @@ public:
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    for(std::size_t i = 0; i < R.size(); i++) {
+    for(std::size_t i = 0; i < R.size() && !associatedWith.empty(); i++) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(R[i]);
       if (it != associatedWith.end())R[i] = it->second;
     }
 
     std::vector<int> NR(R.size());
-    for(std::size_t i = 0; i < R.size(); i++) {
-      std::map<Dof, int>::iterator itR = unknown.find(R[i]);
-      if(itR != unknown.end())
-        NR[i] = itR->second;
-      else
-        NR[i] = -1;
-    }
+    for(std::size_t i = 0; i < R.size(); i++) NR[i] = unknown.find(R[i]);
     for(std::size_t i = 0; i < R.size(); i++) {
       if(NR[i] != -1) {
         for(std::size_t j = 0; j < R.size(); j++) {
@@ -576,9 +603,9 @@ public:
   {
     if(_isParallel && !_parallelFinalized) _parallelFinalize();
     if(!_current->isAllocated()) _current->allocate(sizeOfR());
-    std::map<Dof, int>::iterator itR = unknown.find(R);
-    if(itR != unknown.end()) {
-      _current->addToRightHandSide(itR->second, value);
+    int nR = unknown.find(R);
+    if(nR >= 0) {
+      _current->addToRightHandSide(nR, value);
     }
     else {
       typename std::map<Dof, DofAffineConstraint<dataVec> >::iterator
@@ -656,8 +683,8 @@ public:
   virtual inline void assembleLinConst(const Dof &R, const Dof &C,
                                        const dataMat &value)
   {
-    std::map<Dof, int>::iterator itR = unknown.find(R);
-    if(itR != unknown.end()) {
+    int nR = unknown.find(R);
+    if(nR >= 0) {
       typename std::map<Dof, DofAffineConstraint<dataVec> >::iterator
         itConstraint;
       itConstraint = constraints.find(C);
@@ -670,7 +697,7 @@ public:
         }
         dataMat tmp2(value);
         dofTraits<T>::gemm(tmp2, value, itConstraint->second.shift, -1, 0);
-        _current->addToRightHandSide(itR->second, tmp2);
+        _current->addToRightHandSide(nR, tmp2);
       }
     }
     else { // test function ; (no shift ?)
@@ -708,17 +735,11 @@ public:
   virtual int getDofNumber(const Dof &ky)
   {
     Dof key = ky;
-    {
+    if(!associatedWith.empty()) {
       std::map<Dof, Dof>::iterator it = associatedWith.find(ky);
       if (it != associatedWith.end())key = it->second;
     }
-    
-    std::map<Dof, int>::iterator it = unknown.find(key);
-    if(it == unknown.end()) {
-      return -1;
-    }
-    else
-      return it->second;
+    return unknown.find(key);
   }
 
   virtual void clearAllLineConstraints() { constraints.clear(); }
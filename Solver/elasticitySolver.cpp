@@ -573,13 +573,20 @@ void elasticitySolver::assemble(linearSystem<double> *lsys)
   }
   // Assemble elastic term for
   GaussQuadrature Integ_Bulk(GaussQuadrature::GradGrad);
+  double t1 = TimeOfDay();
+  std::size_t numElements = 0;
   for(std::size_t i = 0; i < elasticFields.size(); i++) {
     printf("Elastic\n");
     IsotropicElasticTerm Eterm(*LagSpace, elasticFields[i]._e,
                                elasticFields[i]._nu);
     Assemble(Eterm, *LagSpace, elasticFields[i].g->begin(),
              elasticFields[i].g->end(), Integ_Bulk, *pAssembler);
+    numElements += elasticFields[i].g->size();
   }
+  double t2 = TimeOfDay();
+  if(numElements)
+    printf("Elastic term assembled on %lu elements in %g s (%g us per "
+           "element)\n", numElements, t2 - t1, 1e6 * (t2 - t1) / numElements);
 
   printf("nDofs=%d\n", pAssembler->sizeOfR());
   printf("nFixed=%d\n", pAssembler->sizeOfF());
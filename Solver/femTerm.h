@@ -15,6 +15,7 @@
 #include "GModel.h"
 #include "SElement.h"
 #include "groupOfElements.h"
+#include "scatterMap.h"
 
 // a nodal finite element term : variables are always defined at nodes
 // of the mesh
@@ -43,6 +44,8 @@ public:
   }
   // compute the elementary matrix
   virtual void elementMatrix(SElement *se, fullMatrix<dataMat> &m) const = 0;
+  // can elementMatrix() be called concurrently for different elements?
+  virtual bool threadSafeElementMatrix() const { return true; }
   virtual void elementVector(SElement *se, fullVector<dataVec> &m) const
   {
     m.scale(0.0);
@@ -72,6 +75,40 @@ public:
     elementMatrix(se, localMatrix);
     addToMatrix(dm, localMatrix, se);
   }
+  // build the scatter map of the elements in the group, for the (repeated)
+  // parallel assembly of their contributions with addToMatrix(dm, map)
+  void buildScatterMap(dofManager<dataVec> &dm, groupOfElements &L,
+                       scatterMap<dataVec> &map) const
+  {
+    map.build(dm, L.begin(), L.end(),
+              [this](MElement *e, std::vector<Dof> &R, std::vector<Dof> &C) {
+                SElement se(e);
+                for(int j = 0; j < sizeOfR(&se); j++)
+                  R.push_back(getLocalDofR(&se, j));
+                for(int k = 0; k < sizeOfC(&se); k++)
+                  C.push_back(getLocalDofC(&se, k));
+              });
+  }
+
+  // add the contribution from all the elements in the scatter map, in
+  // parallel if elementMatrix() is thread-safe
+  void addToMatrix(dofManager<dataVec> &dm,
+                   const scatterMap<dataVec> &map) const
+  {
+    map.assemble(
+      dm,
+      [this](MElement *e, fullMatrix<dataMat> &localMatrix) {
+        SElement se(e);
+        localMatrix.resize(sizeOfR(&se), sizeOfC(&se));
+        elementMatrix(&se, localMatrix);
+      },
+      [this, &dm](MElement *e, fullMatrix<dataMat> &localMatrix) {
+        SElement se(e);
+        addToMatrix(dm, localMatrix, &se);
+      },
+      threadSafeElementMatrix());
+  }
+
   void addToMatrix(dofManager<dataVec> &dm, fullMatrix<dataMat> &localMatrix,
                    SElement *se) const
   {
@@ -47,6 +47,12 @@ public:
     return Dof(se->getMeshElement()->getShapeFunctionNode(iRow)->getNum(),
                Dof::createTypeWithTwoInts(0, _iFieldC));
   }
+  // the coefficients are shared: they cannot be evaluated concurrently if
+  // they depend on the element given to setElement()
+  bool threadSafeElementMatrix() const
+  {
+    return !(_k && _k->dependsOnElement()) && !(_a && _a->dependsOnElement());
+  }
   virtual void elementMatrix(SElement *se, fullMatrix<scalar> &m) const
   {
     MElement *e = se->getMeshElement();
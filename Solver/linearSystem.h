@@ -45,6 +45,12 @@ public:
   virtual void getFromRightHandSide(int _row, scalar &val) const = 0;
   virtual void getFromSolution(int _row, scalar &val) const = 0;
   virtual void addToSolution(int _row, const scalar &val) = 0;
+  // direct access to the matrix storage, for systems whose sparsity pattern
+  // is fixed once the entries have been pre-allocated: return the position of
+  // entry (_row, _col) in the storage, or -1 if it is not available; adding
+  // values at different positions can then be done concurrently
+  virtual long int getMatrixPosition(int _row, int _col) { return -1; }
+  virtual void addToMatrixAt(long int _position, const scalar &val) {}
 };
 
 #endif
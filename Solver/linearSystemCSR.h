@@ -116,6 +116,28 @@ public:
     else
       ptr[position] = n;
   }
+  virtual long int getMatrixPosition(int il, int ic)
+  {
+    if(!_entriesPreAllocated) preAllocateEntries();
+    if(!_entriesPreAllocated || !sorted) return -1;
+    INDEX_TYPE *jptr = (INDEX_TYPE *)_jptr->array;
+    INDEX_TYPE *ai = (INDEX_TYPE *)_ai->array;
+    int p0 = jptr[il];
+    int p1 = jptr[il + 1];
+    while(p0 < p1) {
+      int position = (p0 + p1) / 2;
+      if(ai[position] < ic)
+        p0 = position + 1;
+      else
+        p1 = position;
+    }
+    if(p0 < jptr[il + 1] && ai[p0] == ic) return p0;
+    return -1;
+  }
+  virtual void addToMatrixAt(long int position, const scalar &val)
+  {
+    ((scalar *)_a->array)[position] += val;
+  }
   virtual void getMatrix(INDEX_TYPE *&jptr, INDEX_TYPE *&ai, double *&a);
 
   virtual void getFromMatrix(int row, int col, scalar &val) const
@@ -0,0 +1,218 @@
+// Gmsh - Copyright (C) 1997-2020 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues.
+
+#ifndef SCATTER_MAP_H
+#define SCATTER_MAP_H
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include "dofManager.h"
+#include "fullMatrix.h"
+#include "MElement.h"
+
+// Scatter map for the (repeated) assembly of element matrices in a linear
+// system whose sparsity pattern is fixed once its entries have been
+// pre-allocated, e.g. linearSystemCSR.
+//
+// The map is built once, with build(): the sparsity pattern of the elements is
+// inserted in the system, and the position of each entry of each element
+// matrix in the storage of the system matrix is computed and stored. The
+// elements are then colored so that two elements of the same color never
+// share a row, which allows assemble() to add the element matrices of each
+// color in parallel, directly at their precomputed positions. Subsequent
+// assemblies (e.g. in nonlinear or time-stepping solves, after zeroMatrix())
+// reuse the same map. Elements with fixed or constrained dofs, or whose entries
+// are not available in the storage, are assembled serially through the
+// dofManager.
+template <class T> class scatterMap {
+public:
+  typedef typename dofTraits<T>::VecType dataVec;
+  typedef typename dofTraits<T>::MatType dataMat;
+
+private:
+  // elements assembled directly, sorted by color
+  std::vector<MElement *> _elements;
+  // index in _elements of the first element of each color (plus the end)
+  std::vector<std::size_t> _colors;
+  // index in _positions of the first entry of each element (plus the end)
+  std::vector<std::size_t> _offsets;
+  // positions of the entries of the element matrices (stored row-wise)
+  std::vector<long int> _positions;
+  // elements assembled through the dofManager
+  std::vector<MElement *> _others;
+  // one element of each type, used to initialize the shared caches (basis
+  // functions, integration rules, ...) before assembling in parallel
+  std::vector<MElement *> _firstOfType;
+
+public:
+  scatterMap() {}
+  void clear()
+  {
+    _elements.clear();
+    _colors.clear();
+    _offsets.clear();
+    _positions.clear();
+    _others.clear();
+    _firstOfType.clear();
+  }
+  bool empty() const { return _elements.empty() && _others.empty(); }
+  std::size_t getNumColors() const
+  {
+    return _colors.empty() ? 0 : _colors.size() - 1;
+  }
+  std::size_t getNumDirectElements() const { return _elements.size(); }
+
+  // build the map for the elements in [itbegin, itend); keys(e, R, C) should
+  // fill the row and column dofs of the element matrix of e
+  template <class Iterator, class Keys>
+  void build(dofManager<dataVec> &dm, Iterator itbegin, Iterator itend,
+             const Keys &keys)
+  {
+    clear();
+    std::vector<MElement *> elements;
+    std::vector<std::size_t> offsets(1, 0);
+    std::vector<std::pair<Dof, Dof> > entries;
+    std::vector<Dof> R, C;
+    for(Iterator it = itbegin; it != itend; ++it) {
+      MElement *e = *it;
+      R.clear();
+      C.clear();
+      keys(e, R, C);
+      for(std::size_t i = 0; i < R.size(); i++) {
+        for(std::size_t j = 0; j < C.size(); j++) {
+          dm.insertInSparsityPattern(R[i], C[j]);
+          entries.push_back(std::make_pair(R[i], C[j]));
+        }
+      }
+      elements.push_back(e);
+      offsets.push_back(entries.size());
+    }
+
+    // compute the positions (this pre-allocates the entries, if needed)
+    std::vector<long int> positions(entries.size());
+    std::vector<char> direct(elements.size(), 1);
+    for(std::size_t i = 0; i < elements.size(); i++) {
+      for(std::size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+        positions[k] = dm.getMatrixPosition(entries[k].first,
+                                            entries[k].second);
+        if(positions[k] < 0) direct[i] = 0;
+      }
+    }
+
+    // rows of each element assembled directly
+    std::vector<std::vector<int> > rows(elements.size());
+    int numRows = 0;
+    std::set<int> types;
+    for(std::size_t i = 0; i < elements.size(); i++) {
+      if(types.insert(elements[i]->getTypeForMSH()).second)
+        _firstOfType.push_back(elements[i]);
+      if(!direct[i]) {
+        _others.push_back(elements[i]);
+        continue;
+      }
+      for(std::size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+        int n = dm.getUnknownNumber(entries[k].first);
+        if(rows[i].empty() || rows[i].back() != n) rows[i].push_back(n);
+        numRows = std::max(numRows, n + 1);
+      }
+    }
+    std::vector<std::pair<Dof, Dof> >().swap(entries);
+
+    // greedy coloring: an element gets the smallest color not used by the
+    // elements already colored that share one of its rows
+    std::vector<std::size_t> rowStart(numRows + 1, 0);
+    for(std::size_t i = 0; i < elements.size(); i++)
+      for(std::size_t k = 0; k < rows[i].size(); k++)
+        rowStart[rows[i][k] + 1]++;
+    for(int r = 0; r < numRows; r++) rowStart[r + 1] += rowStart[r];
+    std::vector<std::size_t> rowElements(rowStart[numRows]);
+    std::vector<std::size_t> rowFill(rowStart.begin(), rowStart.end() - 1);
+    std::vector<int> color(elements.size(), -1);
+    std::vector<std::size_t> forbidden;
+    std::vector<std::size_t> numInColor;
+    for(std::size_t i = 0; i < elements.size(); i++) {
+      if(!direct[i]) continue;
+      for(std::size_t k = 0; k < rows[i].size(); k++) {
+        int r = rows[i][k];
+        for(std::size_t l = rowStart[r]; l < rowFill[r]; l++)
+          forbidden[color[rowElements[l]]] = i + 1;
+      }
+      int c = 0;
+      while(c < (int)forbidden.size() && forbidden[c] == i + 1) c++;
+      if(c == (int)forbidden.size()) {
+        forbidden.push_back(0);
+        numInColor.push_back(0);
+      }
+      color[i] = c;
+      numInColor[c]++;
+      for(std::size_t k = 0; k < rows[i].size(); k++) {
+        int r = rows[i][k];
+        rowElements[rowFill[r]++] = i;
+      }
+    }
+
+    // sort the elements assembled directly by color
+    _colors.resize(numInColor.size() + 1, 0);
+    for(std::size_t c = 0; c < numInColor.size(); c++)
+      _colors[c + 1] = _colors[c] + numInColor[c];
+    std::vector<std::size_t> fill(_colors.begin(), _colors.end() - 1);
+    std::vector<std::size_t> order(_colors.back());
+    for(std::size_t i = 0; i < elements.size(); i++)
+      if(direct[i]) order[fill[color[i]]++] = i;
+    _elements.resize(order.size());
+    _offsets.resize(order.size() + 1, 0);
+    for(std::size_t j = 0; j < order.size(); j++) {
+      std::size_t i = order[j];
+      _elements[j] = elements[i];
+      _offsets[j + 1] = _offsets[j] + offsets[i + 1] - offsets[i];
+    }
+    _positions.resize(_offsets.back());
+    for(std::size_t j = 0; j < order.size(); j++) {
+      std::size_t i = order[j];
+      for(std::size_t k = offsets[i]; k < offsets[i + 1]; k++)
+        _positions[_offsets[j] + k - offsets[i]] = positions[k];
+    }
+  }
+
+  // assemble the element matrices of all the elements in the map: matrix(e, m)
+  // should compute the element matrix of e in m, and other(e, m) should
+  // assemble it through the dofManager. If parallel is set, elements of the
+  // same color are processed in parallel, so that matrix() should be
+  // thread-safe
+  template <class Matrix, class Other>
+  void assemble(dofManager<dataVec> &dm, const Matrix &matrix,
+                const Other &other, bool parallel = true) const
+  {
+    fullMatrix<dataMat> m;
+    for(std::size_t i = 0; i < _firstOfType.size(); i++)
+      matrix(_firstOfType[i], m);
+    for(std::size_t i = 0; i < _others.size(); i++) {
+      matrix(_others[i], m);
+      other(_others[i], m);
+    }
+#if defined(_OPENMP)
+#pragma omp parallel if(parallel)
+#endif
+    {
+      fullMatrix<dataMat> localMatrix;
+      for(std::size_t c = 0; c + 1 < _colors.size(); c++) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 64)
+#endif
+        for(long int i = _colors[c]; i < (long int)_colors[c + 1]; i++) {
+          matrix(_elements[i], localMatrix);
+          const long int *pos = &_positions[_offsets[i]];
+          const int nbR = localMatrix.size1(), nbC = localMatrix.size2();
+          for(int r = 0; r < nbR; r++)
+            for(int s = 0; s < nbC; s++)
+              dm.assembleAt(pos[r * nbC + s], localMatrix(r, s));
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -14,6 +14,7 @@
 #include "terms.h"
 #include "quadratureRules.h"
 #include "MVertex.h"
+#include "scatterMap.h"
 
 template <class Iterator, class Assembler>
 void Assemble(BilinearTermBase &term, FunctionSpaceBase &space,
@@ -68,6 +69,45 @@ void Assemble(BilinearTermBase &term, FunctionSpaceBase &space, MElement *e,
   assembler.assemble(R, localMatrix);
 }
 
+// build the scatter map of the elements, for the (repeated) assembly of a
+// symmetric bilinear term with Assemble(term, space, map, ...)
+template <class Iterator, class Assembler>
+void BuildScatterMap(FunctionSpaceBase &space, Iterator itbegin,
+                     Iterator itend, Assembler &assembler,
+                     scatterMap<typename Assembler::dataVec> &map)
+{
+  map.build(assembler, itbegin, itend,
+            [&space](MElement *e, std::vector<Dof> &R, std::vector<Dof> &C) {
+              space.getKeys(e, R);
+              C = R;
+            });
+}
+
+template <class Assembler>
+void Assemble(BilinearTermBase &term, FunctionSpaceBase &space,
+              const scatterMap<typename Assembler::dataVec> &map,
+              QuadratureBase &integrator, Assembler &assembler,
+              bool parallel = false)
+// symmetric; in parallel if requested, in which case term.get() should be
+// thread-safe
+{
+  map.assemble(
+    assembler,
+    [&term, &integrator](MElement *e,
+                         fullMatrix<typename Assembler::dataMat> &m) {
+      IntPt *GP;
+      int npts = integrator.getIntPoints(e, &GP);
+      term.get(e, npts, GP, m);
+    },
+    [&space, &assembler](MElement *e,
+                         fullMatrix<typename Assembler::dataMat> &m) {
+      std::vector<Dof> R;
+      space.getKeys(e, R);
+      assembler.assemble(R, m);
+    },
+    parallel);
+}
+
 template <class Iterator, class Assembler>
 void Assemble(BilinearTermBase &term, FunctionSpaceBase &shapeFcts,
               FunctionSpaceBase &testFcts, Iterator itbegin, Iterator itend,
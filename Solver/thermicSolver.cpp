@@ -11,6 +11,7 @@
 #include "linearSystemFull.h"
 #include "Numeric.h"
 #include "GModel.h"
+#include "OS.h"
 #include "functionSpace.h"
 #include "terms.h"
 #include "solverAlgorithms.h"
@@ -168,12 +169,19 @@ void thermicSolver::assemble(linearSystem<double> *lsys)
   }
   // Assemble thermic term
   GaussQuadrature Integ_Bulk(GaussQuadrature::ValVal);
+  double t1 = TimeOfDay();
+  std::size_t numElements = 0;
   for(std::size_t i = 0; i < thermicFields.size(); i++) {
     printf("Thermic Term\n");
     LaplaceTerm<double, double> Tterm(*LagSpace, thermicFields[i]._k);
     Assemble(Tterm, *LagSpace, thermicFields[i].g->begin(),
              thermicFields[i].g->end(), Integ_Bulk, *pAssembler);
+    numElements += thermicFields[i].g->size();
   }
+  double t2 = TimeOfDay();
+  if(numElements)
+    printf("Thermic term assembled on %lu elements in %g s (%g us per "
+           "element)\n", numElements, t2 - t1, 1e6 * (t2 - t1) / numElements);
 
   /*for (int i = 0;i<pAssembler->sizeOfR();i++){
     for (int j = 0;j<pAssembler->sizeOfR();j++){
@@ -671,8 +671,8 @@ namespace gmsh { // Top-level functions
       //
       // Get the coordinates and the parametric coordinates (if any) of the node
       // with tag `tag'. This function relies on an internal cache (a vector in
-      // case of dense node numbering, a map otherwise); for large meshes accessing
-      // nodes in bulk is often preferable.
+      // case of dense node numbering, a hash table otherwise); for large meshes
+      // accessing nodes in bulk is often preferable.
       GMSH_API void getNode(const std::size_t nodeTag,
                             std::vector<double> & coord,
                             std::vector<double> & parametricCoord);
@@ -681,8 +681,8 @@ namespace gmsh { // Top-level functions
       //
       // Set the coordinates and the parametric coordinates (if any) of the node
       // with tag `tag'. This function relies on an internal cache (a vector in
-      // case of dense node numbering, a map otherwise); for large meshes accessing
-      // nodes in bulk is often preferable.
+      // case of dense node numbering, a hash table otherwise); for large meshes
+      // accessing nodes in bulk is often preferable.
       GMSH_API void setNode(const std::size_t nodeTag,
                             const std::vector<double> & coord,
                             const std::vector<double> & parametricCoord);
@@ -767,8 +767,8 @@ namespace gmsh { // Top-level functions
       //
       // Get the type and node tags of the element with tag `tag'. This function
       // relies on an internal cache (a vector in case of dense element numbering,
-      // a map otherwise); for large meshes accessing elements in bulk is often
-      // preferable.
+      // a hash table otherwise); for large meshes accessing elements in bulk is
+      // often preferable.
       GMSH_API void getElement(const std::size_t elementTag,
                                int & elementType,
                                std::vector<std::size_t> & nodeTags);
@@ -776,7 +776,8 @@ namespace gmsh { // Top-level functions
       // gmsh::model::mesh::getElementByCoordinates
       //
       // Search the mesh for an element located at coordinates (`x', `y', `z').
-      // This function performs a search in a spatial octree. If an element is
+      // This function performs a search in a spatial index (a bounding volume
+      // hierarchy over the bounding boxes of the elements). If an element is
       // found, return its tag, type and node tags, as well as the local
       // coordinates (`u', `v', `w') within the reference element corresponding to
       // search location. If `dim' is >= 0, only search for elements of the given
@@ -797,12 +798,13 @@ namespace gmsh { // Top-level functions
       // gmsh::model::mesh::getElementsByCoordinates
       //
       // Search the mesh for element(s) located at coordinates (`x', `y', `z').
-      // This function performs a search in a spatial octree. Return the tags of
-      // all found elements in `elementTags'. Additional information about the
-      // elements can be accessed through `getElement' and
-      // `getLocalCoordinatesInElement'. If `dim' is >= 0, only search for elements
-      // of the given dimension. If `strict' is not set, use a tolerance to find
-      // elements near the search location.
+      // This function performs a search in a spatial index (a bounding volume
+      // hierarchy over the bounding boxes of the elements). Return the tags of all
+      // found elements in `elementTags'. Additional information about the elements
+      // can be accessed through `getElement' and `getLocalCoordinatesInElement'.
+      // If `dim' is >= 0, only search for elements of the given dimension. If
+      // `strict' is not set, use a tolerance to find elements near the search
+      // location.
       GMSH_API void getElementsByCoordinates(const double x,
                                              const double y,
                                              const double z,
@@ -810,13 +812,33 @@ namespace gmsh { // Top-level functions
                                              const int dim = -1,
                                              const bool strict = false);
 
+      // gmsh::model::mesh::getElementByCoordinatesBatch
+      //
+      // Search the mesh for the elements located at the coordinates `coord' of a
+      // set of points, concatenated: [p1x, p1y, p1z, p2x, ...]. For each point,
+      // return the tag of one element containing it in `elementTags' (0 if no
+      // element is found) and the local coordinates of the point within that
+      // element in `localCoord', concatenated: [p1u, p1v, p1w, p2u, ...]. This
+      // function uses the same spatial index as `getElementByCoordinates', which
+      // is kept across calls until the mesh is modified, and processes the points
+      // in parallel; it should be preferred for locating many points. If `dim' is
+      // >= 0, only search for elements of the given dimension. If `strict' is not
+      // set, use a tolerance to find elements near the search location for the
+      // points that are not found otherwise (this tests all the elements of the
+      // mesh, and can thus be slow if many points lie outside the mesh).
+      GMSH_API void getElementByCoordinatesBatch(const std::vector<double> & coord,
+                                                 std::vector<std::size_t> & elementTags,
+                                                 std::vector<double> & localCoord,
+                                                 const int dim = -1,
+                                                 const bool strict = true);
+
       // gmsh::model::mesh::getLocalCoordinatesInElement
       //
       // Return the local coordinates (`u', `v', `w') within the element
       // `elementTag' corresponding to the model coordinates (`x', `y', `z'). This
       // function relies on an internal cache (a vector in case of dense element
-      // numbering, a map otherwise); for large meshes accessing elements in bulk
-      // is often preferable.
+      // numbering, a hash table otherwise); for large meshes accessing elements in
+      // bulk is often preferable.
       GMSH_API void getLocalCoordinatesInElement(const std::size_t elementTag,
                                                  const double x,
                                                  const double y,
@@ -983,8 +1005,9 @@ namespace gmsh { // Top-level functions
       // Jxu=dx/du, Jyu=dy/du, etc. `determinants' contains the determinant of the
       // Jacobian matrix at each evaluation point. `coord' contains the x, y, z
       // coordinates of the evaluation points. This function relies on an internal
-      // cache (a vector in case of dense element numbering, a map otherwise); for
-      // large meshes accessing Jacobians in bulk is often preferable.
+      // cache (a vector in case of dense element numbering, a hash table
+      // otherwise); for large meshes accessing Jacobians in bulk is often
+      // preferable.
       GMSH_API void getJacobian(const std::size_t elementTag,
                                 const std::vector<double> & localCoord,
                                 std::vector<double> & jacobians,
@@ -1368,8 +1368,8 @@ end
 
 Get the coordinates and the parametric coordinates (if any) of the node with tag
 `tag`. This function relies on an internal cache (a vector in case of dense node
-numbering, a map otherwise); for large meshes accessing nodes in bulk is often
-preferable.
+numbering, a hash table otherwise); for large meshes accessing nodes in bulk is
+often preferable.
 
 Return `coord`, `parametricCoord`.
 """
@@ -1393,8 +1393,8 @@ end
 
 Set the coordinates and the parametric coordinates (if any) of the node with tag
 `tag`. This function relies on an internal cache (a vector in case of dense node
-numbering, a map otherwise); for large meshes accessing nodes in bulk is often
-preferable.
+numbering, a hash table otherwise); for large meshes accessing nodes in bulk is
+often preferable.
 """
 function setNode(nodeTag, coord, parametricCoord)
     ierr = Ref{Cint}()
@@ -1559,7 +1559,7 @@ end
     gmsh.model.mesh.getElement(elementTag)
 
 Get the type and node tags of the element with tag `tag`. This function relies
-on an internal cache (a vector in case of dense element numbering, a map
+on an internal cache (a vector in case of dense element numbering, a hash table
 otherwise); for large meshes accessing elements in bulk is often preferable.
 
 Return `elementType`, `nodeTags`.
@@ -1581,10 +1581,11 @@ end
     gmsh.model.mesh.getElementByCoordinates(x, y, z, dim = -1, strict = false)
 
 Search the mesh for an element located at coordinates (`x`, `y`, `z`). This
-function performs a search in a spatial octree. If an element is found, return
-its tag, type and node tags, as well as the local coordinates (`u`, `v`, `w`)
-within the reference element corresponding to search location. If `dim` is >= 0,
-only search for elements of the given dimension. If `strict` is not set, use a
+function performs a search in a spatial index (a bounding volume hierarchy over
+the bounding boxes of the elements). If an element is found, return its tag,
+type and node tags, as well as the local coordinates (`u`, `v`, `w`) within the
+reference element corresponding to search location. If `dim` is >= 0, only
+search for elements of the given dimension. If `strict` is not set, use a
 tolerance to find elements near the search location.
 
 Return `elementTag`, `elementType`, `nodeTags`, `u`, `v`, `w`.
@@ -1610,11 +1611,12 @@ end
     gmsh.model.mesh.getElementsByCoordinates(x, y, z, dim = -1, strict = false)
 
 Search the mesh for element(s) located at coordinates (`x`, `y`, `z`). This
-function performs a search in a spatial octree. Return the tags of all found
-elements in `elementTags`. Additional information about the elements can be
-accessed through `getElement` and `getLocalCoordinatesInElement`. If `dim` is >=
-0, only search for elements of the given dimension. If `strict` is not set, use
-a tolerance to find elements near the search location.
+function performs a search in a spatial index (a bounding volume hierarchy over
+the bounding boxes of the elements). Return the tags of all found elements in
+`elementTags`. Additional information about the elements can be accessed through
+`getElement` and `getLocalCoordinatesInElement`. If `dim` is >= 0, only search
+for elements of the given dimension. If `strict` is not set, use a tolerance to
+find elements near the search location.
 
 Return `elementTags`.
 """
@@ -1630,12 +1632,44 @@ function getElementsByCoordinates(x, y, z, dim = -1, strict = false)
     return elementTags
 end
 
+"""
+    gmsh.model.mesh.getElementByCoordinatesBatch(coord, dim = -1, strict = true)
+
+Search the mesh for the elements located at the coordinates `coord` of a set of
+points, concatenated: [p1x, p1y, p1z, p2x, ...]. For each point, return the tag
+of one element containing it in `elementTags` (0 if no element is found) and the
+local coordinates of the point within that element in `localCoord`,
+concatenated: [p1u, p1v, p1w, p2u, ...]. This function uses the same spatial
+index as `getElementByCoordinates`, which is kept across calls until the mesh is
+modified, and processes the points in parallel; it should be preferred for
+locating many points. If `dim` is >= 0, only search for elements of the given
+dimension. If `strict` is not set, use a tolerance to find elements near the
+search location for the points that are not found otherwise (this tests all the
+elements of the mesh, and can thus be slow if many points lie outside the mesh).
+
+Return `elementTags`, `localCoord`.
+"""
+function getElementByCoordinatesBatch(coord, dim = -1, strict = true)
+    api_elementTags_ = Ref{Ptr{Csize_t}}()
+    api_elementTags_n_ = Ref{Csize_t}()
+    api_localCoord_ = Ref{Ptr{Cdouble}}()
+    api_localCoord_n_ = Ref{Csize_t}()
+    ierr = Ref{Cint}()
+    ccall((:gmshModelMeshGetElementByCoordinatesBatch, gmsh.lib), Cvoid,
+          (Ptr{Cdouble}, Csize_t, Ptr{Ptr{Csize_t}}, Ptr{Csize_t}, Ptr{Ptr{Cdouble}}, Ptr{Csize_t}, Cint, Cint, Ptr{Cint}),
+          convert(Vector{Cdouble}, coord), length(coord), api_elementTags_, api_elementTags_n_, api_localCoord_, api_localCoord_n_, dim, strict, ierr)
+    ierr[] != 0 && error(gmsh.logger.getLastError())
+    elementTags = unsafe_wrap(Array, api_elementTags_[], api_elementTags_n_[], own=true)
+    localCoord = unsafe_wrap(Array, api_localCoord_[], api_localCoord_n_[], own=true)
+    return elementTags, localCoord
+end
+
 """
     gmsh.model.mesh.getLocalCoordinatesInElement(elementTag, x, y, z)
 
 Return the local coordinates (`u`, `v`, `w`) within the element `elementTag`
 corresponding to the model coordinates (`x`, `y`, `z`). This function relies on
-an internal cache (a vector in case of dense element numbering, a map
+an internal cache (a vector in case of dense element numbering, a hash table
 otherwise); for large meshes accessing elements in bulk is often preferable.
 
 Return `u`, `v`, `w`.
@@ -1869,7 +1903,7 @@ column: [e1g1Jxu, e1g1Jyu, e1g1Jzu, e1g1Jxv, ..., e1g1Jzw, e1g2Jxu, ...,
 e1gGJzw, e2g1Jxu, ...], with Jxu=dx/du, Jyu=dy/du, etc. `determinants` contains
 the determinant of the Jacobian matrix at each evaluation point. `coord`
 contains the x, y, z coordinates of the evaluation points. This function relies
-on an internal cache (a vector in case of dense element numbering, a map
+on an internal cache (a vector in case of dense element numbering, a hash table
 otherwise); for large meshes accessing Jacobians in bulk is often preferable.
 
 Return `jacobians`, `determinants`, `coord`.
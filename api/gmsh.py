@@ -1664,8 +1664,8 @@ class model:
 
             Get the coordinates and the parametric coordinates (if any) of the node
             with tag `tag'. This function relies on an internal cache (a vector in case
-            of dense node numbering, a map otherwise); for large meshes accessing nodes
-            in bulk is often preferable.
+            of dense node numbering, a hash table otherwise); for large meshes
+            accessing nodes in bulk is often preferable.
 
             Return `coord', `parametricCoord'.
             """
@@ -1690,8 +1690,8 @@ class model:
 
             Set the coordinates and the parametric coordinates (if any) of the node
             with tag `tag'. This function relies on an internal cache (a vector in case
-            of dense node numbering, a map otherwise); for large meshes accessing nodes
-            in bulk is often preferable.
+            of dense node numbering, a hash table otherwise); for large meshes
+            accessing nodes in bulk is often preferable.
             """
             api_coord_, api_coord_n_ = _ivectordouble(coord)
             api_parametricCoord_, api_parametricCoord_n_ = _ivectordouble(parametricCoord)
@@ -1868,7 +1868,7 @@ class model:
 
             Get the type and node tags of the element with tag `tag'. This function
             relies on an internal cache (a vector in case of dense element numbering, a
-            map otherwise); for large meshes accessing elements in bulk is often
+            hash table otherwise); for large meshes accessing elements in bulk is often
             preferable.
 
             Return `elementType', `nodeTags'.
@@ -1893,9 +1893,10 @@ class model:
             gmsh.model.mesh.getElementByCoordinates(x, y, z, dim=-1, strict=False)
 
             Search the mesh for an element located at coordinates (`x', `y', `z'). This
-            function performs a search in a spatial octree. If an element is found,
-            return its tag, type and node tags, as well as the local coordinates (`u',
-            `v', `w') within the reference element corresponding to search location. If
+            function performs a search in a spatial index (a bounding volume hierarchy
+            over the bounding boxes of the elements). If an element is found, return
+            its tag, type and node tags, as well as the local coordinates (`u', `v',
+            `w') within the reference element corresponding to search location. If
             `dim' is >= 0, only search for elements of the given dimension. If `strict'
             is not set, use a tolerance to find elements near the search location.
 
@@ -1937,11 +1938,12 @@ class model:
             gmsh.model.mesh.getElementsByCoordinates(x, y, z, dim=-1, strict=False)
 
             Search the mesh for element(s) located at coordinates (`x', `y', `z'). This
-            function performs a search in a spatial octree. Return the tags of all
-            found elements in `elementTags'. Additional information about the elements
-            can be accessed through `getElement' and `getLocalCoordinatesInElement'. If
-            `dim' is >= 0, only search for elements of the given dimension. If `strict'
-            is not set, use a tolerance to find elements near the search location.
+            function performs a search in a spatial index (a bounding volume hierarchy
+            over the bounding boxes of the elements). Return the tags of all found
+            elements in `elementTags'. Additional information about the elements can be
+            accessed through `getElement' and `getLocalCoordinatesInElement'. If `dim'
+            is >= 0, only search for elements of the given dimension. If `strict' is
+            not set, use a tolerance to find elements near the search location.
 
             Return `elementTags'.
             """
@@ -1959,6 +1961,43 @@ class model:
                 raise Exception(logger.getLastError())
             return _ovectorsize(api_elementTags_, api_elementTags_n_.value)
 
+        @staticmethod
+        def getElementByCoordinatesBatch(coord, dim=-1, strict=True):
+            """
+            gmsh.model.mesh.getElementByCoordinatesBatch(coord, dim=-1, strict=True)
+
+            Search the mesh for the elements located at the coordinates `coord' of a
+            set of points, concatenated: [p1x, p1y, p1z, p2x, ...]. For each point,
+            return the tag of one element containing it in `elementTags' (0 if no
+            element is found) and the local coordinates of the point within that
+            element in `localCoord', concatenated: [p1u, p1v, p1w, p2u, ...]. This
+            function uses the same spatial index as `getElementByCoordinates', which is
+            kept across calls until the mesh is modified, and processes the points in
+            parallel; it should be preferred for locating many points. If `dim' is >=
+            0, only search for elements of the given dimension. If `strict' is not set,
+            use a tolerance to find elements near the search location for the points
+            that are not found otherwise (this tests all the elements of the mesh, and
+            can thus be slow if many points lie outside the mesh).
+
+            Return `elementTags', `localCoord'.
+            """
+            api_coord_, api_coord_n_ = _ivectordouble(coord)
+            api_elementTags_, api_elementTags_n_ = POINTER(c_size_t)(), c_size_t()
+            api_localCoord_, api_localCoord_n_ = POINTER(c_double)(), c_size_t()
+            ierr = c_int()
+            lib.gmshModelMeshGetElementByCoordinatesBatch(
+                api_coord_, api_coord_n_,
+                byref(api_elementTags_), byref(api_elementTags_n_),
+                byref(api_localCoord_), byref(api_localCoord_n_),
+                c_int(dim),
+                c_int(bool(strict)),
+                byref(ierr))
+            if ierr.value != 0:
+                raise Exception(logger.getLastError())
+            return (
+                _ovectorsize(api_elementTags_, api_elementTags_n_.value),
+                _ovectordouble(api_localCoord_, api_localCoord_n_.value))
+
         @staticmethod
         def getLocalCoordinatesInElement(elementTag, x, y, z):
             """
@@ -1967,8 +2006,8 @@ class model:
             Return the local coordinates (`u', `v', `w') within the element
             `elementTag' corresponding to the model coordinates (`x', `y', `z'). This
             function relies on an internal cache (a vector in case of dense element
-            numbering, a map otherwise); for large meshes accessing elements in bulk is
-            often preferable.
+            numbering, a hash table otherwise); for large meshes accessing elements in
+            bulk is often preferable.
 
             Return `u', `v', `w'.
             """
@@ -2251,7 +2290,7 @@ class model:
             etc. `determinants' contains the determinant of the Jacobian matrix at each
             evaluation point. `coord' contains the x, y, z coordinates of the
             evaluation points. This function relies on an internal cache (a vector in
-            case of dense element numbering, a map otherwise); for large meshes
+            case of dense element numbering, a hash table otherwise); for large meshes
             accessing Jacobians in bulk is often preferable.
 
             Return `jacobians', `determinants', `coord'.
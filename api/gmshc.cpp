@@ -916,23 +916,6 @@ GMSH_API void gmshModelMeshClear(int * dimTags, size_t dimTags_n, int * ierr)
   }
 }
 
-GMSH_API void gmshModelMeshGetNodes(size_t ** nodeTags, size_t * nodeTags_n, double ** coord, size_t * coord_n, double ** parametricCoord, size_t * parametricCoord_n, const int dim, const int tag, const int includeBoundary, const int returnParametricCoord, int * ierr)
-{
-  if(ierr) *ierr = 0;
-  try {
-    std::vector<std::size_t> api_nodeTags_;
-    std::vector<double> api_coord_;
-    std::vector<double> api_parametricCoord_;
-    gmsh::model::mesh::getNodes(api_nodeTags_, api_coord_, api_parametricCoord_, dim, tag, includeBoundary, returnParametricCoord);
-    vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
-    vector2ptr(api_coord_, coord, coord_n);
-    vector2ptr(api_parametricCoord_, parametricCoord, parametricCoord_n);
-  }
-  catch(...){
-    if(ierr) *ierr = 1;
-  }
-}
-
 GMSH_API void gmshModelMeshGetNodesByElementType(const int elementType, size_t ** nodeTags, size_t * nodeTags_n, double ** coord, size_t * coord_n, double ** parametricCoord, size_t * parametricCoord_n, const int tag, const int returnParametricCoord, int * ierr)
 {
   if(ierr) *ierr = 0;
@@ -1051,29 +1034,25 @@ GMSH_API void gmshModelMeshRelocateNodes(const int dim, const int tag, int * ier
   }
 }
 
-GMSH_API void gmshModelMeshGetElements(int ** elementTypes, size_t * elementTypes_n, size_t *** elementTags, size_t ** elementTags_n, size_t *elementTags_nn, size_t *** nodeTags, size_t ** nodeTags_n, size_t *nodeTags_nn, const int dim, const int tag, int * ierr)
+GMSH_API void gmshModelMeshGetElement(const size_t elementTag, int * elementType, size_t ** nodeTags, size_t * nodeTags_n, int * ierr)
 {
   if(ierr) *ierr = 0;
   try {
-    std::vector<int> api_elementTypes_;
-    std::vector<std::vector<std::size_t> > api_elementTags_;
-    std::vector<std::vector<std::size_t> > api_nodeTags_;
-    gmsh::model::mesh::getElements(api_elementTypes_, api_elementTags_, api_nodeTags_, dim, tag);
-    vector2ptr(api_elementTypes_, elementTypes, elementTypes_n);
-    vectorvector2ptrptr(api_elementTags_, elementTags, elementTags_n, elementTags_nn);
-    vectorvector2ptrptr(api_nodeTags_, nodeTags, nodeTags_n, nodeTags_nn);
+    std::vector<std::size_t> api_nodeTags_;
+    gmsh::model::mesh::getElement(elementTag, *elementType, api_nodeTags_);
+    vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
   }
   catch(...){
     if(ierr) *ierr = 1;
   }
 }
 
-GMSH_API void gmshModelMeshGetElement(const size_t elementTag, int * elementType, size_t ** nodeTags, size_t * nodeTags_n, int * ierr)
+GMSH_API void gmshModelMeshGetElementByCoordinates(const double x, const double y, const double z, size_t * elementTag, int * elementType, size_t ** nodeTags, size_t * nodeTags_n, double * u, double * v, double * w, const int dim, const int strict, int * ierr)
 {
   if(ierr) *ierr = 0;
   try {
     std::vector<std::size_t> api_nodeTags_;
-    gmsh::model::mesh::getElement(elementTag, *elementType, api_nodeTags_);
+    gmsh::model::mesh::getElementByCoordinates(x, y, z, *elementTag, *elementType, api_nodeTags_, *u, *v, *w, dim, strict);
     vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
   }
   catch(...){
@@ -1081,26 +1060,29 @@ GMSH_API void gmshModelMeshGetElement(const size_t elementTag, int * elementType
   }
 }
 
-GMSH_API void gmshModelMeshGetElementByCoordinates(const double x, const double y, const double z, size_t * elementTag, int * elementType, size_t ** nodeTags, size_t * nodeTags_n, double * u, double * v, double * w, const int dim, const int strict, int * ierr)
+GMSH_API void gmshModelMeshGetElementsByCoordinates(const double x, const double y, const double z, size_t ** elementTags, size_t * elementTags_n, const int dim, const int strict, int * ierr)
 {
   if(ierr) *ierr = 0;
   try {
-    std::vector<std::size_t> api_nodeTags_;
-    gmsh::model::mesh::getElementByCoordinates(x, y, z, *elementTag, *elementType, api_nodeTags_, *u, *v, *w, dim, strict);
-    vector2ptr(api_nodeTags_, nodeTags, nodeTags_n);
+    std::vector<std::size_t> api_elementTags_;
+    gmsh::model::mesh::getElementsByCoordinates(x, y, z, api_elementTags_, dim, strict);
+    vector2ptr(api_elementTags_, elementTags, elementTags_n);
   }
   catch(...){
     if(ierr) *ierr = 1;
   }
 }
 
-GMSH_API void gmshModelMeshGetElementsByCoordinates(const double x, const double y, const double z, size_t ** elementTags, size_t * elementTags_n, const int dim, const int strict, int * ierr)
+GMSH_API void gmshModelMeshGetElementByCoordinatesBatch(double * coord, size_t coord_n, size_t ** elementTags, size_t * elementTags_n, double ** localCoord, size_t * localCoord_n, const int dim, const int strict, int * ierr)
 {
   if(ierr) *ierr = 0;
   try {
+    std::vector<double> api_coord_(coord, coord + coord_n);
     std::vector<std::size_t> api_elementTags_;
-    gmsh::model::mesh::getElementsByCoordinates(x, y, z, api_elementTags_, dim, strict);
+    std::vector<double> api_localCoord_;
+    gmsh::model::mesh::getElementByCoordinatesBatch(api_coord_, api_elementTags_, api_localCoord_, dim, strict);
     vector2ptr(api_elementTags_, elementTags, elementTags_n);
+    vector2ptr(api_localCoord_, localCoord, localCoord_n);
   }
   catch(...){
     if(ierr) *ierr = 1;
@@ -572,8 +572,8 @@ GMSH_API void gmshModelMeshGetNodesByElementType(const int elementType,
 
 /* Get the coordinates and the parametric coordinates (if any) of the node
  * with tag `tag'. This function relies on an internal cache (a vector in case
- * of dense node numbering, a map otherwise); for large meshes accessing nodes
- * in bulk is often preferable. */
+ * of dense node numbering, a hash table otherwise); for large meshes
+ * accessing nodes in bulk is often preferable. */
 GMSH_API void gmshModelMeshGetNode(const size_t nodeTag,
                                    double ** coord, size_t * coord_n,
                                    double ** parametricCoord, size_t * parametricCoord_n,
@@ -581,8 +581,8 @@ GMSH_API void gmshModelMeshGetNode(const size_t nodeTag,
 
 /* Set the coordinates and the parametric coordinates (if any) of the node
  * with tag `tag'. This function relies on an internal cache (a vector in case
- * of dense node numbering, a map otherwise); for large meshes accessing nodes
- * in bulk is often preferable. */
+ * of dense node numbering, a hash table otherwise); for large meshes
+ * accessing nodes in bulk is often preferable. */
 GMSH_API void gmshModelMeshSetNode(const size_t nodeTag,
                                    double * coord, size_t coord_n,
                                    double * parametricCoord, size_t parametricCoord_n,
@@ -658,7 +658,7 @@ GMSH_API void gmshModelMeshGetElements(int ** elementTypes, size_t * elementType
 
 /* Get the type and node tags of the element with tag `tag'. This function
  * relies on an internal cache (a vector in case of dense element numbering, a
- * map otherwise); for large meshes accessing elements in bulk is often
+ * hash table otherwise); for large meshes accessing elements in bulk is often
  * preferable. */
 GMSH_API void gmshModelMeshGetElement(const size_t elementTag,
                                       int * elementType,
@@ -666,9 +666,10 @@ GMSH_API void gmshModelMeshGetElement(const size_t elementTag,
                                       int * ierr);
 
 /* Search the mesh for an element located at coordinates (`x', `y', `z'). This
- * function performs a search in a spatial octree. If an element is found,
- * return its tag, type and node tags, as well as the local coordinates (`u',
- * `v', `w') within the reference element corresponding to search location. If
+ * function performs a search in a spatial index (a bounding volume hierarchy
+ * over the bounding boxes of the elements). If an element is found, return
+ * its tag, type and node tags, as well as the local coordinates (`u', `v',
+ * `w') within the reference element corresponding to search location. If
  * `dim' is >= 0, only search for elements of the given dimension. If `strict'
  * is not set, use a tolerance to find elements near the search location. */
 GMSH_API void gmshModelMeshGetElementByCoordinates(const double x,
@@ -685,11 +686,12 @@ GMSH_API void gmshModelMeshGetElementByCoordinates(const double x,
                                                    int * ierr);
 
 /* Search the mesh for element(s) located at coordinates (`x', `y', `z'). This
- * function performs a search in a spatial octree. Return the tags of all
- * found elements in `elementTags'. Additional information about the elements
- * can be accessed through `getElement' and `getLocalCoordinatesInElement'. If
- * `dim' is >= 0, only search for elements of the given dimension. If `strict'
- * is not set, use a tolerance to find elements near the search location. */
+ * function performs a search in a spatial index (a bounding volume hierarchy
+ * over the bounding boxes of the elements). Return the tags of all found
+ * elements in `elementTags'. Additional information about the elements can be
+ * accessed through `getElement' and `getLocalCoordinatesInElement'. If `dim'
+ * is >= 0, only search for elements of the given dimension. If `strict' is
+ * not set, use a tolerance to find elements near the search location. */
 GMSH_API void gmshModelMeshGetElementsByCoordinates(const double x,
                                                     const double y,
                                                     const double z,
@@ -698,11 +700,30 @@ GMSH_API void gmshModelMeshGetElementsByCoordinates(const double x,
                                                     const int strict,
                                                     int * ierr);
 
+/* Search the mesh for the elements located at the coordinates `coord' of a
+ * set of points, concatenated: [p1x, p1y, p1z, p2x, ...]. For each point,
+ * return the tag of one element containing it in `elementTags' (0 if no
+ * element is found) and the local coordinates of the point within that
+ * element in `localCoord', concatenated: [p1u, p1v, p1w, p2u, ...]. This
+ * function uses the same spatial index as `getElementByCoordinates', which is
+ * kept across calls until the mesh is modified, and processes the points in
+ * parallel; it should be preferred for locating many points. If `dim' is >=
+ * 0, only search for elements of the given dimension. If `strict' is not set,
+ * use a tolerance to find elements near the search location for the points
+ * that are not found otherwise (this tests all the elements of the mesh, and
+ * can thus be slow if many points lie outside the mesh). */
+GMSH_API void gmshModelMeshGetElementByCoordinatesBatch(double * coord, size_t coord_n,
+                                                        size_t ** elementTags, size_t * elementTags_n,
+                                                        double ** localCoord, size_t * localCoord_n,
+                                                        const int dim,
+                                                        const int strict,
+                                                        int * ierr);
+
 /* Return the local coordinates (`u', `v', `w') within the element
  * `elementTag' corresponding to the model coordinates (`x', `y', `z'). This
  * function relies on an internal cache (a vector in case of dense element
- * numbering, a map otherwise); for large meshes accessing elements in bulk is
- * often preferable. */
+ * numbering, a hash table otherwise); for large meshes accessing elements in
+ * bulk is often preferable. */
 GMSH_API void gmshModelMeshGetLocalCoordinatesInElement(const size_t elementTag,
                                                         const double x,
                                                         const double y,
@@ -858,7 +879,7 @@ GMSH_API void gmshModelMeshPreallocateJacobians(const int elementType,
  * etc. `determinants' contains the determinant of the Jacobian matrix at each
  * evaluation point. `coord' contains the x, y, z coordinates of the
  * evaluation points. This function relies on an internal cache (a vector in
- * case of dense element numbering, a map otherwise); for large meshes
+ * case of dense element numbering, a hash table otherwise); for large meshes
  * accessing Jacobians in bulk is often preferable. */
 GMSH_API void gmshModelMeshGetJacobian(const size_t elementTag,
                                        double * localCoord, size_t localCoord_n,
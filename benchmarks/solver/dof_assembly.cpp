@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <gmsh/GmshGlobal.h>
+#include <gmsh/GModel.h>
+#include <gmsh/OpenFile.h>
+#include <gmsh/linearSystemCSR.h>
+#include <gmsh/simpleFunction.h>
+#include <gmsh/elasticitySolver.h>
+#include <gmsh/thermicSolver.h>
+
+// Measures the time needed to assemble the stiffness matrices of an elasticity
+// and of a thermal problem on a tetrahedral mesh of a unit cube, through the
+// dofManager numbering of the unknowns: elasticitySolver::assemble() and
+// thermicSolver::assemble() report the time per element. This uses the private
+// Gmsh API: configure Gmsh with "-DENABLE_PRIVATE_API=1 -DENABLE_BUILD_LIB=1",
+// install it, then e.g.
+//
+//   g++ -O2 dof_assembly.cpp -lgmsh -o dof_assembly
+//   ./dof_assembly dof_assembly.geo 0.025
+
+int main(int argc, char *argv[])
+{
+  if(argc < 2) {
+    Msg::Error("Usage: %s dof_assembly.geo [lc]", argv[0]);
+    return 1;
+  }
+  new GModel();
+  GmshInitialize();
+  if(argc > 2) GmshSetOption("Mesh", "CharacteristicLengthMax", atof(argv[2]));
+  OpenProject(argv[1]);
+  GModel::current()->mesh(3);
+  GModel::current()->writeMSH("dof_assembly.msh");
+
+  // clamped at z = 0 (physical surface 2)
+  elasticitySolver elasticity(1000);
+  elasticity.setMesh("dof_assembly.msh");
+  elasticity.addElasticDomain(1, 200e9, 0.3);
+  for(int comp = 0; comp < 3; comp++) elasticity.addDirichletBC(2, 2, comp, 0.);
+  linearSystemCSRGmm<double> lsys1;
+  elasticity.assemble(&lsys1);
+
+  // fixed temperature at z = 0
+  thermicSolver thermic(1000);
+  thermic.setMesh("dof_assembly.msh");
+  thermic.setThermicDomain(1, 1.);
+  simpleFunction<double> zero(0.);
+  thermic.setFaceTemp(2, &zero);
+  linearSystemCSRGmm<double> lsys2;
+  thermic.assemble(&lsys2);
+
+  GmshFinalize();
+  return 0;
+}
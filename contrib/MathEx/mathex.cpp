@@ -692,6 +692,109 @@
          return evalstack[0];
       } // eval()
 
+   ////////////////////////////////////////////
+   // ADDED FOR GMSH: reentrant evaluation
+   //------------------------------------------
+
+       unsigned mathex::stacksize() const
+      // maximum number of values on the stack during the evaluation
+      {
+         int size = 0, maxsize = 0;
+         for(unsigned i=0; i<bytecode.size(); i++) {
+            switch(bytecode[i].state) {
+               case CODETOKEN::VALUE:
+               case CODETOKEN::VARIABLE: size++;
+                  break;
+               case CODETOKEN::BINOP: size--;
+                  break;
+               case CODETOKEN::USERFUNC:
+                  if(bytecode[i].numargs > 0)
+                     size -= bytecode[i].numargs - 1;
+                  else
+                     size++;
+                  break;
+               default:
+                  break;
+            }
+            if(size > maxsize) maxsize = size;
+         }
+         return maxsize;
+      } // stacksize()
+
+       void mathex::eval(double const *vars, unsigned long n, double *res,
+                         double *stack) const
+      // Eval the parsed expression at n points, without modifying the object
+      {
+         vector <double> x; // arguments of user defined functions
+         unsigned top = 0; // number of values on the stack
+
+         if(status != parsed) throw error("eval()", "expression not parsed");
+
+         for(unsigned i=0; i<bytecode.size(); i++)
+         {
+            const CODETOKEN &tok = bytecode[i];
+            double *s = stack + top * n;
+            switch(tok.state) {
+               case CODETOKEN::VALUE:
+                  for(unsigned long k=0; k<n; k++) s[k] = tok.value;
+                  top++;
+                  break;
+               case CODETOKEN::VARIABLE:
+                  for(unsigned long k=0; k<n; k++) s[k] = vars[tok.idx * n + k];
+                  top++;
+                  break;
+               case CODETOKEN::FUNCTION: {
+                  double (*f)(double) = cfunctable[tok.idx].f;
+                  s -= n;
+                  for(unsigned long k=0; k<n; k++) s[k] = f(s[k]);
+                  break;
+               }
+               case CODETOKEN::BINOP: {
+                  double *a = s - 2 * n, *b = s - n;
+                  // inline the most common operators
+                  switch(binoptable[tok.idx].name) {
+                     case '+':
+                        for(unsigned long k=0; k<n; k++) a[k] += b[k];
+                        break;
+                     case '-':
+                        for(unsigned long k=0; k<n; k++) a[k] -= b[k];
+                        break;
+                     case '*':
+                        for(unsigned long k=0; k<n; k++) a[k] *= b[k];
+                        break;
+                     default: {
+                        double (*f)(double, double) = binoptable[tok.idx].f;
+                        for(unsigned long k=0; k<n; k++) a[k] = f(a[k], b[k]);
+                     }
+                  }
+                  top--;
+                  break;
+               }
+               case CODETOKEN::USERFUNC:
+                  if(tok.numargs > 0) {
+                     unsigned m = tok.numargs;
+                     double *a = s - m * n;
+                     x.resize(m);
+                     for(unsigned long k=0; k<n; k++) {
+                        for(unsigned j=0; j<m; j++) x[j] = a[j * n + k];
+                        a[k] = functable[tok.idx].f(x);
+                     }
+                     top -= m - 1;
+                  }
+                  else {
+                     x.clear();
+                     for(unsigned long k=0; k<n; k++)
+                        s[k] = functable[tok.idx].f(x);
+                     top++;
+                  }
+                  break;
+               default: // invarid stack. It does not occur if currect parsed
+                  throw  error("eval()", "invalid code token");
+            }
+         }
+         for(unsigned long k=0; k<n; k++) res[k] = stack[k];
+      } // eval()
+
    /////////////////
    // parser
    //---------------
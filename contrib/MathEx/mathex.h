@@ -255,6 +255,13 @@ using namespace std;
          return pos; }
       void parse(); /// < parse expression 
       double eval(); /// < eval expression
+      // ADDED FOR GMSH: reentrant evaluation of the parsed expression at n
+      // points. vars[j * n + k] is the value of variable j (in the order in
+      // which the variables were added) at point k, the results are stored
+      // in res, and stack is a work array of stacksize() * n values
+      void eval(double const *vars, unsigned long n, double *res,
+                double *stack) const; /// < eval parsed expression at n points
+      unsigned stacksize() const; /// < stack size needed by eval(vars, ...)
       void reset(); /// < reset all
        mathex() /// < default constructor
       {reset();}
@@ -0,0 +1,95 @@
+#include <gmshc.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// Time the extraction of all the nodes and elements of a large mesh through
+// the C API
+
+size_t get_node_tag(size_t N, size_t i, size_t j)
+{
+  return (N + 1) * i + j + 1;
+}
+
+void create_mesh(size_t N, double *coords, size_t *nodes, size_t *tris)
+{
+  size_t k = 0, l = 0;
+  for(size_t i = 0; i < N + 1; i++) {
+    for(size_t j = 0; j < N + 1; j++) {
+      nodes[k] = get_node_tag(N, i, j);
+      coords[3 * k] = (double)i / N;
+      coords[3 * k + 1] = (double)j / N;
+      coords[3 * k + 2] = 0.05 * sin(10 * (double)(i + j) / N);
+      k++;
+      if(i > 0 && j > 0) {
+        tris[6 * l] = get_node_tag(N, i - 1, j - 1);
+        tris[6 * l + 1] = get_node_tag(N, i, j - 1);
+        tris[6 * l + 2] = get_node_tag(N, i - 1, j);
+        tris[6 * l + 3] = get_node_tag(N, i, j - 1);
+        tris[6 * l + 4] = get_node_tag(N, i, j);
+        tris[6 * l + 5] = get_node_tag(N, i - 1, j);
+        l++;
+      }
+    }
+  }
+}
+
+int main()
+{
+  int ierr = 0;
+  gmshInitialize(0, NULL, 0, &ierr);
+
+  size_t N = 2500;
+
+  double *coords = malloc((N + 1) * (N + 1) * 3 * sizeof(double));
+  size_t *nodes = malloc((N + 1) * (N + 1) * sizeof(size_t));
+  size_t *tris = malloc(N * N * 2 * 3 * sizeof(size_t));
+  create_mesh(N, coords, nodes, tris);
+  gmshModelAddDiscreteEntity(2, 1, NULL, 0, &ierr);
+  gmshModelMeshAddNodes(2, 1, nodes, (N + 1) * (N + 1), coords,
+                        (N + 1) * (N + 1) * 3, NULL, 0, &ierr);
+  gmshModelMeshAddElementsByType(1, 2, NULL, 0, tris, N * N * 2 * 3, &ierr);
+  free(coords);
+  free(nodes);
+  free(tris);
+
+  double tic = gmshLoggerGetWallTime(&ierr);
+  size_t *nodeTags, nodeTags_n, coord_n, parametricCoord_n;
+  double *coord, *parametricCoord;
+  gmshModelMeshGetNodes(&nodeTags, &nodeTags_n, &coord, &coord_n,
+                        &parametricCoord, &parametricCoord_n, -1, -1, 0, 0,
+                        &ierr);
+  double toc = gmshLoggerGetWallTime(&ierr);
+  printf("==> got %lu nodes in %g seconds\n", (unsigned long)nodeTags_n,
+         toc - tic);
+
+  tic = gmshLoggerGetWallTime(&ierr);
+  int *elementTypes;
+  size_t elementTypes_n, **elementTags, *elementTags_n, elementTags_nn;
+  size_t **nodeTagsByType, *nodeTagsByType_n, nodeTagsByType_nn;
+  gmshModelMeshGetElements(&elementTypes, &elementTypes_n, &elementTags,
+                           &elementTags_n, &elementTags_nn, &nodeTagsByType,
+                           &nodeTagsByType_n, &nodeTagsByType_nn, -1, -1,
+                           &ierr);
+  toc = gmshLoggerGetWallTime(&ierr);
+  size_t numElements = 0;
+  for(size_t i = 0; i < elementTypes_n; i++) numElements += elementTags_n[i];
+  printf("==> got %lu elements in %g seconds\n", (unsigned long)numElements,
+         toc - tic);
+
+  gmshFree(nodeTags);
+  gmshFree(coord);
+  gmshFree(parametricCoord);
+  for(size_t i = 0; i < elementTypes_n; i++) {
+    gmshFree(elementTags[i]);
+    gmshFree(nodeTagsByType[i]);
+  }
+  gmshFree(elementTypes);
+  gmshFree(elementTags);
+  gmshFree(elementTags_n);
+  gmshFree(nodeTagsByType);
+  gmshFree(nodeTagsByType_n);
+
+  gmshFinalize(&ierr);
+  return 0;
+}
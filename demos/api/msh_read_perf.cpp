@@ -0,0 +1,49 @@
+#include <gmsh.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Measures the time needed to read and write a large binary MSH 4.1 file, with
+// one thread and with the given number of threads (nodes and elements of each
+// entity block are created and formatted in parallel), e.g.
+//
+//   ./msh_read_perf 8
+
+int main(int argc, char **argv)
+{
+  int numThreads = (argc > 1) ? atoi(argv[1]) : 4;
+
+  gmsh::initialize();
+  gmsh::option::setNumber("General.Terminal", 1);
+
+  // create a large structured tetrahedral mesh by extrusion (you can make it
+  // larger by increasing N)
+  int N = 100;
+  gmsh::model::add("cube");
+  gmsh::model::geo::addPoint(0, 0, 0, 1, 1);
+  gmsh::vectorpair out;
+  gmsh::model::geo::extrude({{0, 1}}, 1, 0, 0, out, {N});
+  gmsh::model::geo::extrude({out[1]}, 0, 1, 0, out, {N});
+  gmsh::model::geo::extrude({out[1]}, 0, 0, 1, out, {N});
+  gmsh::model::geo::synchronize();
+  gmsh::model::mesh::generate(3);
+  gmsh::option::setNumber("Mesh.Binary", 1);
+  gmsh::write("msh_read_perf.msh");
+
+  for(int nt = 1; nt <= numThreads; nt *= 2) {
+    gmsh::clear();
+    gmsh::option::setNumber("General.NumThreads", nt);
+    double tic = gmsh::logger::getWallTime();
+    gmsh::open("msh_read_perf.msh");
+    double toc = gmsh::logger::getWallTime();
+    printf("==> read from disk with %d thread(s) in %g seconds\n", nt,
+           toc - tic);
+    tic = gmsh::logger::getWallTime();
+    gmsh::write("msh_read_perf_out.msh");
+    toc = gmsh::logger::getWallTime();
+    printf("==> written to disk with %d thread(s) in %g seconds\n", nt,
+           toc - tic);
+  }
+
+  gmsh::finalize();
+  return 0;
+}
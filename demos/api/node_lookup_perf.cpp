@@ -0,0 +1,74 @@
+#include <gmsh.h>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+// Measures the time needed to access nodes and elements one at a time by tag,
+// in random order, when their numbering is sparse (in which case the internal
+// cache is a hash table instead of a vector), e.g.
+//
+//   ./node_lookup_perf 1000000
+
+int main(int argc, char **argv)
+{
+  std::size_t N = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+  gmsh::initialize();
+  gmsh::option::setNumber("General.Terminal", 1);
+
+  gmsh::model::add("sparse");
+  gmsh::model::addDiscreteEntity(1, 1);
+
+  // N nodes and N - 1 line elements, with tags spaced by 1000
+  std::vector<std::size_t> nodeTags(N), elementTags(N - 1), lines;
+  std::vector<double> coord(3 * N);
+  for(std::size_t i = 0; i < N; i++) {
+    nodeTags[i] = 1000 * i + 1;
+    coord[3 * i] = (double)i / N;
+    coord[3 * i + 1] = 0.;
+    coord[3 * i + 2] = 0.;
+  }
+  for(std::size_t i = 0; i < N - 1; i++) {
+    elementTags[i] = 1000 * i + 1;
+    lines.push_back(nodeTags[i]);
+    lines.push_back(nodeTags[i + 1]);
+  }
+  gmsh::model::mesh::addNodes(1, 1, nodeTags, coord);
+  gmsh::model::mesh::addElementsByType(1, 1, elementTags, lines);
+
+  std::random_shuffle(nodeTags.begin(), nodeTags.end());
+  std::random_shuffle(elementTags.begin(), elementTags.end());
+
+  double tic = gmsh::logger::getWallTime();
+  gmsh::model::mesh::rebuildNodeCache(false);
+  gmsh::model::mesh::rebuildElementCache(false);
+  double toc = gmsh::logger::getWallTime();
+  printf("==> rebuilt caches in %g seconds\n", toc - tic);
+
+  tic = gmsh::logger::getWallTime();
+  std::vector<double> xyz, uvw;
+  double sum = 0.;
+  for(std::size_t i = 0; i < N; i++) {
+    gmsh::model::mesh::getNode(nodeTags[i], xyz, uvw);
+    sum += xyz[0];
+  }
+  toc = gmsh::logger::getWallTime();
+  printf("==> %lu random node lookups in %g seconds (sum = %g)\n", N,
+         toc - tic, sum);
+
+  tic = gmsh::logger::getWallTime();
+  int elementType;
+  std::vector<std::size_t> elementNodeTags;
+  std::size_t check = 0;
+  for(std::size_t i = 0; i < N - 1; i++) {
+    gmsh::model::mesh::getElement(elementTags[i], elementType,
+                                  elementNodeTags);
+    check += elementNodeTags[0];
+  }
+  toc = gmsh::logger::getWallTime();
+  printf("==> %lu random element lookups in %g seconds (check = %lu)\n",
+         N - 1, toc - tic, check);
+
+  gmsh::finalize();
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include <gmsh.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Measures the time needed to locate random points in a large tetrahedral mesh,
+// one point at a time with getElementByCoordinates and all at once with
+// getElementByCoordinatesBatch, e.g. for about 10M tetrahedra and 10M queries:
+//
+//   ./point_location_perf 120 10000000 8
+
+int main(int argc, char **argv)
+{
+  int N = (argc > 1) ? atoi(argv[1]) : 50;
+  std::size_t numPoints = (argc > 2) ? atol(argv[2]) : 1000000;
+  int numThreads = (argc > 3) ? atoi(argv[3]) : 4;
+
+  gmsh::initialize();
+  gmsh::option::setNumber("General.Terminal", 1);
+  gmsh::option::setNumber("General.NumThreads", numThreads);
+
+  // create a structured tetrahedral mesh with 6 * N^3 elements by extrusion
+  gmsh::model::add("cube");
+  gmsh::model::geo::addPoint(0, 0, 0, 1, 1);
+  gmsh::vectorpair out;
+  gmsh::model::geo::extrude({{0, 1}}, 1, 0, 0, out, {N});
+  gmsh::model::geo::extrude({out[1]}, 0, 1, 0, out, {N});
+  gmsh::model::geo::extrude({out[1]}, 0, 0, 1, out, {N});
+  gmsh::model::geo::synchronize();
+  gmsh::model::mesh::generate(3);
+
+  std::vector<double> xyz(3 * numPoints);
+  for(std::size_t i = 0; i < 3 * numPoints; i++)
+    xyz[i] = (double)rand() / RAND_MAX;
+
+  // the first call builds the spatial index
+  double tic = gmsh::logger::getWallTime();
+  std::size_t elementTag;
+  int elementType;
+  std::vector<std::size_t> nodeTags;
+  double u, v, w;
+  gmsh::model::mesh::getElementByCoordinates(0.5, 0.5, 0.5, elementTag,
+                                             elementType, nodeTags, u, v, w, 3);
+  double toc = gmsh::logger::getWallTime();
+  printf("==> built spatial index in %g seconds\n", toc - tic);
+
+  tic = gmsh::logger::getWallTime();
+  std::size_t found = 0;
+  for(std::size_t i = 0; i < numPoints; i++) {
+    gmsh::model::mesh::getElementByCoordinates(
+      xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], elementTag, elementType,
+      nodeTags, u, v, w, 3, true);
+    if(elementTag) found++;
+  }
+  toc = gmsh::logger::getWallTime();
+  printf("==> located %lu points (%lu found) in %g seconds\n", numPoints,
+         found, toc - tic);
+
+  // the batched call reuses the same index and processes the points in
+  // parallel
+  tic = gmsh::logger::getWallTime();
+  std::vector<std::size_t> elementTags;
+  std::vector<double> localCoord;
+  gmsh::model::mesh::getElementByCoordinatesBatch(xyz, elementTags, localCoord,
+                                                  3, true);
+  toc = gmsh::logger::getWallTime();
+  std::size_t foundBatch = 0;
+  for(std::size_t i = 0; i < elementTags.size(); i++)
+    if(elementTags[i]) foundBatch++;
+  printf("==> located %lu points (%lu found) in %g seconds in batch "
+         "(%g points per second)\n",
+         numPoints, foundBatch, toc - tic, numPoints / (toc - tic));
+
+  gmsh::finalize();
+  return 0;
+}
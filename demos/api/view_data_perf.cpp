@@ -0,0 +1,62 @@
+#include <gmsh.h>
+#include <cstdio>
+
+// Measures the time needed to store and to iterate over model-based
+// post-processing data with many time steps; run with "-cpu" to also display
+// the memory usage, e.g.
+//
+//   ./view_data_perf -cpu
+
+int main(int argc, char **argv)
+{
+  gmsh::initialize(argc, argv);
+  gmsh::option::setNumber("General.Terminal", 1);
+
+  // create a structured mesh with about 1M nodes
+  int N = 1000;
+  gmsh::model::add("square");
+  gmsh::model::geo::addPoint(0, 0, 0, 1, 1);
+  gmsh::vectorpair out;
+  gmsh::model::geo::extrude({{0, 1}}, 1, 0, 0, out, {N});
+  gmsh::model::geo::extrude({out[1]}, 0, 1, 0, out, {N});
+  gmsh::model::geo::synchronize();
+  gmsh::model::mesh::generate(2);
+
+  std::vector<std::size_t> nodeTags;
+  std::vector<double> coord, parametricCoord;
+  gmsh::model::mesh::getNodes(nodeTags, coord, parametricCoord);
+
+  // add 50 time steps of scalar node data
+  int numSteps = 50;
+  int t = gmsh::view::add("data");
+  std::vector<double> data(nodeTags.size());
+  double tic = gmsh::logger::getWallTime();
+  for(int step = 0; step < numSteps; step++) {
+    for(std::size_t i = 0; i < nodeTags.size(); i++)
+      data[i] = coord[3 * i] * step;
+    gmsh::view::addHomogeneousModelData(t, step, "square", "NodeData",
+                                        nodeTags, data, step, 1);
+  }
+  double toc = gmsh::logger::getWallTime();
+  printf("==> added %d steps of data on %lu nodes in %g seconds\n", numSteps,
+         nodeTags.size(), toc - tic);
+  gmsh::logger::write("Data added", "info");
+
+  // iterate over all the values
+  tic = gmsh::logger::getWallTime();
+  std::string dataType;
+  std::vector<std::size_t> tags;
+  double time, sum = 0.;
+  int numComp;
+  for(int step = 0; step < numSteps; step++) {
+    gmsh::view::getHomogeneousModelData(t, step, dataType, tags, data, time,
+                                        numComp);
+    for(std::size_t i = 0; i < data.size(); i++) sum += data[i];
+  }
+  toc = gmsh::logger::getWallTime();
+  printf("==> iterated over all steps in %g seconds (sum = %g)\n", toc - tic,
+         sum);
+
+  gmsh::finalize();
+  return 0;
+}